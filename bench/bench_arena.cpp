@@ -0,0 +1,69 @@
+// 模拟一次请求：若干 vector/list/string 临时对象，请求结束整体释放。对比 std::allocator 与 arena
+#include "arena_lt.h"
+#include "bench_util.h"
+#include "list_lt.h"
+#include "string_lt.h"
+#include "vector.h"
+
+using namespace leistd::bench;
+
+template <typename T>
+using arena_vector = leistd::vector<T, leistd::arena_allocator<T>>;
+template <typename T>
+using arena_list = leistd::list<T, leistd::arena_allocator<T>>;
+using arena_string = leistd::basic_string<char, leistd::char_traits<char>, leistd::arena_allocator<char>>;
+
+// 一次请求的工作量：解析出一批 id、维护一个待处理链表、拼出响应体
+template <typename Vec, typename List, typename Str, typename... A>
+std::size_t handle_request(int items, A&... alloc) {
+  Vec ids(alloc...);
+  List pending(alloc...);
+  Str body(alloc...);
+  for (int i = 0; i < items; ++i) {
+    ids.push_back(i * 7);
+    if (i % 3 == 0) pending.push_back(i);
+    Str field("\"field\":", alloc...);
+    field.append(8, static_cast<char>('0' + i % 10));
+    body += field;
+    body += ",";
+  }
+  return ids.size() + pending.size() + body.size();
+}
+
+int main() {
+  constexpr int requests = 2000;
+  for (int items : {16, 256, 4096}) {
+    std::printf("== %d requests x %d items ==\n", requests, items);
+    double base = time_ns([&] {
+      std::size_t total = 0;
+      for (int r = 0; r < requests; ++r)
+        total += handle_request<leistd::vector<int>, leistd::list<int>, leistd::string>(items);
+      do_not_optimize(total);
+    });
+    report("std::allocator", base);
+
+    report("monotonic_arena, release per request", time_ns([&] {
+             std::size_t total = 0;
+             leistd::monotonic_arena arena;
+             for (int r = 0; r < requests; ++r) {
+               leistd::arena_allocator<int> alloc(arena);
+               total += handle_request<arena_vector<int>, arena_list<int>, arena_string>(items, alloc);
+               arena.release();
+             }
+             do_not_optimize(total);
+           }),
+           base);
+
+    report("inline_arena<64K> on the stack", time_ns([&] {
+             std::size_t total = 0;
+             for (int r = 0; r < requests; ++r) {
+               leistd::inline_arena<65536> arena;
+               leistd::arena_allocator<int> alloc(arena);
+               total += handle_request<arena_vector<int>, arena_list<int>, arena_string>(items, alloc);
+             }
+             do_not_optimize(total);
+           }),
+           base);
+  }
+  return 0;
+}
@@ -0,0 +1,110 @@
+// leistd::array 的 fill / swap / == / < 与逐元素循环（改动前的实现）对比，以及 add / scale / dot 与普通循环对比。
+// == 在两个相等的数组上测（要比完全部元素），< 在只有最后一个元素不同的数组上测
+#include <cstdint>
+#include <cstdio>
+#include <utility>
+
+#include "array_lt.h"
+#include "bench_util.h"
+
+using namespace leistd::bench;
+
+constexpr int reps = 1 << 16;
+
+template <typename T, std::size_t N>
+struct scalar {
+  static void fill(leistd::array<T, N>& a, const T& v) {
+    for (std::size_t i = 0; i < N; ++i) a[i] = v;
+  }
+  static void swap(leistd::array<T, N>& a, leistd::array<T, N>& b) {
+    for (std::size_t i = 0; i < N; ++i) std::swap(a[i], b[i]);
+  }
+  static bool equal(const leistd::array<T, N>& a, const leistd::array<T, N>& b) {
+    for (std::size_t i = 0; i < N; ++i) {
+      if (!(a[i] == b[i])) return false;
+    }
+    return true;
+  }
+  static bool less(const leistd::array<T, N>& a, const leistd::array<T, N>& b) {
+    for (std::size_t i = 0; i < N; ++i) {
+      if (a[i] < b[i]) return true;
+      if (b[i] < a[i]) return false;
+    }
+    return false;
+  }
+  static leistd::array<T, N> add(const leistd::array<T, N>& a, const leistd::array<T, N>& b) {
+    leistd::array<T, N> r;
+    for (std::size_t i = 0; i < N; ++i) r[i] = a[i] + b[i];
+    return r;
+  }
+  static leistd::array<T, N> scale(const leistd::array<T, N>& a, T s) {
+    leistd::array<T, N> r;
+    for (std::size_t i = 0; i < N; ++i) r[i] = a[i] * s;
+    return r;
+  }
+  static T dot(const leistd::array<T, N>& a, const leistd::array<T, N>& b) {
+    T sum = T();
+    for (std::size_t i = 0; i < N; ++i) sum += a[i] * b[i];
+    return sum;
+  }
+};
+
+// 每轮都让编译器认为数组可能被改过，防止把重复的操作合并掉
+template <typename Fn>
+double run(Fn fn) {
+  return time_ns([&] {
+    for (int r = 0; r < reps; ++r) fn(r);
+  });
+}
+
+template <typename T, std::size_t N>
+void suite(const char* type) {
+  using arr = leistd::array<T, N>;
+  using ref = scalar<T, N>;
+  arr a{}, b{};
+  for (std::size_t i = 0; i < N; ++i) a[i] = b[i] = static_cast<T>(i % 7 + 1);
+
+  std::printf("-- array<%s, %zu>, %d ops --\n", type, N, reps);
+  auto pair = [](const char* name, double base, double ours) {
+    char label[64];
+    std::snprintf(label, sizeof label, "%s: loop", name);
+    report(label, base);
+    std::snprintf(label, sizeof label, "%s: leistd", name);
+    report(label, ours, base);
+  };
+
+  pair("fill",
+       run([&](int r) { ref::fill(a, static_cast<T>(r & 7)), do_not_optimize(a); }),
+       run([&](int r) { a.fill(static_cast<T>(r & 7)), do_not_optimize(a); }));
+  pair("swap",
+       run([&](int) { ref::swap(a, b), do_not_optimize(a), do_not_optimize(b); }),
+       run([&](int) { a.swap(b), do_not_optimize(a), do_not_optimize(b); }));
+
+  for (std::size_t i = 0; i < N; ++i) a[i] = b[i] = static_cast<T>(i % 7 + 1);
+  pair("== (equal)",
+       run([&](int) { do_not_optimize(a), do_not_optimize(ref::equal(a, b)); }),
+       run([&](int) { do_not_optimize(a), do_not_optimize(a == b); }));
+  b[N - 1] = static_cast<T>(9);
+  pair("< (last differs)",
+       run([&](int) { do_not_optimize(a), do_not_optimize(ref::less(a, b)); }),
+       run([&](int) { do_not_optimize(a), do_not_optimize(a < b); }));
+
+  pair("add",
+       run([&](int) { do_not_optimize(a), do_not_optimize(ref::add(a, b)); }),
+       run([&](int) { do_not_optimize(a), do_not_optimize(leistd::add(a, b)); }));
+  pair("scale",
+       run([&](int r) { do_not_optimize(ref::scale(a, static_cast<T>(r & 3))); }),
+       run([&](int r) { do_not_optimize(leistd::scale(a, static_cast<T>(r & 3))); }));
+  pair("dot",
+       run([&](int) { do_not_optimize(a), do_not_optimize(ref::dot(a, b)); }),
+       run([&](int) { do_not_optimize(a), do_not_optimize(leistd::dot(a, b)); }));
+}
+
+int main() {
+  suite<std::uint8_t, 64>("uint8");
+  suite<int, 16>("int");
+  suite<int, 256>("int");
+  suite<float, 16>("float");
+  suite<float, 256>("float");
+  suite<double, 1024>("double");
+}
@@ -0,0 +1,42 @@
+// char_traits 特化与逐字符通用实现的对比
+#include <vector>
+
+#include "bench_util.h"
+#include "char_traits_lt.h"
+
+using namespace leistd::bench;
+
+template <typename CharT>
+void run(const char* type_name) {
+  using fast = leistd::char_traits<CharT>;
+  using slow = leistd::char_traits_base<CharT>;
+  constexpr std::size_t n = 1 << 20;
+  std::vector<CharT> a(n + 1, CharT('a')), b(n + 1, CharT('a'));
+  a[n] = b[n] = CharT();
+  b[n - 1] = CharT('b');
+
+  std::printf("== %s, %zu chars ==\n", type_name, n);
+  double base = time_ns([&] { do_not_optimize(slow::length(a.data())); });
+  report("length (generic)", base);
+  report("length", time_ns([&] { do_not_optimize(fast::length(a.data())); }), base);
+
+  base = time_ns([&] { do_not_optimize(slow::compare(a.data(), b.data(), n)); });
+  report("compare (generic)", base);
+  report("compare", time_ns([&] { do_not_optimize(fast::compare(a.data(), b.data(), n)); }), base);
+
+  base = time_ns([&] { do_not_optimize(slow::find(b.data(), n, CharT('b'))); });
+  report("find (generic)", base);
+  report("find", time_ns([&] { do_not_optimize(fast::find(b.data(), n, CharT('b'))); }), base);
+
+  base = time_ns([&] { do_not_optimize(slow::assign(a.data(), n, CharT('c'))); });
+  report("assign(n) (generic)", base);
+  report("assign(n)", time_ns([&] { do_not_optimize(fast::assign(a.data(), n, CharT('c'))); }), base);
+}
+
+int main() {
+  run<char>("char");
+  run<char8_t>("char8_t");
+  run<char16_t>("char16_t");
+  run<char32_t>("char32_t");
+  return 0;
+}
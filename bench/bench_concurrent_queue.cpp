@@ -0,0 +1,150 @@
+// 生产者/消费者之间的工作队列：std::mutex + list vs 无锁队列族。
+// P 个生产者各入队 per_producer 个元素，C 个消费者取完为止；元素里带入队时刻，出队时记延迟。
+// 报告吞吐（百万次/秒）与满负载下的排队延迟（均值、p99）。
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "concurrent_queue_lt.h"
+#include "list_lt.h"
+
+static std::int64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// 基线：现有做法，一把锁保护的 leistd::list
+class locked_list_queue {
+public:
+  void push(std::int64_t v) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _list.push_back(v);
+  }
+  bool try_pop(std::int64_t& out) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_list.empty()) return false;
+    out = _list.front();
+    _list.pop_front();
+    return true;
+  }
+
+private:
+  std::mutex _mutex;
+  leistd::list<std::int64_t> _list;
+};
+
+// 有界队列满时生产者让出时间片重试
+class ring_queue {
+public:
+  void push(std::int64_t v) {
+    while (!_q.try_push(v)) std::this_thread::yield();
+  }
+  bool try_pop(std::int64_t& out) { return _q.try_pop(out); }
+
+private:
+  leistd::mpmc_ring_queue<std::int64_t> _q{4096};
+};
+
+struct result {
+  double mops;
+  double mean_ns;
+  double p99_ns;
+};
+
+template <typename Queue>
+result run(int producers, int consumers, int per_producer) {
+  Queue q;
+  const long total = static_cast<long>(producers) * per_producer;
+  std::atomic<long> popped{0};
+  std::atomic<bool> go{false};
+  std::vector<std::vector<std::int64_t>> latency(consumers);
+  std::vector<std::thread> threads;
+
+  for (int p = 0; p < producers; ++p)
+    threads.emplace_back([&] {
+      while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+      for (int i = 0; i < per_producer; ++i) q.push(now_ns());
+    });
+  for (int c = 0; c < consumers; ++c)
+    threads.emplace_back([&, c] {
+      auto& lat = latency[c];
+      lat.reserve(total / consumers + 1);
+      while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+      std::int64_t v;
+      while (popped.load(std::memory_order_relaxed) < total) {
+        if (q.try_pop(v)) {
+          lat.push_back(now_ns() - v);
+          popped.fetch_add(1, std::memory_order_relaxed);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+
+  auto t0 = std::chrono::steady_clock::now();
+  go.store(true, std::memory_order_release);
+  for (auto& t : threads) t.join();
+  double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+
+  std::vector<std::int64_t> all;
+  for (auto& l : latency) all.insert(all.end(), l.begin(), l.end());
+  double sum = 0;
+  for (auto x : all) sum += x;
+  auto p99 = all.begin() + all.size() * 99 / 100;
+  std::nth_element(all.begin(), p99, all.end());
+  return {total * 1e3 / ns, sum / all.size(), static_cast<double>(*p99)};
+}
+
+// 跑 3 次取吞吐最高的一次，减少调度抖动
+template <typename Queue>
+result best_of(int producers, int consumers, int per_producer) {
+  result best{0, 0, 0};
+  for (int rep = 0; rep < 3; ++rep) {
+    result r = run<Queue>(producers, consumers, per_producer);
+    if (r.mops > best.mops) best = r;
+  }
+  return best;
+}
+
+// 打印一行并返回吞吐；base_mops 为 0 时不打印倍数
+template <typename Queue>
+double report_run(const char* name, int producers, int consumers, int per_producer, double base_mops = 0) {
+  result r = best_of<Queue>(producers, consumers, per_producer);
+  char label[64];
+  std::snprintf(label, sizeof label, "%s %dP/%dC", name, producers, consumers);
+  std::printf("%-36s %8.2f Mops/s", label, r.mops);
+  if (base_mops > 0)
+    std::printf(" (%5.2fx)", r.mops / base_mops);
+  else
+    std::printf("         ");
+  std::printf("  latency mean %10.0f ns  p99 %10.0f ns\n", r.mean_ns, r.p99_ns);
+  return r.mops;
+}
+
+int main() {
+  const int per_producer = 200000;
+  int max_threads = static_cast<int>(std::max(4u, std::thread::hardware_concurrency()));
+  std::printf("hardware_concurrency = %u\n", std::thread::hardware_concurrency());
+
+  // 多生产者单消费者：MPSC 队列的目标场景
+  std::printf("\n== P producers, 1 consumer ==\n");
+  for (int p = 1; p <= max_threads; p *= 2) {
+    double base = report_run<locked_list_queue>("mutex + list", p, 1, per_producer);
+    report_run<leistd::mpsc_queue<std::int64_t>>("mpsc_queue", p, 1, per_producer, base);
+    report_run<ring_queue>("mpmc_ring_queue", p, 1, per_producer, base);
+    report_run<leistd::segmented_mpmc_queue<std::int64_t>>("segmented_mpmc_queue", p, 1, per_producer, base);
+  }
+
+  // 生产者与消费者等量扩展
+  std::printf("\n== N producers, N consumers ==\n");
+  for (int n = 1; n <= max_threads; n *= 2) {
+    double base = report_run<locked_list_queue>("mutex + list", n, n, per_producer);
+    report_run<ring_queue>("mpmc_ring_queue", n, n, per_producer, base);
+    report_run<leistd::segmented_mpmc_queue<std::int64_t>>("segmented_mpmc_queue", n, n, per_producer, base);
+  }
+}
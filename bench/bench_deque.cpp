@@ -0,0 +1,130 @@
+// 队列负载下 deque vs list vs vector（erase(begin()) 出队），附 std::deque 作参照
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "bench_util.h"
+#include "deque_lt.h"
+#include "list_lt.h"
+#include "vector.h"
+
+using namespace leistd::bench;
+
+// 一次性入队 n 个再全部出队
+template <typename Q>
+void fill_drain(Q& q, int n) {
+  for (int i = 0; i < n; ++i) q.push_back(i);
+  std::int64_t s = 0;
+  while (!q.empty()) {
+    s += q.front();
+    q.pop_front();
+  }
+  do_not_optimize(s);
+}
+
+// 稳态 FIFO：队列保持 depth 个元素，每轮入队一个、出队一个
+template <typename Q>
+void steady(Q& q, int depth, int rounds) {
+  for (int i = 0; i < depth; ++i) q.push_back(i);
+  std::int64_t s = 0;
+  for (int i = 0; i < rounds; ++i) {
+    q.push_back(i);
+    s += q.front();
+    q.pop_front();
+  }
+  do_not_optimize(s);
+  while (!q.empty()) q.pop_front();
+}
+
+// vector 没有 pop_front，用 erase(begin()) 模拟
+struct vector_queue {
+  leistd::vector<int> v;
+  void push_back(int x) { v.push_back(x); }
+  int front() const { return v[0]; }
+  void pop_front() { v.erase(v.begin()); }
+  bool empty() const { return v.empty(); }
+};
+
+int main() {
+  const int n = 1000000;
+  double base = time_ns([&] {
+    leistd::list<int> q;
+    fill_drain(q, n);
+  });
+  report("fill + drain 1M: list", base);
+  report("fill + drain 1M: deque", time_ns([&] {
+           leistd::deque<int> q;
+           fill_drain(q, n);
+         }),
+         base);
+  report("fill + drain 1M: std::deque", time_ns([&] {
+           std::deque<int> q;
+           fill_drain(q, n);
+         }),
+         base);
+
+  const int rounds = 2000000;
+  for (int depth : {16, 1000, 20000}) {
+    std::printf("-- steady FIFO, depth %d, %d rounds --\n", depth, rounds);
+    base = time_ns([&] {
+      leistd::list<int> q;
+      steady(q, depth, rounds);
+    });
+    report("list", base);
+    report("deque", time_ns([&] {
+             leistd::deque<int> q;
+             steady(q, depth, rounds);
+           }),
+           base);
+    report("std::deque", time_ns([&] {
+             std::deque<int> q;
+             steady(q, depth, rounds);
+           }),
+           base);
+    if (depth <= 1000) {  // erase(begin()) 是 O(depth)，深队列上跑不完
+      report("vector + erase(begin())", time_ns([&] {
+               vector_queue q;
+               steady(q, depth, rounds);
+             }),
+             base);
+    }
+  }
+
+  // 随机访问与顺序遍历：list 只能遍历
+  leistd::deque<int> d;
+  leistd::vector<int> v;
+  leistd::list<int> l;
+  for (int i = 0; i < n; ++i) d.push_back(i), v.push_back(i), l.push_back(i);
+  std::printf("-- traverse 1M --\n");
+  base = time_ns([&] {
+    std::int64_t s = 0;
+    for (int x : l) s += x;
+    do_not_optimize(s);
+  });
+  report("list", base);
+  report("deque", time_ns([&] {
+           std::int64_t s = 0;
+           for (int x : d) s += x;
+           do_not_optimize(s);
+         }),
+         base);
+  report("vector", time_ns([&] {
+           std::int64_t s = 0;
+           for (int x : v) s += x;
+           do_not_optimize(s);
+         }),
+         base);
+  std::printf("-- strided index 1M (stride 4099) --\n");
+  base = time_ns([&] {
+    std::int64_t s = 0;
+    for (std::size_t i = 0, j = 0; i < v.size(); ++i, j = (j + 4099) % v.size()) s += v[j];
+    do_not_optimize(s);
+  });
+  report("vector", base);
+  report("deque", time_ns([&] {
+           std::int64_t s = 0;
+           for (std::size_t i = 0, j = 0; i < d.size(); ++i, j = (j + 4099) % d.size()) s += d[j];
+           do_not_optimize(s);
+         }),
+         base);
+}
@@ -0,0 +1,106 @@
+// flat_hash_map vs std::unordered_map：插入、命中查找、未命中查找、删除。
+// 两边用同一个哈希函数（std::hash），差别只在表的组织方式。
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "bench_util.h"
+#include "flat_hash_map_lt.h"
+
+using namespace leistd::bench;
+
+// 删除要在装满的表上测：每轮先建表（不计时），取 3 轮最快的一次
+template <typename Setup, typename Fn>
+double time_min(Setup setup, Fn fn) {
+  double best = 1e300;
+  for (int rep = 0; rep < 3; ++rep) {
+    auto state = setup();
+    auto t0 = std::chrono::steady_clock::now();
+    fn(state);
+    auto t1 = std::chrono::steady_clock::now();
+    best = std::min(best, std::chrono::duration<double, std::nano>(t1 - t0).count());
+  }
+  return best;
+}
+
+struct timings {
+  double insert, hit, miss, erase;
+};
+
+// hits 是表中的键，misses 保证不在表中；查找按打乱后的顺序进行
+template <typename Map, typename Key>
+timings run(const std::vector<Key>& hits, const std::vector<Key>& misses) {
+  auto fill = [&] {
+    Map m;
+    for (std::size_t i = 0; i < hits.size(); ++i) m.emplace(hits[i], i);
+    return m;
+  };
+  timings t;
+  t.insert = time_ns([&] { do_not_optimize(fill().size()); });
+  Map m = fill();
+  std::vector<Key> order = hits;
+  std::shuffle(order.begin(), order.end(), std::mt19937(7));
+  t.hit = time_ns([&] {
+    std::uint64_t s = 0;
+    for (const Key& k : order) s += m.find(k)->second;
+    do_not_optimize(s);
+  });
+  t.miss = time_ns([&] {
+    std::size_t n = 0;
+    for (const Key& k : misses) n += m.count(k);
+    do_not_optimize(n);
+  });
+  t.erase = time_min(fill, [&](Map& mm) {
+    for (const Key& k : order) mm.erase(k);
+    do_not_optimize(mm.size());
+  });
+  return t;
+}
+
+template <typename Key>
+void suite(const char* title, const std::vector<Key>& hits, const std::vector<Key>& misses) {
+  std::printf("-- %s, %zu keys --\n", title, hits.size());
+  timings base = run<std::unordered_map<Key, std::uint64_t>>(hits, misses);
+  timings flat = run<leistd::flat_hash_map<Key, std::uint64_t>>(hits, misses);
+  const char* names[] = {"insert", "lookup hit", "lookup miss", "erase"};
+  double b[] = {base.insert, base.hit, base.miss, base.erase};
+  double f[] = {flat.insert, flat.hit, flat.miss, flat.erase};
+  char label[64];
+  for (int i = 0; i < 4; ++i) {
+    std::snprintf(label, sizeof label, "%s: std::unordered_map", names[i]);
+    report(label, b[i]);
+    std::snprintf(label, sizeof label, "%s: flat_hash_map", names[i]);
+    report(label, f[i], b[i]);
+  }
+}
+
+int main() {
+  std::mt19937_64 rng(42);
+  for (std::size_t n : {10000u, 1000000u}) {
+    // 偶数键入表，奇数键用于未命中查找
+    std::vector<std::uint64_t> hits(n), misses(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      hits[i] = rng() & ~1ull;
+      misses[i] = rng() | 1;
+    }
+    std::sort(hits.begin(), hits.end());
+    hits.erase(std::unique(hits.begin(), hits.end()), hits.end());
+    std::shuffle(hits.begin(), hits.end(), rng);
+    suite("uint64 keys", hits, misses);
+  }
+
+  // 16~40 字节的字符串键：超出 SSO，比较和哈希都不再廉价
+  const std::size_t n = 200000;
+  std::vector<std::string> hits, misses;
+  for (std::size_t i = 0; i < n; ++i) {
+    std::string pad(16 + rng() % 25, 'k');
+    hits.push_back(pad + std::to_string(2 * i));
+    misses.push_back(pad + std::to_string(2 * i + 1));
+  }
+  std::shuffle(hits.begin(), hits.end(), rng);
+  suite("std::string keys", hits, misses);
+}
@@ -0,0 +1,94 @@
+// flat_map vs std::map：乱序批量构造、命中/未命中查找、顺序遍历、批量插入 10% 新键。
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "bench_util.h"
+#include "flat_map_lt.h"
+
+using namespace leistd::bench;
+
+using item = std::pair<std::uint64_t, std::uint64_t>;
+
+// 批量插入要在建好的表上测：每轮先建表（不计时），取 3 轮最快的一次
+template <typename Setup, typename Fn>
+double time_min(Setup setup, Fn fn) {
+  double best = 1e300;
+  for (int rep = 0; rep < 3; ++rep) {
+    auto state = setup();
+    auto t0 = std::chrono::steady_clock::now();
+    fn(state);
+    auto t1 = std::chrono::steady_clock::now();
+    best = std::min(best, std::chrono::duration<double, std::nano>(t1 - t0).count());
+  }
+  return best;
+}
+
+struct timings {
+  double build, hit, miss, iterate, batch;
+};
+
+template <typename Map>
+timings run(const std::vector<item>& init, const std::vector<std::uint64_t>& hits,
+            const std::vector<std::uint64_t>& misses, const std::vector<item>& batch) {
+  auto build = [&] { return Map(init.begin(), init.end()); };
+  timings t;
+  t.build = time_ns([&] { do_not_optimize(build().size()); });
+  Map m = build();
+  t.hit = time_ns([&] {
+    std::uint64_t s = 0;
+    for (std::uint64_t k : hits) s += m.find(k)->second;
+    do_not_optimize(s);
+  });
+  t.miss = time_ns([&] {
+    std::size_t n = 0;
+    for (std::uint64_t k : misses) n += m.count(k);
+    do_not_optimize(n);
+  });
+  t.iterate = time_ns([&] {
+    std::uint64_t s = 0;
+    for (auto it = m.begin(); it != m.end(); ++it) s += it->second;
+    do_not_optimize(s);
+  });
+  t.batch = time_min(build, [&](Map& mm) {
+    mm.insert(batch.begin(), batch.end());
+    do_not_optimize(mm.size());
+  });
+  return t;
+}
+
+void suite(std::size_t n, std::mt19937_64& rng) {
+  // 偶数键入表，奇数键用于未命中查找和批量插入
+  std::vector<item> init(n);
+  for (auto& [k, v] : init) k = rng() & ~1ull, v = rng();
+  std::vector<std::uint64_t> hits(n), misses(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    hits[i] = init[rng() % n].first;
+    misses[i] = rng() | 1;
+  }
+  std::vector<item> batch(n / 10);
+  for (auto& [k, v] : batch) k = rng() | 1, v = rng();
+
+  std::printf("-- %zu uint64 -> uint64 --\n", n);
+  timings base = run<std::map<std::uint64_t, std::uint64_t>>(init, hits, misses, batch);
+  timings flat = run<leistd::flat_map<std::uint64_t, std::uint64_t>>(init, hits, misses, batch);
+  const char* names[] = {"build from unsorted", "lookup hit", "lookup miss", "iterate", "insert n/10 batch"};
+  double b[] = {base.build, base.hit, base.miss, base.iterate, base.batch};
+  double f[] = {flat.build, flat.hit, flat.miss, flat.iterate, flat.batch};
+  char label[64];
+  for (int i = 0; i < 5; ++i) {
+    std::snprintf(label, sizeof label, "%s: std::map", names[i]);
+    report(label, b[i]);
+    std::snprintf(label, sizeof label, "%s: flat_map", names[i]);
+    report(label, f[i], b[i]);
+  }
+}
+
+int main() {
+  std::mt19937_64 rng(42);
+  for (std::size_t n : {1000u, 100000u, 1000000u}) suite(n, rng);
+}
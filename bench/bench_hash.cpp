@@ -0,0 +1,130 @@
+// 字符串哈希：
+//  1. hash_bytes 与 std::hash<std::string_view> 在不同键长下的吞吐；
+//  2. 长键的标量 / SSE2 / AVX2 条带累加与 wyhash 循环对比，用来确定 hash_bytes_long_threshold；
+//  3. flat_hash_map 以 leistd::string 和 hashed_string 为键时的插入、rehash、删除。
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "bench_util.h"
+#include "flat_hash_map_lt.h"
+#include "hash_lt.h"
+
+using namespace leistd::bench;
+
+// 每次哈希 total / len 个长度为 len 的键（键之间错开，不总是同一段缓存行）
+template <typename Fn>
+double bytes_per_ns(const std::vector<char>& buf, std::size_t len, Fn fn) {
+  std::size_t count = std::max<std::size_t>(1, (1u << 24) / (len + 8));
+  std::size_t span = buf.size() - len;
+  double ns = time_ns([&] {
+    std::uint64_t s = 0;
+    std::size_t off = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      s += fn(buf.data() + off, len);
+      off += len + 8;
+      if (off > span) off = i & 63;
+    }
+    do_not_optimize(s);
+  });
+  return static_cast<double>(count) * len / ns;
+}
+
+void throughput(const std::vector<char>& buf) {
+  std::printf("-- throughput (GB/s) --\n");
+  std::printf("%8s %14s %14s\n", "len", "std::hash", "hash_bytes");
+  for (std::size_t len : {4u, 8u, 16u, 24u, 32u, 64u, 128u, 256u, 1024u, 4096u, 65536u}) {
+    double s = bytes_per_ns(buf, len, [](const char* p, std::size_t n) {
+      return std::hash<std::string_view>()(std::string_view(p, n));
+    });
+    double l = bytes_per_ns(buf, len, [](const char* p, std::size_t n) { return leistd::hash_bytes(p, n); });
+    std::printf("%8zu %14.2f %14.2f\n", len, s, l);
+  }
+}
+
+template <auto Hash>
+double path(const std::vector<char>& buf, std::size_t len) {
+  return bytes_per_ns(buf, len, [](const char* p, std::size_t n) {
+    return Hash(reinterpret_cast<const unsigned char*>(p), n, 0);
+  });
+}
+
+// 阈值附近直接比较两条路径：hash_short（wyhash 循环）与三种条带累加实现
+void long_path(const std::vector<char>& buf) {
+  using namespace leistd::hash_bytes_detail;
+  std::printf("-- wyhash loop vs stripe accumulation (GB/s) --\n");
+  std::printf("%8s %10s %10s %10s %10s\n", "len", "wyhash", "scalar", "sse2", "avx2");
+  for (std::size_t len : {256u, 512u, 1024u, 2048u, 3072u, 4096u, 8192u, 65536u}) {
+    double w = path<hash_short>(buf, len), sc = path<hash_long_scalar>(buf, len);
+#ifdef LEISTD_HASH_BYTES_X86
+    double s2 = path<hash_long_sse2>(buf, len);
+    double av = __builtin_cpu_supports("avx2") ? path<hash_long_avx2>(buf, len) : 0.0;
+#else
+    double s2 = 0.0, av = 0.0;
+#endif
+    std::printf("%8zu %10.2f %10.2f %10.2f %10.2f\n", len, w, sc, s2, av);
+  }
+}
+
+// 删除要在装满的表上测：每轮先建表（不计时），取 3 轮最快的一次
+template <typename Setup, typename Fn>
+double time_min(Setup setup, Fn fn) {
+  double best = 1e300;
+  for (int rep = 0; rep < 3; ++rep) {
+    auto state = setup();
+    auto t0 = std::chrono::steady_clock::now();
+    fn(state);
+    auto t1 = std::chrono::steady_clock::now();
+    best = std::min(best, std::chrono::duration<double, std::nano>(t1 - t0).count());
+  }
+  return best;
+}
+
+template <typename Key>
+void table(const char* name, const std::vector<std::string>& src, const double* baseline, double* out) {
+  std::vector<Key> keys;
+  keys.reserve(src.size());
+  for (const auto& s : src) keys.emplace_back(s.c_str());
+  using Map = leistd::flat_hash_map<Key, std::uint32_t>;
+  auto fill = [&] {
+    Map m;
+    for (std::size_t i = 0; i < keys.size(); ++i) m.emplace(keys[i], static_cast<std::uint32_t>(i));
+    return m;
+  };
+  out[0] = time_ns([&] { do_not_optimize(fill().size()); });
+  out[1] = time_min(fill, [&](Map& m) {
+    m.rehash(m.bucket_count() * 4);
+    do_not_optimize(m.size());
+  });
+  out[2] = time_min(fill, [&](Map& m) {
+    for (const Key& k : keys) m.erase(k);
+    do_not_optimize(m.size());
+  });
+  const char* ops[] = {"insert", "rehash x4", "erase"};
+  char label[64];
+  for (int i = 0; i < 3; ++i) {
+    std::snprintf(label, sizeof label, "%s: %s", ops[i], name);
+    report(label, out[i], baseline ? baseline[i] : 0);
+  }
+}
+
+int main() {
+  std::mt19937_64 rng(42);
+  std::vector<char> buf(1 << 22);
+  for (auto& c : buf) c = static_cast<char>(rng());
+  throughput(buf);
+  long_path(buf);
+
+  // 24~64 字节的键：超出 SSO，哈希本身占插入开销的大头
+  std::printf("-- flat_hash_map, 200000 keys --\n");
+  std::vector<std::string> src;
+  for (std::size_t i = 0; i < 200000; ++i) src.push_back(std::string(24 + rng() % 41, 'k') + std::to_string(i));
+  std::shuffle(src.begin(), src.end(), rng);
+  double base[3], hashed[3];
+  table<leistd::string>("leistd::string", src, nullptr, base);
+  table<leistd::hashed_string>("hashed_string", src, base, hashed);
+}
@@ -0,0 +1,94 @@
+// 对象已经在池里：intrusive_list（钩子嵌在对象里）vs list<T*>（每次插入分配一个节点再指回对象）
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "bench_util.h"
+#include "intrusive_list_lt.h"
+#include "list_lt.h"
+
+using namespace leistd::bench;
+
+struct Order {
+  long price = 0;
+  long qty = 0;
+  leistd::list_hook hook;
+};
+
+using intrusive = leistd::intrusive_list<Order, &Order::hook>;
+using pointer_list = leistd::list<Order*>;
+
+// order 给出入队顺序（池下标）
+void run(std::vector<Order>& pool, const std::vector<int>& order) {
+  const int n = pool.size();
+
+  // 1. 入队 + 全部出队
+  double base = time_ns([&] {
+    pointer_list l;
+    for (int i : order) l.push_back(&pool[i]);
+    while (!l.empty()) l.pop_front();
+  });
+  report("push_back + pop_front: list<T*>", base);
+  report("push_back + pop_front: intrusive_list", time_ns([&] {
+           intrusive l;
+           for (int i : order) l.push_back(pool[i]);
+           while (!l.empty()) l.pop_front();
+         }),
+         base);
+
+  // 2. 遍历求和：list<T*> 每个元素多跳一次指针
+  pointer_list pl;
+  intrusive il;
+  for (int i : order) pl.push_back(&pool[i]), il.push_back(pool[i]);
+  long s = 0;
+  base = time_ns([&] {
+    for (Order* o : pl) s += o->price * o->qty;
+    do_not_optimize(s);
+  });
+  report("traverse: list<T*>", base);
+  report("traverse: intrusive_list", time_ns([&] {
+           for (Order& o : il) s += o.price * o.qty;
+           do_not_optimize(s);
+         }),
+         base);
+  il.clear();
+
+  // 3. 按对象删除一半：list<T*> 需要另存每个对象的迭代器，intrusive_list 直接 erase(obj)
+  base = time_ns([&] {
+    pointer_list l;
+    std::vector<pointer_list::iterator> where(n);
+    for (int i : order) {
+      l.push_back(&pool[i]);
+      where[i] = std::prev(l.end());
+    }
+    for (int i = 0; i < n; i += 2) l.erase(where[i]);
+    do_not_optimize(l.size());
+  });
+  report("fill + erase half by object: list<T*> + iterators", base);
+  report("fill + erase half by object: intrusive_list", time_ns([&] {
+           intrusive l;
+           for (int i : order) l.push_back(pool[i]);
+           for (int i = 0; i < n; i += 2) l.erase(pool[i]);
+           do_not_optimize(l.size());
+           l.clear();
+         }),
+         base);
+}
+
+int main() {
+  for (int n : {1000, 100000, 1000000}) {
+    std::vector<Order> pool(n);
+    std::vector<int> order(n);
+    for (int i = 0; i < n; ++i) pool[i].price = i, pool[i].qty = i % 7, order[i] = i;
+
+    std::printf("== %d pooled objects, enqueued in pool order ==\n", n);
+    run(pool, order);
+
+    // 链表顺序与池中位置无关：intrusive_list 的链本身要在池里随机跳转，
+    // 而 list<T*> 的节点按插入顺序连续分配，只有解引用对象时才随机访问（且彼此独立，可以并行）
+    std::shuffle(order.begin(), order.end(), std::mt19937(1));
+    std::printf("== %d pooled objects, enqueued in random order ==\n", n);
+    run(pool, order);
+  }
+  return 0;
+}
@@ -0,0 +1,69 @@
+// 链表节点反复分配/释放（LRU 队列式的 pop_front + push_back），对比 std::allocator 与节点池
+#include <thread>
+#include <vector>
+
+#include "bench_util.h"
+#include "list_lt.h"
+#include "pool_allocator_lt.h"
+
+using namespace leistd::bench;
+
+template <typename List>
+void churn(List& l, int live, int ops) {
+  for (int i = 0; i < live; ++i) l.push_back(i);
+  for (int i = 0; i < ops; ++i) {
+    l.pop_front();
+    l.push_back(i);
+    if (i % 4096 == 0) {  // 偶尔整体清空再填满
+      l.clear();
+      for (int j = 0; j < live; ++j) l.push_back(j);
+    }
+  }
+  do_not_optimize(l.size());
+}
+
+template <typename List, typename... A>
+double bench_single(int live, int ops, A&... alloc) {
+  return time_ns([&] {
+    List l(alloc...);
+    churn(l, live, ops);
+  });
+}
+
+template <typename List>
+double bench_threads(int threads, int live, int ops) {
+  return time_ns([&] {
+    std::vector<std::thread> ts;
+    for (int t = 0; t < threads; ++t)
+      ts.emplace_back([&] {
+        List l;
+        churn(l, live, ops);
+      });
+    for (auto& t : ts) t.join();
+  });
+}
+
+int main() {
+  constexpr int ops = 1000000;
+  for (int live : {64, 4096, 100000}) {
+    std::printf("== %d live nodes, %d pop_front+push_back ==\n", live, ops);
+    double base = bench_single<leistd::list<long, std::allocator<long>>>(live, ops);
+    report("std::allocator", base);
+    leistd::slab_pool pool;
+    report("pool_allocator (per-list slab_pool)",
+           bench_single<leistd::list<long, leistd::pool_allocator<long>>>(live, ops, pool), base);
+    report("shared_pool_allocator (thread cache)",
+           bench_single<leistd::list<long, leistd::shared_pool_allocator<long>>>(live, ops), base);
+    report("shared_pool_allocator (locked, no cache)",
+           bench_single<leistd::list<long, leistd::shared_pool_allocator<long, false>>>(live, ops), base);
+  }
+
+  std::printf("== 4 threads, 4096 live nodes each ==\n");
+  double base = bench_threads<leistd::list<long, std::allocator<long>>>(4, 4096, ops);
+  report("std::allocator", base);
+  report("shared_pool_allocator (thread cache)",
+         bench_threads<leistd::list<long, leistd::shared_pool_allocator<long>>>(4, 4096, ops), base);
+  report("shared_pool_allocator (locked, no cache)",
+         bench_threads<leistd::list<long, leistd::shared_pool_allocator<long, false>>>(4, 4096, ops), base);
+  return 0;
+}
@@ -0,0 +1,66 @@
+// list::sort（重新链接节点的自然归并排序）vs 拷贝到 vector、std::sort、再重建链表
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "arena_lt.h"
+#include "bench_util.h"
+#include "list_lt.h"
+
+using namespace leistd::bench;
+
+// 每轮在新的 arena 上建表：节点按建表顺序连续排列，不受上一轮释放节点后堆布局的影响
+using arena_list = leistd::list<int, leistd::arena_allocator<int>>;
+
+// 排序会改变输入，每轮重新生成数据，只计排序本身
+template <typename Build, typename Sort>
+double time_sort(Build build, Sort sort, int iters = 3) {
+  double total = 0;
+  for (int i = 0; i < iters; ++i) {
+    leistd::monotonic_arena arena(1 << 20);
+    arena_list l = build(arena);
+    auto t0 = std::chrono::steady_clock::now();
+    sort(l);
+    auto t1 = std::chrono::steady_clock::now();
+    total += std::chrono::duration<double, std::nano>(t1 - t0).count();
+    do_not_optimize(l.front());
+  }
+  return total / iters;
+}
+
+void sort_via_vector(arena_list& l) {
+  std::vector<int> v(l.begin(), l.end());
+  std::sort(v.begin(), v.end());
+  l.clear();
+  for (int x : v) l.push_back(x);
+}
+
+int main() {
+  constexpr int n = 10000000;
+  std::mt19937 rng(42);
+  std::vector<int> random(n), nearly(n), reversed(n);
+  for (int i = 0; i < n; ++i) {
+    random[i] = rng();
+    nearly[i] = i;
+    reversed[i] = n - i;
+  }
+  for (int i = 0; i < n / 100; ++i) std::swap(nearly[rng() % n], nearly[rng() % n]);  // 1% 的元素被打乱
+
+  struct input {
+    const char* name;
+    const std::vector<int>* data;
+  };
+  for (auto in : {input{"random", &random}, input{"nearly sorted (1% swaps)", &nearly}, input{"reversed", &reversed}}) {
+    std::printf("== %d ints, %s ==\n", n, in.name);
+    auto build = [&](leistd::monotonic_arena& arena) {
+      arena_list l(arena);
+      for (int x : *in.data) l.push_back(x);
+      return l;
+    };
+    double base = time_sort(build, sort_via_vector);
+    report("copy to vector + std::sort + rebuild", base);
+    report("list::sort", time_sort(build, [](arena_list& l) { l.sort(); }), base);
+  }
+  return 0;
+}
@@ -0,0 +1,73 @@
+// 批量交接：每轮从共享队列头部切下 batch 个节点交给工作线程的本地链表，处理完再整体还回队尾
+#include <iterator>
+
+#include "bench_util.h"
+#include "list_lt.h"
+
+using namespace leistd::bench;
+
+enum class mode { counted_by_walk, caller_count, lazy_size };
+
+template <typename List>
+double bench_handoff(int total, int batch, int rounds, mode m) {
+  List queue, local;
+  for (int i = 0; i < total; ++i) queue.push_back(i);
+  return time_ns([&] {
+    for (int r = 0; r < rounds; ++r) {
+      auto first = queue.begin();
+      auto last = queue.begin();
+      for (int i = 0; i < batch; ++i) ++last;  // 生产端本来就要走一遍来填充批次
+      if (m == mode::caller_count)
+        local.splice(local.end(), queue, first, last, batch);
+      else
+        local.splice(local.end(), queue, first, last);
+      queue.splice(queue.end(), local);
+    }
+    do_not_optimize(queue.size());
+  });
+}
+
+// 只测 splice 本身：切分点固定在两条链表的首尾，交替来回搬运
+template <typename List>
+double bench_splice_only(int batch, int rounds, mode m) {
+  List a, b;
+  for (int i = 0; i < batch; ++i) a.push_back(i);
+  return time_ns([&] {
+    for (int r = 0; r < rounds; ++r) {
+      List& from = r % 2 ? b : a;
+      List& to = r % 2 ? a : b;
+      if (m == mode::caller_count)
+        to.splice(to.end(), from, from.begin(), from.end(), batch);
+      else
+        to.splice(to.end(), from, from.begin(), from.end());
+    }
+    do_not_optimize(a.size() + b.size());
+  });
+}
+
+int main() {
+  using eager = leistd::list<int>;
+  using lazy = leistd::lazy_size_list<int>;
+  constexpr int rounds = 1000;
+
+  for (int batch : {100, 10000, 50000}) {
+    std::printf("== splice %d-node range back and forth, %d times ==\n", batch, rounds);
+    double base = bench_splice_only<eager>(batch, rounds, mode::counted_by_walk);
+    report("splice(pos, other, first, last)", base);
+    report("splice(pos, other, first, last, count)", bench_splice_only<eager>(batch, rounds, mode::caller_count),
+           base);
+    report("lazy_size_list splice(pos, other, first, last)",
+           bench_splice_only<lazy>(batch, rounds, mode::lazy_size), base);
+  }
+
+  for (int batch : {1000, 20000}) {
+    std::printf("== work-queue handoff: 200000 nodes, batches of %d, %d rounds ==\n", batch, rounds / 10);
+    double base = bench_handoff<eager>(200000, batch, rounds / 10, mode::counted_by_walk);
+    report("splice(pos, other, first, last)", base);
+    report("splice(pos, other, first, last, count)",
+           bench_handoff<eager>(200000, batch, rounds / 10, mode::caller_count), base);
+    report("lazy_size_list (size() once at the end)",
+           bench_handoff<lazy>(200000, batch, rounds / 10, mode::lazy_size), base);
+  }
+  return 0;
+}
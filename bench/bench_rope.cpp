@@ -0,0 +1,82 @@
+// rope 与 basic_string 在大量拼接/中间插入场景下的对比
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+#include "rope_lt.h"
+
+using namespace leistd::bench;
+
+static std::vector<std::string> make_fragments(int count) {
+  std::vector<std::string> frags;
+  for (int i = 0; i < count; ++i) frags.push_back("<li id=\"" + std::to_string(i) + "\">item</li>\n");
+  return frags;
+}
+
+int main() {
+  for (int count : {2000, 20000}) {
+    std::vector<std::string> frags = make_fragments(count);
+    std::printf("== assemble %d fragments ==\n", count);
+
+    // 每次 s = s + frag 都会拷贝整个左操作数
+    double base = time_ns([&] {
+      leistd::string s;
+      for (const std::string& f : frags) s = s + f.c_str();
+      do_not_optimize(s.size());
+    });
+    report("string s = s + frag", base);
+    report("string s += frag", time_ns([&] {
+             leistd::string s;
+             for (const std::string& f : frags) s += leistd::string_view(f.data(), f.size());
+             do_not_optimize(s.size());
+           }),
+           base);
+    report("rope r += frag", time_ns([&] {
+             leistd::crope r;
+             for (const std::string& f : frags) r += leistd::string_view(f.data(), f.size());
+             do_not_optimize(r.size());
+           }),
+           base);
+    report("rope r += frag, then flatten", time_ns([&] {
+             leistd::crope r;
+             for (const std::string& f : frags) r += leistd::string_view(f.data(), f.size());
+             leistd::string s = r.flatten();
+             do_not_optimize(s.size());
+           }),
+           base);
+  }
+
+  // 在 4 MiB 文本中间反复插入
+  leistd::string text;
+  text.append(std::size_t(4) << 20, 'x');
+  std::printf("== 1000 inserts into the middle of 4 MiB ==\n");
+  double base = time_ns([&] {
+    leistd::string s(text);
+    for (int i = 0; i < 1000; ++i) s.insert(s.size() / 2, "inserted text");
+    do_not_optimize(s.size());
+  });
+  report("string insert middle", base);
+  report("rope insert middle", time_ns([&] {
+           leistd::crope r(text);
+           for (int i = 0; i < 1000; ++i) r.insert(r.size() / 2, "inserted text");
+           do_not_optimize(r.size());
+         }),
+         base);
+
+  // 输出：按片段遍历（writev 风格） vs 先拼成连续字符串
+  leistd::crope r;
+  for (const std::string& f : make_fragments(100000)) r += leistd::string_view(f.data(), f.size());
+  std::printf("== emit a %zu-char rope ==\n", r.size());
+  base = time_ns([&] {
+    leistd::string s = r.flatten();
+    do_not_optimize(s.size());
+  });
+  report("flatten", base);
+  report("walk chunks", time_ns([&] {
+           std::size_t total = 0;
+           for (leistd::string_view c : r.chunks()) total += c.size();
+           do_not_optimize(total);
+         }),
+         base);
+  return 0;
+}
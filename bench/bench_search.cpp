@@ -0,0 +1,87 @@
+// 有序数组查找：
+//  1. 大数组（uint32，分别落在 L1 / L2 / L3 / 内存）：std::lower_bound、无分支二分（有无预取）、Eytzinger 索引；
+//  2. 小 array<int, N>：std::lower_bound、编译期展开的二分、直接计数，用来确定 linear_search_bytes。
+// 每次查询互相独立，给出的是吞吐（ns / 次）
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "bench_util.h"
+#include "search_lt.h"
+
+using namespace leistd::bench;
+
+template <typename Fn>
+double per_query(const std::vector<std::uint32_t>& queries, Fn fn) {
+  double ns = time_ns(
+      [&] {
+        std::uint64_t s = 0;
+        for (std::uint32_t q : queries) s += fn(q);
+        do_not_optimize(s);
+      },
+      3);
+  return ns / static_cast<double>(queries.size());
+}
+
+void large(std::size_t n, const char* where, std::mt19937_64& rng) {
+  // 键取偶数，查询一半命中一半不命中
+  std::vector<std::uint32_t> v(n);
+  for (std::size_t i = 0; i < n; ++i) v[i] = static_cast<std::uint32_t>(2 * i);
+  std::vector<std::uint32_t> queries(1 << 20);
+  for (auto& q : queries) q = static_cast<std::uint32_t>(rng() % (2 * n));
+  leistd::eytzinger_index<std::uint32_t> index(v);
+
+  const std::uint32_t* first = v.data();
+  auto n_diff = static_cast<std::ptrdiff_t>(n);
+  std::less<> comp;
+  double s = per_query(queries, [&](std::uint32_t q) { return std::lower_bound(first, first + n, q) - first; });
+  double b = per_query(queries, [&](std::uint32_t q) {
+    return leistd::search_detail::branchless_lower_bound<false>(first, n_diff, q, comp) - first;
+  });
+  double p = per_query(queries, [&](std::uint32_t q) {
+    return leistd::search_detail::branchless_lower_bound<true>(first, n_diff, q, comp) - first;
+  });
+  double e = per_query(queries, [&](std::uint32_t q) { return index.lower_bound(q); });
+  std::printf("%10zu %-5s %10.1f %12.1f %12.1f %12.1f\n", n, where, s, b, p, e);
+}
+
+template <std::size_t N>
+void small(std::mt19937_64& rng) {
+  leistd::array<int, N> a;
+  for (std::size_t i = 0; i < N; ++i) a[i] = static_cast<int>(3 * i);
+  std::vector<std::uint32_t> queries(1 << 20);
+  for (auto& q : queries) q = static_cast<std::uint32_t>(rng() % (3 * N + 1));
+  std::less<> comp;
+  double s = per_query(queries, [&](std::uint32_t q) {
+    return std::lower_bound(a.begin(), a.end(), static_cast<int>(q)) - a.begin();
+  });
+  double u = per_query(queries, [&](std::uint32_t q) {
+    return leistd::search_detail::unrolled_lower_bound<N>(a.data(), static_cast<int>(q), comp) - a.data();
+  });
+  double c = per_query(queries, [&](std::uint32_t q) {
+    return leistd::search_detail::count_less<N>(a.data(), static_cast<int>(q), comp);
+  });
+  std::printf("%6zu %12.2f %12.2f %12.2f\n", N, s, u, c);
+}
+
+int main() {
+  std::mt19937_64 rng(42);
+  std::printf("-- sorted uint32, ns per query --\n");
+  std::printf("%10s %-5s %10s %12s %12s %12s\n", "n", "", "std", "branchless", "+prefetch", "eytzinger");
+  large(4096, "L1", rng);
+  large(256 * 1024, "L2", rng);
+  large(16 * 1024 * 1024, "L3", rng);
+  large(128 * 1024 * 1024, "DRAM", rng);
+
+  std::printf("-- array<int, N>, ns per query --\n");
+  std::printf("%6s %12s %12s %12s\n", "N", "std", "unrolled", "count");
+  small<4>(rng);
+  small<8>(rng);
+  small<16>(rng);
+  small<32>(rng);
+  small<64>(rng);
+  small<128>(rng);
+}
@@ -0,0 +1,54 @@
+// small_vector 与 vector 在小规模场景下的分配次数与延迟
+#include <cstdlib>
+#include <new>
+
+#include "bench_util.h"
+#include "small_vector.h"
+
+using namespace leistd::bench;
+
+static std::size_t g_allocs = 0;
+
+void* operator new(std::size_t n) {
+  ++g_allocs;
+  if (void* p = std::malloc(n)) return p;
+  throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+template <typename Vec>
+void run(const char* name, int elems, double baseline_ns) {
+  constexpr int kRounds = 100000;
+  g_allocs = 0;
+  double ns = time_ns(
+      [&] {
+        for (int r = 0; r < kRounds; ++r) {
+          Vec v;
+          for (int i = 0; i < elems; ++i) v.push_back(i);
+          do_not_optimize(v[0]);
+        }
+      },
+      1);
+  std::printf("%-30s elems %3d  allocs/vec %5.2f  ", name, elems, double(g_allocs) / (2 * kRounds));
+  std::printf("%8.1f ns/vec", ns / kRounds);
+  if (baseline_ns > 0) std::printf("  (%.2fx)", baseline_ns / ns);
+  std::printf("\n");
+}
+
+int main() {
+  for (int elems : {1, 4, 8, 16, 17, 64}) {
+    double base = time_ns(
+        [&] {
+          for (int r = 0; r < 100000; ++r) {
+            leistd::vector<int> v;
+            for (int i = 0; i < elems; ++i) v.push_back(i);
+            do_not_optimize(v[0]);
+          }
+        },
+        1);
+    run<leistd::vector<int>>("leistd::vector<int>", elems, 0);
+    run<leistd::small_vector<int, 16>>("leistd::small_vector<int, 16>", elems, base);
+  }
+  return 0;
+}
@@ -0,0 +1,53 @@
+// 子串查找：不同模式串长度下各查找内核的耗时
+#include <random>
+#include <string>
+
+#include "bench_util.h"
+#include "string_lt.h"
+
+using namespace leistd::bench;
+
+// 原来 basic_string::find 的双重循环
+static std::size_t find_naive(const char* s, std::size_t n, const char* p, std::size_t m) {
+  for (std::size_t i = 0; i + m <= n; ++i) {
+    std::size_t j = 0;
+    while (j < m && s[i + j] == p[j]) ++j;
+    if (j == m) return i;
+  }
+  return leistd::search_npos;
+}
+
+int main() {
+  // 4MB 类日志文本：小写字母 + 空格，模式串放在末尾，保证扫描整个缓冲区
+  std::mt19937 rng(1);
+  std::string hay;
+  for (int i = 0; i < (4 << 20); ++i) hay.push_back("abcdefghijklmnopqrstuvwxyz    "[rng() % 30]);
+  const char* s = hay.data();
+  std::size_t n = hay.size();
+
+  for (std::size_t m : {1, 2, 4, 8, 16, 32, 64, 128, 256}) {
+    std::string needle = hay.substr(n - m);
+    const char* p = needle.data();
+    std::printf("== needle length %zu ==\n", m);
+
+    double base = time_ns([&] { do_not_optimize(find_naive(s, n, p, m)); }, 3);
+    report("naive double loop", base);
+    report("std::string::find", time_ns([&] { do_not_optimize(hay.find(needle)); }, 3), base);
+    if (m >= 2) {
+      report("scalar memchr+memcmp", time_ns([&] { do_not_optimize(leistd::find_substring_scalar(s, n, p, m)); }, 3),
+             base);
+      report("horspool", time_ns([&] { do_not_optimize(leistd::find_substring_horspool(s, n, p, m)); }, 3), base);
+      report("portable (no SIMD)", time_ns([&] { do_not_optimize(leistd::find_substring_portable(s, n, p, m)); }, 3),
+             base);
+#ifdef LEISTD_X86_SIMD
+      report("sse2 first/last", time_ns([&] { do_not_optimize(leistd::find_substring_sse2(s, n, p, m)); }, 3), base);
+      if (__builtin_cpu_supports("avx2"))
+        report("avx2 first/last", time_ns([&] { do_not_optimize(leistd::find_substring_avx2(s, n, p, m)); }, 3),
+               base);
+#endif
+    }
+    report("leistd::find_substring (dispatch)", time_ns([&] { do_not_optimize(leistd::find_substring(s, n, p, m)); }, 3),
+           base);
+  }
+  return 0;
+}
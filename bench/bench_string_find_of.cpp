@@ -0,0 +1,50 @@
+// find_first_of 家族：不同字符集合大小下，原嵌套循环与字符集合引擎各内核的耗时
+#include <random>
+#include <string>
+
+#include "bench_util.h"
+#include "string_lt.h"
+
+using namespace leistd::bench;
+
+// 原来 find_first_of 的嵌套循环
+static std::size_t find_first_of_naive(const char* s, std::size_t n, const char* chars, std::size_t k) {
+  for (std::size_t i = 0; i < n; ++i)
+    for (std::size_t j = 0; j < k; ++j)
+      if (s[i] == chars[j]) return i;
+  return leistd::search_npos;
+}
+
+int main() {
+  // 1MB 只含小写字母的文本，集合里的字符都不出现，保证扫描全部输入
+  std::mt19937 rng(3);
+  std::string text;
+  for (int i = 0; i < (1 << 20); ++i) text.push_back('a' + rng() % 26);
+  const char* s = text.data();
+  std::size_t n = text.size();
+
+  const char* sets[] = {",", ",;", "\t\r\n ", ",;:|\t\r\n \"'", "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ!#$%&()*+-./<=>?@"};
+  for (const char* chars : sets) {
+    std::size_t k = std::char_traits<char>::length(chars);
+    leistd::char_set set(chars, k);
+    std::printf("== set size %zu ==\n", k);
+
+    double base = time_ns([&] { do_not_optimize(find_first_of_naive(s, n, chars, k)); }, 3);
+    report("find_first_of naive O(n*k)", base);
+    report("std::string::find_first_of", time_ns([&] { do_not_optimize(text.find_first_of(chars)); }, 3), base);
+    report("bitmap scalar",
+           time_ns([&] { do_not_optimize(leistd::char_set::find_first_scalar(set, s, n, false)); }, 3), base);
+#ifdef LEISTD_X86_SIMD
+    report("ssse3 nibble shuffle",
+           time_ns([&] { do_not_optimize(leistd::char_set::find_first_ssse3(set, s, n, false)); }, 3), base);
+    if (__builtin_cpu_supports("avx2"))
+      report("avx2 nibble shuffle",
+             time_ns([&] { do_not_optimize(leistd::char_set::find_first_avx2(set, s, n, false)); }, 3), base);
+#endif
+    report("char_set::find_first (dispatch)", time_ns([&] { do_not_optimize(set.find_first(s, n, false)); }, 3),
+           base);
+    report("char_set::find_last (dispatch)",
+           time_ns([&] { do_not_optimize(set.find_last(s, n, false)); }, 3), base);
+  }
+  return 0;
+}
@@ -0,0 +1,53 @@
+// 在大缓冲区的头部/中间/尾部反复插入，对比 std::string
+#include <string>
+
+#include "bench_util.h"
+#include "string_lt.h"
+
+using namespace leistd::bench;
+
+enum class where { head, middle, tail };
+
+template <typename Str>
+double bench_insert(std::size_t base_len, where w, int inserts) {
+  const char piece[] = "0123456789abcdef";
+  return time_ns([&] {
+    Str s;
+    s.append(base_len, 'x');
+    for (int i = 0; i < inserts; ++i) {
+      std::size_t pos = w == where::head ? 0 : (w == where::middle ? s.size() / 2 : s.size());
+      s.insert(pos, piece);
+    }
+    do_not_optimize(s.size());
+  });
+}
+
+template <typename Str>
+double bench_insert_char(std::size_t base_len, int inserts) {
+  return time_ns([&] {
+    Str s;
+    s.append(base_len, 'x');
+    for (int i = 0; i < inserts; ++i) s.insert(s.size() / 2, 1, 'y');
+    do_not_optimize(s.size());
+  });
+}
+
+int main() {
+  const char* names[] = {"head", "middle", "tail"};
+  for (std::size_t len : {std::size_t(1) << 10, std::size_t(1) << 16, std::size_t(4) << 20}) {
+    int inserts = len > (1 << 20) ? 200 : 2000;
+    std::printf("== base length %zu, %d inserts of 16 chars ==\n", len, inserts);
+    for (where w : {where::head, where::middle, where::tail}) {
+      char label[64];
+      std::snprintf(label, sizeof label, "insert %s std::string", names[static_cast<int>(w)]);
+      double base = bench_insert<std::string>(len, w, inserts);
+      report(label, base);
+      std::snprintf(label, sizeof label, "insert %s leistd::string", names[static_cast<int>(w)]);
+      report(label, bench_insert<leistd::string>(len, w, inserts), base);
+    }
+    double base = bench_insert_char<std::string>(len, inserts);
+    report("insert 1 char middle std::string", base);
+    report("insert 1 char middle leistd::string", bench_insert_char<leistd::string>(len, inserts), base);
+  }
+  return 0;
+}
@@ -0,0 +1,49 @@
+// 短字符串构造/拷贝/移动的吞吐，对比 std::string
+#include <string>
+#include <vector>
+
+#include "bench_util.h"
+#include "string_lt.h"
+
+using namespace leistd::bench;
+
+template <typename Str>
+double bench_construct(const std::vector<const char*>& keys) {
+  return time_ns([&] {
+    std::size_t total = 0;
+    for (int r = 0; r < 100; ++r)
+      for (const char* k : keys) {
+        Str s(k);
+        total += s.size();
+      }
+    do_not_optimize(total);
+  });
+}
+
+template <typename Str>
+double bench_copy_move(const std::vector<const char*>& keys) {
+  std::vector<Str> src;
+  for (const char* k : keys) src.emplace_back(k);
+  return time_ns([&] {
+    for (int r = 0; r < 100; ++r) {
+      std::vector<Str> copies(src);
+      std::vector<Str> moved(std::move(copies));
+      do_not_optimize(moved.size());
+    }
+  });
+}
+
+int main() {
+  const char* samples[] = {"", "id", "user_name", "x-request-id", "fifteen chars!!", "a longer header value!"};
+  for (const char* sample : samples) {
+    std::vector<const char*> keys(10000, sample);
+    std::printf("== key length %zu ==\n", std::char_traits<char>::length(sample));
+    double base = bench_construct<std::string>(keys);
+    report("construct std::string", base);
+    report("construct leistd::string", bench_construct<leistd::string>(keys), base);
+    base = bench_copy_move<std::string>(keys);
+    report("copy+move std::string", base);
+    report("copy+move leistd::string", bench_copy_move<leistd::string>(keys), base);
+  }
+  return 0;
+}
@@ -0,0 +1,117 @@
+// 展开链表 vs 普通双向链表：遍历速度、两端推入弹出、内存占用
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "bench_util.h"
+#include "list_lt.h"
+#include "unrolled_list_lt.h"
+
+using namespace leistd::bench;
+
+// 统计从堆申请的总字节数（含每个分配块的 malloc 头，按 16 字节估算）
+inline std::size_t g_heap_bytes = 0;
+
+template <typename T>
+struct counting_allocator {
+  using value_type = T;
+  counting_allocator() = default;
+  template <typename U>
+  counting_allocator(const counting_allocator<U>&) {}
+  T* allocate(std::size_t n) {
+    g_heap_bytes += n * sizeof(T) + 16;
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T* p, std::size_t n) {
+    g_heap_bytes -= n * sizeof(T) + 16;
+    std::allocator<T>().deallocate(p, n);
+  }
+  template <typename U>
+  bool operator==(const counting_allocator<U>&) const {
+    return true;
+  }
+};
+
+template <typename List>
+std::int64_t sum(const List& l) {
+  std::int64_t s = 0;
+  for (auto x : l) s += x;
+  return s;
+}
+
+// 交错构建：轮流往 16 条链表追加，再拼成一条，模拟节点在堆上分散的长寿命链表
+template <typename List>
+List build_interleaved(int n) {
+  std::vector<List> parts(16);
+  for (int i = 0; i < n; ++i) parts[i % 16].push_back(i);
+  List l;
+  for (auto& p : parts) l.splice(l.end(), p);
+  return l;
+}
+
+template <typename List>
+void bench_traverse(const char* name, const List& l, double base = 0) {
+  std::int64_t s = 0;
+  double ns = time_ns([&] { do_not_optimize(s += sum(l)); }, 20);
+  report(name, ns, base);
+}
+
+template <typename List>
+double bench_deque_ops(int n) {
+  return time_ns([&] {
+    List l;
+    for (int i = 0; i < n; ++i) {
+      l.push_back(i);
+      l.push_front(i);
+    }
+    for (int i = 0; i < n; ++i) {
+      l.pop_front();
+      l.pop_back();
+    }
+    do_not_optimize(l.size());
+  });
+}
+
+int main() {
+  using plain = leistd::list<int, counting_allocator<int>>;
+  using unrolled = leistd::unrolled_list<int, leistd::unrolled_default_chunk_size<int>, counting_allocator<int>>;
+
+  for (int n : {1000, 100000, 2000000}) {
+    std::printf("== %d ints: traversal (sum) ==\n", n);
+    {
+      plain a;
+      unrolled b;
+      for (int i = 0; i < n; ++i) a.push_back(i), b.push_back(i);
+      double base = time_ns([&] { do_not_optimize(sum(a)); }, 20);
+      report("list, sequential build", base);
+      bench_traverse("unrolled_list, sequential build", b, base);
+    }
+    {
+      plain a = build_interleaved<plain>(n);
+      unrolled b = build_interleaved<unrolled>(n);
+      double base = time_ns([&] { do_not_optimize(sum(a)); }, 20);
+      report("list, interleaved build", base);
+      bench_traverse("unrolled_list, interleaved build", b, base);
+    }
+
+    std::printf("== %d ints: push_back+push_front, then pop both ends ==\n", n);
+    double base = bench_deque_ops<plain>(n);
+    report("list", base);
+    report("unrolled_list", bench_deque_ops<unrolled>(n), base);
+
+    std::printf("== %d ints: heap footprint ==\n", n);
+    {
+      g_heap_bytes = 0;
+      plain a;
+      for (int i = 0; i < n; ++i) a.push_back(i);
+      std::printf("%-48s %12zu B  (%.1f B/elem)\n", "list", g_heap_bytes, double(g_heap_bytes) / n);
+    }
+    {
+      g_heap_bytes = 0;
+      unrolled b;
+      for (int i = 0; i < n; ++i) b.push_back(i);
+      std::printf("%-48s %12zu B  (%.1f B/elem)\n", "unrolled_list", g_heap_bytes, double(g_heap_bytes) / n);
+    }
+  }
+  return 0;
+}
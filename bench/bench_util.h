@@ -0,0 +1,30 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+
+namespace leistd::bench {
+
+// 防止编译器把被测代码优化掉
+template <typename T>
+inline void do_not_optimize(T const& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// 重复执行 fn，返回单次平均耗时（纳秒）
+template <typename Fn>
+double time_ns(Fn&& fn, int iters = 5) {
+  fn();  // 预热
+  auto t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < iters; ++i) fn();
+  auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(t1 - t0).count() / iters;
+}
+
+inline void report(const char* name, double ns, double baseline_ns = 0) {
+  if (baseline_ns > 0)
+    std::printf("%-48s %12.0f ns  (%.2fx)\n", name, ns, baseline_ns / ns);
+  else
+    std::printf("%-48s %12.0f ns\n", name, ns);
+}
+
+}  // namespace leistd::bench
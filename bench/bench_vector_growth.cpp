@@ -0,0 +1,82 @@
+// 不同扩容策略下 vector 的内存浪费、峰值占用、分配次数与耗时
+#include <cstdint>
+#include <random>
+
+#include "bench_util.h"
+#include "vector.h"
+
+using namespace leistd::bench;
+
+struct alloc_stats {
+  std::size_t live = 0;
+  std::size_t peak = 0;
+  std::size_t count = 0;
+};
+
+inline alloc_stats g_stats;
+
+template <typename T>
+struct counting_allocator {
+  using value_type = T;
+  counting_allocator() = default;
+  template <typename U>
+  counting_allocator(const counting_allocator<U>&) {}
+
+  T* allocate(std::size_t n) {
+    g_stats.live += n * sizeof(T);
+    g_stats.peak = std::max(g_stats.peak, g_stats.live);
+    ++g_stats.count;
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(T* p, std::size_t n) {
+    g_stats.live -= n * sizeof(T);
+    std::allocator<T>().deallocate(p, n);
+  }
+};
+
+template <typename Policy>
+void run(const char* name, const std::vector<std::size_t>& sizes, double baseline_ns) {
+  using Vec = leistd::vector<std::uint64_t, counting_allocator<std::uint64_t>, Policy>;
+  double waste = 0, peak_ratio = 0;
+  std::size_t allocs = 0;
+  for (std::size_t n : sizes) {
+    g_stats = {};
+    Vec v;
+    for (std::size_t i = 0; i < n; ++i) v.push_back(i);
+    waste += double(v.capacity() - v.size()) / v.size();
+    peak_ratio += double(g_stats.peak) / (n * sizeof(std::uint64_t));
+    allocs += g_stats.count;
+  }
+  double ns = time_ns([&] {
+    for (std::size_t n : sizes) {
+      Vec v;
+      for (std::size_t i = 0; i < n; ++i) v.push_back(i);
+      do_not_optimize(v.size());
+    }
+  });
+  std::printf("%-20s waste %5.1f%%  peak/size %.2f  allocs/vec %5.1f  %12.0f ns (%.2fx)\n", name,
+              100 * waste / sizes.size(), peak_ratio / sizes.size(), double(allocs) / sizes.size(), ns,
+              baseline_ns / ns);
+}
+
+int main() {
+  std::mt19937_64 rng(42);
+  std::uniform_int_distribution<std::size_t> dist(1, 1 << 20);
+  std::vector<std::size_t> sizes(64);
+  for (auto& n : sizes) n = dist(rng);
+
+  g_stats = {};
+  double base = time_ns([&] {
+    for (std::size_t n : sizes) {
+      leistd::vector<std::uint64_t, counting_allocator<std::uint64_t>> v;
+      for (std::size_t i = 0; i < n; ++i) v.push_back(i);
+      do_not_optimize(v.size());
+    }
+  });
+  run<leistd::growth_factor_2x>("2x", sizes, base);
+  run<leistd::growth_factor_1_5x>("1.5x", sizes, base);
+  run<leistd::page_rounded_growth<>>("2x page-rounded", sizes, base);
+  run<leistd::page_rounded_growth<leistd::growth_factor_1_5x>>("1.5x page-rounded", sizes, base);
+  run<leistd::size_class_growth<>>("1.5x size-class", sizes, base);
+  return 0;
+}
@@ -0,0 +1,80 @@
+// vector 扩容/插入/删除在不同重定位路径下的耗时
+#include <memory>
+#include <vector>
+
+#include "bench_util.h"
+#include "vector.h"
+
+using namespace leistd::bench;
+
+struct Pod {
+  int a, b, c, d;
+};
+
+// 有自定义移动构造，不满足平凡可重定位，只能逐个 move + destroy
+struct Tracked {
+  int v;
+  Tracked(int x) : v(x) {}
+  Tracked(const Tracked& o) : v(o.v) {}
+  Tracked(Tracked&& o) noexcept : v(o.v) {}
+  Tracked& operator=(const Tracked&) = default;
+  Tracked& operator=(Tracked&&) noexcept = default;
+  ~Tracked() {}
+};
+
+// 与 Tracked 完全相同，但声明为可平凡重定位
+struct Relocatable : Tracked {
+  using Tracked::Tracked;
+};
+
+template <>
+struct leistd::is_trivially_relocatable<Relocatable> : std::true_type {};
+
+template <typename Vec, typename Make>
+double bench_growth(std::size_t n, Make make) {
+  return time_ns([&] {
+    Vec v;
+    for (std::size_t i = 0; i < n; ++i) v.push_back(make(i));
+    do_not_optimize(v.size());
+  });
+}
+
+template <typename Vec, typename Make>
+double bench_insert_erase(std::size_t n, Make make) {
+  Vec v;
+  for (std::size_t i = 0; i < n; ++i) v.push_back(make(i));
+  return time_ns(
+      [&] {
+        for (int i = 0; i < 100; ++i) v.insert(v.begin() + v.size() / 2, make(i));
+        for (int i = 0; i < 100; ++i) v.erase(v.begin() + v.size() / 2);
+        do_not_optimize(v.size());
+      },
+      3);
+}
+
+int main() {
+  constexpr std::size_t N = 1 << 21;
+
+  std::printf("== push_back growth, %zu elements ==\n", N);
+  auto pod = [](std::size_t i) { return Pod{int(i), 0, 0, 0}; };
+  double base = bench_growth<std::vector<Pod>>(N, pod);
+  report("std::vector<Pod>", base);
+  report("leistd::vector<Pod> (memcpy)", bench_growth<leistd::vector<Pod>>(N, pod), base);
+
+  auto uptr = [](std::size_t i) { return std::make_unique<int>(int(i)); };
+  base = bench_growth<std::vector<std::unique_ptr<int>>>(N, uptr);
+  report("std::vector<unique_ptr>", base);
+  report("leistd::vector<unique_ptr> (memcpy)", bench_growth<leistd::vector<std::unique_ptr<int>>>(N, uptr), base);
+
+  auto tracked = [](std::size_t i) { return Tracked(int(i)); };
+  auto reloc = [](std::size_t i) { return Relocatable(int(i)); };
+  base = bench_growth<leistd::vector<Tracked>>(N, tracked);
+  report("leistd::vector<Tracked> (move+destroy)", base);
+  report("leistd::vector<Relocatable> (memcpy)", bench_growth<leistd::vector<Relocatable>>(N, reloc), base);
+
+  std::printf("== 100 x insert/erase in the middle, %zu elements ==\n", N / 8);
+  base = bench_insert_erase<leistd::vector<Tracked>>(N / 8, tracked);
+  report("leistd::vector<Tracked> (move)", base);
+  report("leistd::vector<Relocatable> (memmove)", bench_insert_erase<leistd::vector<Relocatable>>(N / 8, reloc), base);
+  return 0;
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <concepts>  // same_as
+#include <cstddef>  // size_t, max_align_t
+#include <cstdlib>  // malloc, realloc, free
+#include <new>      // bad_alloc
+
+namespace leistd {
+
+// 分配器可选扩展：T* reallocate(T* p, size_t old_n, size_t new_n)
+// 语义同 realloc：尽量原地扩展，否则搬到新块并按位复制内容；失败抛 bad_alloc 且 p 保持有效。
+// 容器只在元素可平凡重定位时才会调用它。
+template <typename Alloc>
+inline constexpr bool allocator_has_reallocate_v =
+    requires(Alloc& a, typename Alloc::value_type* p, std::size_t n) {
+      { a.reallocate(p, n, n) } -> std::same_as<typename Alloc::value_type*>;
+    };
+
+/*============ 基于 malloc 的分配器 ============*/
+// std::allocator 走 operator new，不能交给 realloc；需要原地扩容的大缓冲区改用这个分配器。
+// glibc 对 mmap 出来的大块（默认 >= 128KB）在 realloc 时用 mremap 重映射页表，不拷贝数据，
+// 也就不会出现“新旧两块同时驻留”的峰值内存。
+template <typename T>
+struct malloc_allocator {
+  static_assert(alignof(T) <= alignof(std::max_align_t), "malloc_allocator: over-aligned type");
+
+  using value_type = T;
+
+  malloc_allocator() noexcept = default;
+  template <typename U>
+  malloc_allocator(const malloc_allocator<U>&) noexcept {}
+
+  T* allocate(std::size_t n) {
+    void* p = std::malloc(n * sizeof(T));
+    if (!p && n) throw std::bad_alloc();
+    return static_cast<T*>(p);
+  }
+
+  void deallocate(T* p, std::size_t) noexcept {
+    std::free(p);
+  }
+
+  T* reallocate(T* p, std::size_t /*old_n*/, std::size_t new_n) {
+    void* q = std::realloc(p, new_n * sizeof(T));
+    if (!q && new_n) throw std::bad_alloc();
+    return static_cast<T*>(q);
+  }
+
+  template <typename U>
+  bool operator==(const malloc_allocator<U>&) const noexcept {
+    return true;
+  }
+};
+
+}  // namespace leistd
@@ -0,0 +1,183 @@
+#pragma once
+#include <algorithm>    // min, max
+#include <cstddef>      // size_t, max_align_t, byte
+#include <cstdint>      // uintptr_t
+#include <cstring>      // memcpy
+#include <new>          // operator new, bad_array_new_length
+#include <type_traits>  // false_type
+
+namespace leistd {
+
+/*============ 单调（bump pointer）内存池 ============*/
+// 分配只是把当前指针往后推；deallocate 基本是空操作，内存在 release() 或析构时整体归还，O(块数)。
+// - 当前块用完后向堆申请一个更大的新块（大小翻倍），各块串成单链表
+// - 可以给一块调用方提供的初始缓冲区（通常在栈上），先用它，用完才碰堆；release() 后回到这块缓冲区
+// - 释放或调整的恰好是最近一次分配时可以原地回退/扩展，容器的“分配新块-拷贝-释放旧块”扩容因此常常不用拷贝
+// 不是线程安全的；一个请求/一个线程一个 arena。
+class monotonic_arena {
+public:
+  static constexpr std::size_t default_block_size = 4096;
+
+  monotonic_arena() noexcept : monotonic_arena(default_block_size) {}
+
+  explicit monotonic_arena(std::size_t initial_block_size) noexcept
+      : _cur(nullptr), _end(nullptr), _blocks(nullptr), _initial_buf(nullptr), _initial_size(0),
+        _first_block_size(std::max(initial_block_size, min_block_size)), _next_block_size(_first_block_size) {}
+
+  // 先从 [buffer, buffer + size) 分配，这块内存由调用方持有，arena 不会释放它
+  monotonic_arena(void* buffer, std::size_t size) noexcept : monotonic_arena(std::max(size, default_block_size)) {
+    _initial_buf = static_cast<char*>(buffer);
+    _initial_size = size;
+    _cur = _initial_buf;
+    _end = _initial_buf + size;
+  }
+
+  monotonic_arena(const monotonic_arena&) = delete;
+  monotonic_arena& operator=(const monotonic_arena&) = delete;
+
+  ~monotonic_arena() { release(); }
+
+  void* allocate(std::size_t bytes, std::size_t align = alignof(std::max_align_t)) {
+    std::uintptr_t p = align_up(reinterpret_cast<std::uintptr_t>(_cur), align);
+    std::uintptr_t end = reinterpret_cast<std::uintptr_t>(_end);
+    // 不写成 p + bytes <= end：bytes 很大时加法会回绕
+    if (_cur && p <= end && bytes <= end - p) {
+      _cur = reinterpret_cast<char*>(p + bytes);
+      return reinterpret_cast<void*>(p);
+    }
+    return allocate_slow(bytes, align);
+  }
+
+  // 只有最近一次分配能被回退，其余情况什么也不做
+  void deallocate(void* p, std::size_t bytes) noexcept {
+    if (static_cast<char*>(p) + bytes == _cur) _cur = static_cast<char*>(p);
+  }
+
+  // 最近一次分配且当前块放得下时原地扩展/收缩，否则分配新空间并拷贝旧内容
+  void* reallocate(void* p, std::size_t old_bytes, std::size_t new_bytes,
+                   std::size_t align = alignof(std::max_align_t)) {
+    if (!p) return allocate(new_bytes, align);
+    char* q = static_cast<char*>(p);
+    if (q + old_bytes == _cur && new_bytes - std::min(new_bytes, old_bytes) <= std::size_t(_end - _cur)) {
+      _cur = q + new_bytes;
+      return p;
+    }
+    if (new_bytes <= old_bytes) return p;
+
+    void* fresh = allocate(new_bytes, align);
+    std::memcpy(fresh, p, old_bytes);
+    return fresh;
+  }
+
+  // 归还所有堆块，回到初始缓冲区（如果有）
+  void release() noexcept {
+    while (_blocks) {
+      block* prev = _blocks->prev;
+      ::operator delete(_blocks);
+      _blocks = prev;
+    }
+    _cur = _initial_buf;
+    _end = _initial_buf ? _initial_buf + _initial_size : nullptr;
+    _next_block_size = _first_block_size;
+  }
+
+  // 从堆申请的块数
+  std::size_t block_count() const noexcept {
+    std::size_t n = 0;
+    for (block* b = _blocks; b; b = b->prev) ++n;
+    return n;
+  }
+
+  // 当前块剩余的字节数
+  std::size_t remaining() const noexcept { return _end - _cur; }
+
+private:
+  struct alignas(std::max_align_t) block {
+    block* prev;
+  };
+
+  static constexpr std::size_t min_block_size = 256;
+
+  static std::uintptr_t align_up(std::uintptr_t p, std::size_t align) noexcept {
+    return (p + align - 1) & ~std::uintptr_t(align - 1);
+  }
+
+  void* allocate_slow(std::size_t bytes, std::size_t align) {
+    // 新块至少放得下这次请求（含对齐填充）；超大的请求单独占一块
+    std::size_t need = bytes + (align > alignof(std::max_align_t) ? align : 0);
+    if (need < bytes || need > std::size_t(-1) - sizeof(block)) throw std::bad_array_new_length();
+    std::size_t size = std::max(_next_block_size, need);
+    _next_block_size = std::max(_next_block_size, size) * 2;
+
+    block* b = static_cast<block*>(::operator new(sizeof(block) + size));
+    b->prev = _blocks;
+    _blocks = b;
+    _cur = reinterpret_cast<char*>(b + 1);
+    _end = _cur + size;
+
+    std::uintptr_t p = align_up(reinterpret_cast<std::uintptr_t>(_cur), align);
+    _cur = reinterpret_cast<char*>(p + bytes);
+    return reinterpret_cast<void*>(p);
+  }
+
+  char* _cur;
+  char* _end;
+  block* _blocks;  // 最新的堆块，prev 指向更早的块
+  char* _initial_buf;
+  std::size_t _initial_size;
+  std::size_t _first_block_size;
+  std::size_t _next_block_size;
+};
+
+// 自带 N 字节初始缓冲区的 arena，放在栈上时小请求完全不碰堆
+template <std::size_t N>
+class inline_arena : public monotonic_arena {
+public:
+  inline_arena() noexcept : monotonic_arena(_buf, N) {}
+
+private:
+  alignas(std::max_align_t) std::byte _buf[N];
+};
+
+/*============ arena 分配器 ============*/
+// 只保存 arena 指针。容器拷贝/移动/交换时分配器不跟着走（与 std::pmr 一致）：
+// 容器一直使用构造时给的 arena，不会因为一次赋值而引用另一个（可能更早销毁的）arena。
+template <typename T>
+class arena_allocator {
+public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::false_type;
+  using propagate_on_container_swap = std::false_type;
+  using is_always_equal = std::false_type;
+
+  arena_allocator(monotonic_arena& arena) noexcept : _arena(&arena) {}
+
+  template <typename U>
+  arena_allocator(const arena_allocator<U>& other) noexcept : _arena(other.arena()) {}
+
+  T* allocate(std::size_t n) {
+    if (n > std::size_t(-1) / sizeof(T)) throw std::bad_array_new_length();
+    return static_cast<T*>(_arena->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* p, std::size_t n) noexcept { _arena->deallocate(p, n * sizeof(T)); }
+
+  // 见 allocator_has_reallocate_v：vector/basic_string 扩容时优先原地扩展最近一次分配
+  T* reallocate(T* p, std::size_t old_n, std::size_t new_n) {
+    if (new_n > std::size_t(-1) / sizeof(T)) throw std::bad_array_new_length();
+    return static_cast<T*>(_arena->reallocate(p, old_n * sizeof(T), new_n * sizeof(T), alignof(T)));
+  }
+
+  monotonic_arena* arena() const noexcept { return _arena; }
+
+  template <typename U>
+  bool operator==(const arena_allocator<U>& other) const noexcept {
+    return _arena == other.arena();
+  }
+
+private:
+  monotonic_arena* _arena;
+};
+
+}  // namespace leistd
@@ -1,13 +1,108 @@
 #pragma once
 
+#include <bit>          // countr_zero, countl_zero, endian
 #include <cstddef>      // size_t
+#include <cstdint>      // uint64_t
+#include <cstring>      // memcmp, memset, memcpy
 #include <iterator>     // reverse_iterator
 #include <stdexcept>    // out_of_range
-#include <type_traits>  // integral_constant
-#include <utility>      // std::swap
+#include <type_traits>  // integral_constant, is_constant_evaluated
+#include <utility>      // std::swap, index_sequence
+
+#if defined(__GNUC__) && defined(__x86_64__)  // x86-64 上 SSE2 是基线指令集
+#include <emmintrin.h>
+#define LEISTD_ARRAY_SSE2 1
+#endif
 
 namespace leistd {
 
+/*============ 算术类型数组的比较 ============*/
+// 数组长度是编译期常量，下面的核心函数都以字节数或元素数为模板参数，小数组的循环会完全展开。
+// 只在运行期使用；编译期求值仍走逐元素的循环
+namespace array_detail {
+
+// 整数的对象表示和值一一对应，可以按字节比较是否相等、找第一个不同的位置
+template <typename T>
+inline constexpr bool bytewise_v = std::is_integral_v<T>;
+
+// 浮点数不能按字节比较（+0.0 == -0.0，NaN != NaN），用 SSE2 的浮点比较指令
+template <typename T>
+inline constexpr bool simd_float_v = std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+// 不超过 8 字节的比较：装进整数异或，第一个不同的字节在小端序下是最低的非零字节，大端序下是最高的
+template <std::size_t Bytes>
+std::size_t first_diff_word(const unsigned char* a, const unsigned char* b) noexcept {
+  std::uint64_t x = 0, y = 0;
+  std::memcpy(&x, a, Bytes);
+  std::memcpy(&y, b, Bytes);
+  std::uint64_t d = x ^ y;
+  if (d == 0) return Bytes;
+  if constexpr (std::endian::native == std::endian::little)
+    return static_cast<std::size_t>(std::countr_zero(d)) / 8;
+  else
+    return static_cast<std::size_t>(std::countl_zero(d)) / 8;
+}
+
+// 前 Bytes 个字节中第一个不同字节的偏移，全部相同时返回 Bytes
+template <std::size_t Bytes>
+std::size_t first_diff_byte(const unsigned char* a, const unsigned char* b) noexcept {
+#ifdef LEISTD_ARRAY_SSE2
+  if constexpr (Bytes >= 16) {
+    auto block = [&](std::size_t i) -> unsigned {
+      __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+      __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+      return ~static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y))) & 0xffffu;
+    };
+    std::size_t i = 0;
+    for (; i + 16 <= Bytes; i += 16) {
+      if (unsigned diff = block(i)) return i + static_cast<std::size_t>(__builtin_ctz(diff));
+    }
+    if constexpr (Bytes % 16 != 0) {
+      // 尾部用一次与前一块重叠的读取，重叠部分已知相同
+      if (unsigned diff = block(Bytes - 16)) return Bytes - 16 + static_cast<std::size_t>(__builtin_ctz(diff));
+    }
+    return Bytes;
+  } else
+#endif
+  {
+    std::size_t i = 0;
+    for (; i + 8 <= Bytes; i += 8) {
+      std::size_t k = first_diff_word<8>(a + i, b + i);
+      if (k != 8) return i + k;
+    }
+    if constexpr (Bytes % 8 != 0) return i + first_diff_word<Bytes % 8>(a + i, b + i);
+    return Bytes;
+  }
+}
+
+// 浮点数组中第一个“不相等”的下标，没有则返回 N。Ordered 为 true 时只认 a < b 或 b < a
+// （NaN 与任何数都不分先后，对应字典序比较），否则认 !(a == b)（对应 ==）
+template <bool Ordered, std::size_t N, typename T>
+std::size_t first_float_diff(const T* a, const T* b) noexcept {
+  std::size_t i = 0;
+#ifdef LEISTD_ARRAY_SSE2
+  if constexpr (std::is_same_v<T, float>) {
+    for (; i + 4 <= N; i += 4) {
+      __m128 x = _mm_loadu_ps(a + i), y = _mm_loadu_ps(b + i);
+      __m128 m = Ordered ? _mm_or_ps(_mm_cmplt_ps(x, y), _mm_cmpgt_ps(x, y)) : _mm_cmpneq_ps(x, y);
+      if (int mask = _mm_movemask_ps(m)) return i + static_cast<std::size_t>(__builtin_ctz(mask));
+    }
+  } else {
+    for (; i + 2 <= N; i += 2) {
+      __m128d x = _mm_loadu_pd(a + i), y = _mm_loadu_pd(b + i);
+      __m128d m = Ordered ? _mm_or_pd(_mm_cmplt_pd(x, y), _mm_cmpgt_pd(x, y)) : _mm_cmpneq_pd(x, y);
+      if (int mask = _mm_movemask_pd(m)) return i + static_cast<std::size_t>(__builtin_ctz(mask));
+    }
+  }
+#endif
+  for (; i < N; ++i) {
+    if (Ordered ? (a[i] < b[i] || b[i] < a[i]) : !(a[i] == b[i])) return i;
+  }
+  return N;
+}
+
+}  // namespace array_detail
+
 template <typename T, std::size_t N>
 class array {
 public:
@@ -71,13 +166,23 @@ public:
   constexpr const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
 
   // 修改器
-  void fill(const T& value) {
+  // 单字节算术类型在运行期直接 memset。其他类型先把 value 拷到局部变量：它可能就是本数组的元素，
+  // 不拷贝的话编译器要么按可能别名处理放弃向量化，要么多生成一份运行期检查
+  constexpr void fill(const T& value) {
+    if constexpr (std::is_arithmetic_v<T> && sizeof(T) == 1) {
+      if (!std::is_constant_evaluated()) {
+        std::memset(_elems, static_cast<unsigned char>(value), N);
+        return;
+      }
+    }
+    const T v = value;
     for (size_type i = 0; i < N; ++i) {
-      _elems[i] = value;
+      _elems[i] = v;
     }
   }
 
-  void swap(array& other) noexcept {
+  // 编译器已经会把这个循环向量化，手写 SIMD 在 bench_array 里没有稳定的收益
+  constexpr void swap(array& other) noexcept {
     for (size_type i = 0; i < N; ++i) {
       std::swap(_elems[i], other._elems[i]);
     }
@@ -89,13 +194,21 @@ private:
 
 // 全局 swap
 template <typename T, std::size_t N>
-void swap(array<T, N>& a, array<T, N>& b) noexcept {
+constexpr void swap(array<T, N>& a, array<T, N>& b) noexcept {
   a.swap(b);
 }
 
 // 关系运算符
+// 整数数组在运行期用 memcmp 判等、按字节找第一个不同的元素；float / double 用 SSE2 比较指令一次比较 16 字节。
+// 编译期求值和其他类型逐个元素比较
 template <typename T, std::size_t N>
 constexpr bool operator==(const array<T, N>& lhs, const array<T, N>& rhs) {
+  if (!std::is_constant_evaluated()) {
+    if constexpr (array_detail::bytewise_v<T>)
+      return N == 0 || std::memcmp(lhs.data(), rhs.data(), N * sizeof(T)) == 0;
+    else if constexpr (array_detail::simd_float_v<T>)
+      return array_detail::first_float_diff<false, N>(lhs.data(), rhs.data()) == N;
+  }
   for (std::size_t i = 0; i < N; ++i) {
     if (!(lhs[i] == rhs[i])) return false;
   }
@@ -109,6 +222,16 @@ constexpr bool operator!=(const array<T, N>& lhs, const array<T, N>& rhs) {
 
 template <typename T, std::size_t N>
 constexpr bool operator<(const array<T, N>& lhs, const array<T, N>& rhs) {
+  if (!std::is_constant_evaluated()) {
+    if constexpr (array_detail::bytewise_v<T>) {
+      std::size_t k = array_detail::first_diff_byte<N * sizeof(T)>(reinterpret_cast<const unsigned char*>(lhs.data()),
+                                                                   reinterpret_cast<const unsigned char*>(rhs.data()));
+      return k != N * sizeof(T) && lhs[k / sizeof(T)] < rhs[k / sizeof(T)];
+    } else if constexpr (array_detail::simd_float_v<T>) {
+      std::size_t i = array_detail::first_float_diff<true, N>(lhs.data(), rhs.data());
+      return i != N && lhs[i] < rhs[i];
+    }
+  }
   for (std::size_t i = 0; i < N; ++i) {
     if (lhs[i] < rhs[i]) return true;
     if (rhs[i] < lhs[i]) return false;
@@ -131,6 +254,68 @@ constexpr bool operator>=(const array<T, N>& lhs, const array<T, N>& rhs) {
   return !(lhs < rhs);
 }
 
+/*============ 逐元素运算 ============*/
+// 定长算术向量的加法、数乘和点积
+namespace array_detail {
+
+// 不超过这么多元素时在编译期完全展开：-O2 下 7 个 float 的 add 展开后快 5 倍。更长的数组交给编译器的
+// 循环向量化，展开成一长串语句反而妨碍它（array<float, 256> 的 add 全展开慢约 20%，uint8 慢一个数量级）
+inline constexpr std::size_t unroll_max = 16;
+
+// 对 [0, N) 的每个下标调用 f
+template <std::size_t N, typename F>
+constexpr void for_each_index(F&& f) {
+  if constexpr (N <= unroll_max) {
+    [&]<std::size_t... I>(std::index_sequence<I...>) { (f(I), ...); }(std::make_index_sequence<N>());
+  } else {
+    for (std::size_t i = 0; i < N; ++i) f(i);
+  }
+}
+
+}  // namespace array_detail
+
+template <typename T, std::size_t N>
+  requires std::is_arithmetic_v<T>
+constexpr array<T, N> add(const array<T, N>& a, const array<T, N>& b) noexcept {
+  array<T, N> r;  // 下面会写满每个元素，不做值初始化
+  array_detail::for_each_index<N>([&](std::size_t i) { r[i] = a[i] + b[i]; });
+  return r;
+}
+
+template <typename T, std::size_t N>
+  requires std::is_arithmetic_v<T>
+constexpr array<T, N> scale(const array<T, N>& a, T s) noexcept {
+  array<T, N> r;  // 下面会写满每个元素，不做值初始化
+  array_detail::for_each_index<N>([&](std::size_t i) { r[i] = a[i] * s; });
+  return r;
+}
+
+// 逐个累加时每次加法都依赖上一次，浮点数又不能重新结合，编译器只能串行地做。浮点数分出两个 SSE 寄存器宽的
+// 独立累加器，整块乘加可以向量化，最后两两归约；求和顺序因此与逐个累加不同，结果可能差在最后几位。
+// 累加器再多反而不划算：bench_array 中按一条缓存行分累加器时，16 个 float 的点积比逐个累加还慢。
+// 整数加法可以重新结合，编译器自己会向量化
+template <typename T, std::size_t N>
+  requires std::is_arithmetic_v<T>
+constexpr T dot(const array<T, N>& a, const array<T, N>& b) noexcept {
+  if constexpr (std::is_floating_point_v<T>) {
+    constexpr std::size_t lanes = 32 / sizeof(T);
+    T acc[lanes] = {};
+    std::size_t base = 0;
+    for (; base + lanes <= N; base += lanes) {
+      for (std::size_t k = 0; k < lanes; ++k) acc[k] += a[base + k] * b[base + k];
+    }
+    array_detail::for_each_index<N % lanes>([&](std::size_t k) { acc[k] += a[base + k] * b[base + k]; });
+    for (std::size_t w = lanes / 2; w > 0; w /= 2) {  // 两两相加归约，依赖链只有 log2(lanes) 次加法
+      for (std::size_t k = 0; k < w; ++k) acc[k] += acc[k + w];
+    }
+    return acc[0];
+  } else {
+    T sum = T();
+    array_detail::for_each_index<N>([&](std::size_t i) { sum += a[i] * b[i]; });
+    return sum;
+  }
+}
+
 }  // namespace leistd
 
 // tuple_size / tuple_element 特化，支持结构化绑定
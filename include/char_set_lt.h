@@ -0,0 +1,170 @@
+#pragma once
+#include <cstddef>  // size_t
+#include <cstdint>  // uint8_t, uint64_t
+#include <cstring>  // memchr
+
+#include "string_search_lt.h"  // search_npos, LEISTD_X86_SIMD
+
+namespace leistd {
+
+/*============ 窄字符集合分类引擎 ============*/
+// find_first_of / find_first_not_of / find_last_of / find_last_not_of 共用。
+// 构造时把字符集合编码成两种形式：
+// - 256 位位图：标量路径每个字符一次查表，O(n) 而不是 O(n·k)
+// - 按低 4 位索引的两张 16 字节表（高 4 位为 0-7 / 8-15 各一张，每字节 8 个 bit 对应高 4 位的取值），
+//   SSSE3/AVX2 下用 pshufb 一次分类 16/32 个字符，对任意大小的集合代价都一样
+class char_set {
+public:
+  char_set(const char* chars, std::size_t k)
+      : _bits{}, _lo_0_7{}, _lo_8_15{}, _single(k == 1), _first(k ? chars[0] : 0) {
+    for (std::size_t i = 0; i < k; ++i) {
+      unsigned char c = static_cast<unsigned char>(chars[i]);
+      _bits[c >> 6] |= std::uint64_t(1) << (c & 63);
+      unsigned lo = c & 0x0f, hi = c >> 4;
+      if (hi < 8)
+        _lo_0_7[lo] |= std::uint8_t(1u << hi);
+      else
+        _lo_8_15[lo] |= std::uint8_t(1u << (hi - 8));
+    }
+  }
+
+  bool contains(unsigned char c) const noexcept { return (_bits[c >> 6] >> (c & 63)) & 1; }
+
+  // 在 s[0, n) 中找第一个属于（negate 时为不属于）集合的字符
+  std::size_t find_first(const char* s, std::size_t n, bool negate) const {
+    if (_single && !negate) {
+      const void* hit = std::memchr(s, _first, n);
+      return hit ? static_cast<const char*>(hit) - s : search_npos;
+    }
+    return impls().first(*this, s, n, negate);
+  }
+
+  // 在 s[0, n) 中找最后一个属于（negate 时为不属于）集合的字符
+  std::size_t find_last(const char* s, std::size_t n, bool negate) const { return impls().last(*this, s, n, negate); }
+
+  /*---- 各内核，供基准测试直接调用 ----*/
+  static std::size_t find_first_scalar(const char_set& set, const char* s, std::size_t n, bool negate) {
+    for (std::size_t i = 0; i < n; ++i)
+      if (set.contains(static_cast<unsigned char>(s[i])) != negate) return i;
+    return search_npos;
+  }
+
+  static std::size_t find_last_scalar(const char_set& set, const char* s, std::size_t n, bool negate) {
+    for (std::size_t i = n; i-- > 0;)
+      if (set.contains(static_cast<unsigned char>(s[i])) != negate) return i;
+    return search_npos;
+  }
+
+#ifdef LEISTD_X86_SIMD
+  __attribute__((target("ssse3"))) static std::size_t find_first_ssse3(const char_set& set, const char* s,
+                                                                       std::size_t n, bool negate) {
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+      unsigned mask = set.classify16(s + i) ^ (negate ? 0xffffu : 0u);
+      if (mask) return i + __builtin_ctz(mask);
+    }
+    std::size_t r = find_first_scalar(set, s + i, n - i, negate);
+    return r == search_npos ? r : i + r;
+  }
+
+  __attribute__((target("ssse3"))) static std::size_t find_last_ssse3(const char_set& set, const char* s,
+                                                                      std::size_t n, bool negate) {
+    std::size_t i = n;
+    for (; i >= 16; i -= 16) {
+      unsigned mask = set.classify16(s + i - 16) ^ (negate ? 0xffffu : 0u);
+      if (mask) return i - 16 + (31 - __builtin_clz(mask));
+    }
+    return find_last_scalar(set, s, i, negate);
+  }
+
+  __attribute__((target("avx2"))) static std::size_t find_first_avx2(const char_set& set, const char* s,
+                                                                     std::size_t n, bool negate) {
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+      unsigned mask = set.classify32(s + i) ^ (negate ? 0xffffffffu : 0u);
+      if (mask) return i + __builtin_ctz(mask);
+    }
+    std::size_t r = find_first_ssse3(set, s + i, n - i, negate);
+    return r == search_npos ? r : i + r;
+  }
+
+  __attribute__((target("avx2"))) static std::size_t find_last_avx2(const char_set& set, const char* s,
+                                                                    std::size_t n, bool negate) {
+    std::size_t i = n;
+    for (; i >= 32; i -= 32) {
+      unsigned mask = set.classify32(s + i - 32) ^ (negate ? 0xffffffffu : 0u);
+      if (mask) return i - 32 + (31 - __builtin_clz(mask));
+    }
+    return find_last_ssse3(set, s, i, negate);
+  }
+#endif
+
+private:
+  using find_fn = std::size_t (*)(const char_set&, const char*, std::size_t, bool);
+  struct kernels {
+    find_fn first;
+    find_fn last;
+  };
+
+  static const kernels& impls() {
+    static const kernels k = [] {
+#ifdef LEISTD_X86_SIMD
+      __builtin_cpu_init();
+      if (__builtin_cpu_supports("avx2")) return kernels{find_first_avx2, find_last_avx2};
+      if (__builtin_cpu_supports("ssse3")) return kernels{find_first_ssse3, find_last_ssse3};
+#endif
+      return kernels{find_first_scalar, find_last_scalar};
+    }();
+    return k;
+  }
+
+#ifdef LEISTD_X86_SIMD
+  // 返回 16 个字符的命中位掩码（bit i 对应 p[i]）
+  __attribute__((target("ssse3"))) unsigned classify16(const char* p) const {
+    const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    const __m128i nibble = _mm_set1_epi8(0x0f);
+    const __m128i lo = _mm_and_si128(input, nibble);
+    const __m128i hi = _mm_and_si128(_mm_srli_epi16(input, 4), nibble);
+
+    const __m128i row_0_7 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(_lo_0_7)), lo);
+    const __m128i row_8_15 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(_lo_8_15)), lo);
+    const __m128i hi_lt_8 = _mm_cmplt_epi8(hi, _mm_set1_epi8(8));
+    const __m128i row = _mm_or_si128(_mm_and_si128(hi_lt_8, row_0_7), _mm_andnot_si128(hi_lt_8, row_8_15));
+
+    // 1 << (hi & 7)
+    const __m128i bit_of = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    const __m128i bit = _mm_shuffle_epi8(bit_of, hi);
+    const __m128i hit = _mm_cmpeq_epi8(_mm_and_si128(row, bit), bit);
+    return static_cast<unsigned>(_mm_movemask_epi8(hit));
+  }
+
+  __attribute__((target("avx2"))) unsigned classify32(const char* p) const {
+    const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+    const __m256i lo = _mm256_and_si256(input, nibble);
+    const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble);
+
+    // vpshufb 只在 128 位通道内查表，两个通道各放一份
+    const __m256i tbl_0_7 = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(_lo_0_7)));
+    const __m256i tbl_8_15 = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(_lo_8_15)));
+    const __m256i row_0_7 = _mm256_shuffle_epi8(tbl_0_7, lo);
+    const __m256i row_8_15 = _mm256_shuffle_epi8(tbl_8_15, lo);
+    const __m256i hi_lt_8 = _mm256_cmpgt_epi8(_mm256_set1_epi8(8), hi);
+    const __m256i row = _mm256_blendv_epi8(row_8_15, row_0_7, hi_lt_8);
+
+    const __m256i bit_of = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16,
+                                            32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    const __m256i bit = _mm256_shuffle_epi8(bit_of, hi);
+    const __m256i hit = _mm256_cmpeq_epi8(_mm256_and_si256(row, bit), bit);
+    return static_cast<unsigned>(_mm256_movemask_epi8(hit));
+  }
+#endif
+
+  std::uint64_t _bits[4];
+  alignas(16) std::uint8_t _lo_0_7[16];
+  alignas(16) std::uint8_t _lo_8_15[16];
+  bool _single;  // 只有一个字符时 find_first 直接用 memchr
+  char _first;
+};
+
+}  // namespace leistd
@@ -0,0 +1,191 @@
+#pragma once
+#include <cstddef>  // size_t
+#include <cstdint>  // uintptr_t
+#include <cstring>  // strlen, memchr, memcmp, memset, memcpy, memmove
+
+#if defined(__GNUC__) && defined(__x86_64__)  // x86-64 上 SSE2 是基线指令集
+#include <emmintrin.h>
+#define LEISTD_CHAR_TRAITS_SSE2 1
+#endif
+
+namespace leistd {
+
+/*============ 通用实现 ============*/
+// 逐个字符处理，任何字符类型都能用；常用字符类型在下面特化成 libc / SIMD 版本
+template <typename CharT>
+struct char_traits_base {
+  using char_type = CharT;
+
+  static void assign(CharT& c1, const CharT& c2) {
+    c1 = c2;
+  }
+
+  static bool eq(CharT c1, CharT c2) {
+    return c1 == c2;
+  }
+
+  static bool lt(CharT c1, CharT c2) {
+    return c1 < c2;
+  }
+
+  static std::size_t length(const CharT* s) {
+    std::size_t len = 0;
+    while (!eq(s[len], CharT()))
+      ++len;
+    return len;
+  }
+
+  static int compare(const CharT* s1, const CharT* s2, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+      if (lt(s1[i], s2[i]))
+        return -1;
+      if (lt(s2[i], s1[i]))
+        return 1;
+    }
+    return 0;
+  }
+
+  static const CharT* find(const CharT* s, std::size_t n, const CharT& ch) {
+    for (std::size_t i = 0; i < n; ++i)
+      if (eq(s[i], ch))
+        return s + i;
+    return nullptr;
+  }
+
+  static CharT* assign(CharT* s, std::size_t n, CharT ch) {
+    for (std::size_t i = 0; i < n; ++i)
+      s[i] = ch;
+    return s;
+  }
+
+  static CharT* copy(CharT* dest, const CharT* src, std::size_t n) {
+    return static_cast<CharT*>(std::memcpy(dest, src, n * sizeof(CharT)));
+  }
+
+  static CharT* move(CharT* dest, const CharT* src, std::size_t n) {
+    return static_cast<CharT*>(std::memmove(dest, src, n * sizeof(CharT)));
+  }
+};
+
+template <typename CharT>
+struct char_traits : char_traits_base<CharT> {};
+
+/*============ 单字节字符：直接交给 libc ============*/
+// glibc 的 strlen/memchr/memcmp/memset 本身就是按 CPU 分派的 SIMD 实现
+template <typename CharT>
+struct byte_char_traits : char_traits_base<CharT> {
+  using char_traits_base<CharT>::assign;
+
+  static std::size_t length(const CharT* s) {
+    return std::strlen(reinterpret_cast<const char*>(s));
+  }
+
+  // 按 unsigned char 比较，与 std::char_traits 一致
+  static int compare(const CharT* s1, const CharT* s2, std::size_t n) {
+    return n ? std::memcmp(s1, s2, n) : 0;
+  }
+
+  static const CharT* find(const CharT* s, std::size_t n, const CharT& ch) {
+    return n ? static_cast<const CharT*>(std::memchr(s, static_cast<unsigned char>(ch), n)) : nullptr;
+  }
+
+  static CharT* assign(CharT* s, std::size_t n, CharT ch) {
+    if (n)
+      std::memset(s, static_cast<unsigned char>(ch), n);
+    return s;
+  }
+};
+
+template <>
+struct char_traits<char> : byte_char_traits<char> {};
+
+#ifdef __cpp_char8_t
+template <>
+struct char_traits<char8_t> : byte_char_traits<char8_t> {};
+#endif
+
+/*============ 多字节字符：SSE2 一次处理 16 字节 ============*/
+template <typename CharT>
+struct wide_char_traits : char_traits_base<CharT> {
+  using base = char_traits_base<CharT>;
+  using base::assign;
+  static_assert(sizeof(CharT) == 2 || sizeof(CharT) == 4);
+
+#ifdef LEISTD_CHAR_TRAITS_SSE2
+  static constexpr std::size_t lanes = 16 / sizeof(CharT);
+
+  static __m128i cmpeq(__m128i a, __m128i b) {
+    if constexpr (sizeof(CharT) == 2)
+      return _mm_cmpeq_epi16(a, b);
+    else
+      return _mm_cmpeq_epi32(a, b);
+  }
+
+  static __m128i splat(CharT ch) {
+    if constexpr (sizeof(CharT) == 2)
+      return _mm_set1_epi16(static_cast<short>(ch));
+    else
+      return _mm_set1_epi32(static_cast<int>(ch));
+  }
+
+  // 只做 16 字节对齐的读取：对齐块不会跨页，读到终止符后面的字节也不会越过可访问的页。
+  // 这部分越界读对 ASan 来说是误报，因此关掉插桩。
+  __attribute__((no_sanitize_address)) static std::size_t length(const CharT* s) {
+    std::uintptr_t addr = reinterpret_cast<std::uintptr_t>(s);
+    const char* block = reinterpret_cast<const char*>(addr & ~std::uintptr_t(15));
+    const __m128i zero = _mm_setzero_si128();
+
+    unsigned mask = _mm_movemask_epi8(cmpeq(_mm_load_si128(reinterpret_cast<const __m128i*>(block)), zero));
+    mask &= ~0u << (addr & 15);  // 去掉 s 之前的字节
+    while (!mask) {
+      block += 16;
+      mask = _mm_movemask_epi8(cmpeq(_mm_load_si128(reinterpret_cast<const __m128i*>(block)), zero));
+    }
+    const char* hit = block + __builtin_ctz(mask);
+    return (hit - reinterpret_cast<const char*>(s)) / sizeof(CharT);
+  }
+
+  static int compare(const CharT* s1, const CharT* s2, std::size_t n) {
+    std::size_t i = 0;
+    for (; i + lanes <= n; i += lanes) {
+      __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s1 + i));
+      __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s2 + i));
+      unsigned diff = ~_mm_movemask_epi8(cmpeq(a, b)) & 0xffffu;
+      if (diff) {
+        std::size_t k = i + __builtin_ctz(diff) / sizeof(CharT);
+        return base::lt(s1[k], s2[k]) ? -1 : 1;
+      }
+    }
+    return base::compare(s1 + i, s2 + i, n - i);
+  }
+
+  static const CharT* find(const CharT* s, std::size_t n, const CharT& ch) {
+    const __m128i needle = splat(ch);
+    std::size_t i = 0;
+    for (; i + lanes <= n; i += lanes) {
+      __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+      unsigned mask = _mm_movemask_epi8(cmpeq(block, needle));
+      if (mask)
+        return s + i + __builtin_ctz(mask) / sizeof(CharT);
+    }
+    return base::find(s + i, n - i, ch);
+  }
+
+  static CharT* assign(CharT* s, std::size_t n, CharT ch) {
+    const __m128i fill = splat(ch);
+    std::size_t i = 0;
+    for (; i + lanes <= n; i += lanes)
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(s + i), fill);
+    base::assign(s + i, n - i, ch);
+    return s;
+  }
+#endif
+};
+
+template <>
+struct char_traits<char16_t> : wide_char_traits<char16_t> {};
+
+template <>
+struct char_traits<char32_t> : wide_char_traits<char32_t> {};
+
+}  // namespace leistd
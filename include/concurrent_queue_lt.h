@@ -0,0 +1,599 @@
+#pragma once
+#include <algorithm>  // min
+#include <atomic>
+#include <cstddef>  // size_t
+#include <memory>   // allocator_traits
+#include <mutex>
+#include <new>        // launder
+#include <stdexcept>  // length_error
+#include <thread>     // this_thread::yield
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "intrusive_list_lt.h"   // intrusive_detail::owner_of
+#include "pool_allocator_lt.h"  // shared_pool_allocator
+
+namespace leistd {
+
+// 按 64 字节对齐隔开不同线程频繁写的变量，避免伪共享。
+// 不用 std::hardware_destructive_interference_size：它随编译选项变化，GCC 还会为此告警
+inline constexpr std::size_t cache_line_size = 64;
+
+namespace concurrent_detail {
+
+// 忙等中的退让：先自旋几轮，仍未就绪再让出时间片（核数少于线程数时尤其重要）
+class backoff {
+public:
+  void pause() noexcept {
+    if (_M_count < 16) {
+      ++_M_count;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+
+private:
+  unsigned _M_count = 0;
+};
+
+inline std::size_t round_up_power_of_two(std::size_t n) {
+  std::size_t r = 1;
+  while (r < n) r <<= 1;
+  return r;
+}
+
+}  // namespace concurrent_detail
+
+/*============ 侵入式 MPSC 队列（Vyukov） ============*/
+// 任意多个生产者、一个消费者。入队是一次 exchange 加一次 store，不循环、不分配；
+// 出队只由消费者线程调用，没有原子读改写。节点就是元素里内嵌的 mpsc_hook，
+// 元素在队列里时由调用方保证其存活，出队后钩子不再被队列引用。
+//
+// 队列内部有一个哑节点 _M_stub，链表永不为空：
+//   _M_head（生产者端，原子） -> ... 最后入队的节点
+//   _M_tail（消费者端，普通指针） -> 最早入队、还没取走的节点
+// 生产者先 exchange 抢到前驱，再把前驱的 next 指向自己；两步之间链表是“断开”的，
+// 此时消费者看不到后面的节点，try_pop 返回 nullptr，稍后重试即可。
+class mpsc_hook {
+public:
+  mpsc_hook() noexcept = default;
+  mpsc_hook(const mpsc_hook&) noexcept {}  // 钩子不随对象拷贝
+  mpsc_hook& operator=(const mpsc_hook&) noexcept { return *this; }
+
+private:
+  template <typename, auto>
+  friend class intrusive_mpsc_queue;
+
+  std::atomic<mpsc_hook*> _M_next{nullptr};
+};
+
+template <typename T, auto Member>
+class intrusive_mpsc_queue {
+  static_assert(std::is_same_v<std::remove_cvref_t<decltype(std::declval<T&>().*Member)>, mpsc_hook>,
+                "Member must be a pointer to a mpsc_hook member of T");
+
+public:
+  using value_type = T;
+
+  intrusive_mpsc_queue() noexcept : _M_head(&_M_stub), _M_tail(&_M_stub) {}
+  intrusive_mpsc_queue(const intrusive_mpsc_queue&) = delete;
+  intrusive_mpsc_queue& operator=(const intrusive_mpsc_queue&) = delete;
+
+  // 任意线程
+  void push(T& value) noexcept { _M_push(&(value.*Member)); }
+
+  // 仅消费者线程；队列为空（或生产者正处于两步之间）时返回 nullptr
+  T* try_pop() noexcept {
+    mpsc_hook* tail = _M_tail;
+    mpsc_hook* next = tail->_M_next.load(std::memory_order_acquire);
+    if (tail == &_M_stub) {  // 跳过哑节点
+      if (!next) return nullptr;
+      _M_tail = tail = next;
+      next = next->_M_next.load(std::memory_order_acquire);
+    }
+    if (next) {
+      _M_tail = next;
+      return _S_to_value(tail);
+    }
+    // tail 是目前的最后一个节点。要取走它，先把哑节点重新挂到末尾，让链表保持非空
+    if (tail != _M_head.load(std::memory_order_acquire)) return nullptr;  // 有生产者正在挂入
+    _M_push(&_M_stub);
+    next = tail->_M_next.load(std::memory_order_acquire);
+    if (!next) return nullptr;  // 哑节点前面又插进了别的生产者，下一次再取
+    _M_tail = next;
+    return _S_to_value(tail);
+  }
+
+  // 仅消费者线程；近似值：返回 false 时可能有生产者刚好在入队
+  bool empty() const noexcept {
+    return _M_tail == &_M_stub && !_M_stub._M_next.load(std::memory_order_acquire);
+  }
+
+private:
+  void _M_push(mpsc_hook* n) noexcept {
+    n->_M_next.store(nullptr, std::memory_order_relaxed);
+    mpsc_hook* prev = _M_head.exchange(n, std::memory_order_acq_rel);
+    prev->_M_next.store(n, std::memory_order_release);
+  }
+
+  static T* _S_to_value(mpsc_hook* h) noexcept { return intrusive_detail::owner_of<T, Member>(h); }
+
+  alignas(cache_line_size) std::atomic<mpsc_hook*> _M_head;  // 生产者争用
+  alignas(cache_line_size) mpsc_hook* _M_tail;               // 只有消费者读写
+  mpsc_hook _M_stub;
+};
+
+/*============ MPSC 队列 ============*/
+// intrusive_mpsc_queue 的值语义包装：每个元素放在一个节点里，节点从分配器取。
+// 默认用 shared_pool_allocator：生产者线程分配、消费者线程释放，
+// 节点经线程本地缓存成批回到中心池，稳态下入队出队都不碰全局堆。
+template <typename T, typename Alloc = shared_pool_allocator<T>>
+class mpsc_queue {
+  struct node {
+    template <typename... Args>
+    explicit node(Args&&... args) : value(std::forward<Args>(args)...) {}
+    T value;
+    mpsc_hook hook;
+  };
+  using node_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<node>;
+  using node_traits = std::allocator_traits<node_allocator>;
+
+public:
+  using value_type = T;
+  using allocator_type = Alloc;
+
+  mpsc_queue() = default;
+  explicit mpsc_queue(const Alloc& alloc) : _M_alloc(alloc) {}
+  mpsc_queue(const mpsc_queue&) = delete;
+  mpsc_queue& operator=(const mpsc_queue&) = delete;
+  ~mpsc_queue() {
+    while (node* n = _M_queue.try_pop()) _M_drop(n);
+  }
+
+  // 任意线程
+  void push(const T& value) { emplace(value); }
+  void push(T&& value) { emplace(std::move(value)); }
+
+  template <typename... Args>
+  void emplace(Args&&... args) {
+    node* n = node_traits::allocate(_M_alloc, 1);
+    try {
+      node_traits::construct(_M_alloc, n, std::forward<Args>(args)...);
+    } catch (...) {
+      node_traits::deallocate(_M_alloc, n, 1);
+      throw;
+    }
+    _M_queue.push(*n);
+  }
+
+  // 仅消费者线程
+  bool try_pop(T& out) {
+    node* n = _M_queue.try_pop();
+    if (!n) return false;
+    try {
+      out = std::move(n->value);
+    } catch (...) {
+      _M_drop(n);
+      throw;
+    }
+    _M_drop(n);
+    return true;
+  }
+
+  bool empty() const noexcept { return _M_queue.empty(); }
+
+private:
+  void _M_drop(node* n) noexcept {
+    node_traits::destroy(_M_alloc, n);
+    node_traits::deallocate(_M_alloc, n, 1);
+  }
+
+  [[no_unique_address]] node_allocator _M_alloc;
+  intrusive_mpsc_queue<node, &node::hook> _M_queue;
+};
+
+/*============ 有界 MPMC 环形队列（Vyukov） ============*/
+// 容量固定（向上取 2 的幂），构造时一次分配全部槽位，之后不再分配。
+// 每个槽位带一个序号：
+//   seq == pos      槽位空闲，等待第 pos 次入队
+//   seq == pos + 1  已写入第 pos 个元素，等待出队
+// 出队后 seq 置为 pos + capacity，即下一圈的入队序号。
+// 入队/出队各自用 CAS 抢位置计数，抢到后只写自己的槽位，不同槽位之间互不干扰。
+// 满时 try_push 返回 false，空时 try_pop 返回 false，都不阻塞。
+template <typename T, typename Alloc = std::allocator<T>>
+class mpmc_ring_queue {
+  struct cell {
+    std::atomic<std::size_t> seq;
+    alignas(T) unsigned char storage[sizeof(T)];
+
+    T* ptr() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+  };
+  using cell_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<cell>;
+  using cell_traits = std::allocator_traits<cell_allocator>;
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using allocator_type = Alloc;
+
+  explicit mpmc_ring_queue(size_type capacity, const Alloc& alloc = Alloc())
+      : _M_alloc(alloc), _M_mask(concurrent_detail::round_up_power_of_two(capacity < 2 ? 2 : capacity) - 1) {
+    _M_cells = cell_traits::allocate(_M_alloc, _M_mask + 1);
+    for (size_type i = 0; i <= _M_mask; ++i) ::new (static_cast<void*>(_M_cells + i)) cell{{i}, {}};
+  }
+  mpmc_ring_queue(const mpmc_ring_queue&) = delete;
+  mpmc_ring_queue& operator=(const mpmc_ring_queue&) = delete;
+
+  ~mpmc_ring_queue() {
+    // 没有其他线程在访问，剩下的元素就在 [dequeue, enqueue) 里
+    size_type end = _M_enqueue.load(std::memory_order_relaxed);
+    for (size_type pos = _M_dequeue.load(std::memory_order_relaxed); pos != end; ++pos)
+      std::destroy_at(_M_cells[pos & _M_mask].ptr());
+    for (size_type i = 0; i <= _M_mask; ++i) std::destroy_at(_M_cells + i);
+    cell_traits::deallocate(_M_alloc, _M_cells, _M_mask + 1);
+  }
+
+  bool try_push(const T& value) { return try_emplace(value); }
+  bool try_push(T&& value) { return try_emplace(std::move(value)); }
+
+  // 抢到槽位后就不能反悔，所以可能抛异常的构造先在槽位外完成，再不抛异常地移进槽位
+  template <typename... Args>
+  bool try_emplace(Args&&... args) {
+    if constexpr (std::is_nothrow_constructible_v<T, Args&&...>) {
+      return _M_emplace(std::forward<Args>(args)...);
+    } else {
+      static_assert(std::is_nothrow_move_constructible_v<T>, "mpmc_ring_queue requires a nothrow move constructor");
+      return _M_emplace(T(std::forward<Args>(args)...));
+    }
+  }
+
+  bool try_pop(T& out) {
+    size_type pos = _M_dequeue.load(std::memory_order_relaxed);
+    cell* c;
+    for (;;) {
+      c = &_M_cells[pos & _M_mask];
+      size_type seq = c->seq.load(std::memory_order_acquire);
+      auto diff = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+      if (diff == 0) {
+        if (_M_dequeue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+      } else if (diff < 0) {
+        return false;  // 空
+      } else {
+        pos = _M_dequeue.load(std::memory_order_relaxed);
+      }
+    }
+    // 移动赋值抛异常时元素丢弃，但槽位照常释放，队列保持可用
+    struct release_guard {
+      cell* c;
+      size_type next_seq;
+      ~release_guard() {
+        std::destroy_at(c->ptr());
+        c->seq.store(next_seq, std::memory_order_release);
+      }
+    } guard{c, pos + _M_mask + 1};
+    out = std::move(*c->ptr());
+    return true;
+  }
+
+  size_type capacity() const noexcept { return _M_mask + 1; }
+
+  // 近似值，仅供监控
+  size_type size_approx() const noexcept {
+    size_type e = _M_enqueue.load(std::memory_order_relaxed);
+    size_type d = _M_dequeue.load(std::memory_order_relaxed);
+    return e > d ? e - d : 0;
+  }
+
+private:
+  template <typename... Args>
+  bool _M_emplace(Args&&... args) noexcept {
+    size_type pos = _M_enqueue.load(std::memory_order_relaxed);
+    cell* c;
+    for (;;) {
+      c = &_M_cells[pos & _M_mask];
+      size_type seq = c->seq.load(std::memory_order_acquire);
+      auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+      if (diff == 0) {
+        if (_M_enqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+      } else if (diff < 0) {
+        return false;  // 槽位还没被上一圈的出队释放：满
+      } else {
+        pos = _M_enqueue.load(std::memory_order_relaxed);  // 被别的生产者抢先
+      }
+    }
+    ::new (static_cast<void*>(c->storage)) T(std::forward<Args>(args)...);
+    c->seq.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  [[no_unique_address]] cell_allocator _M_alloc;
+  size_type _M_mask;
+  cell* _M_cells;
+  alignas(cache_line_size) std::atomic<size_type> _M_enqueue{0};
+  alignas(cache_line_size) std::atomic<size_type> _M_dequeue{0};
+};
+
+/*============ 风险指针 ============*/
+// 分段队列回收段时用：线程在解引用一个可能被回收的段之前，先把段地址登记到自己的槽位；
+// 回收方扫描所有槽位，被登记的段暂不回收。进程内所有队列共用一张槽位表，
+// 每个线程第一次使用时占一个槽位，线程退出时归还。
+namespace concurrent_detail {
+
+inline constexpr std::size_t max_hazard_threads = 256;
+
+struct alignas(cache_line_size) hazard_slot {
+  std::atomic<const void*> ptr{nullptr};
+  std::atomic<bool> owned{false};
+};
+
+inline hazard_slot g_hazard_slots[max_hazard_threads];
+
+class hazard_owner {
+public:
+  hazard_owner() {
+    for (auto& s : g_hazard_slots) {
+      bool expected = false;
+      if (!s.owned.load(std::memory_order_relaxed) &&
+          s.owned.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+        _M_slot = &s;
+        return;
+      }
+    }
+    throw std::length_error("leistd: too many threads using concurrent queues");
+  }
+  hazard_owner(const hazard_owner&) = delete;
+  hazard_owner& operator=(const hazard_owner&) = delete;
+  ~hazard_owner() {
+    _M_slot->ptr.store(nullptr, std::memory_order_release);
+    _M_slot->owned.store(false, std::memory_order_release);
+  }
+
+  hazard_slot& slot() noexcept { return *_M_slot; }
+
+private:
+  hazard_slot* _M_slot;
+};
+
+inline hazard_slot& local_hazard() {
+  thread_local hazard_owner owner;
+  return owner.slot();
+}
+
+// 读出 src 并登记；登记后再读一次确认 src 没变，此后该指针在清除登记前不会被回收
+template <typename P>
+P* protect(const std::atomic<P*>& src, hazard_slot& slot) noexcept {
+  P* p = src.load(std::memory_order_acquire);
+  for (;;) {
+    slot.ptr.store(p, std::memory_order_seq_cst);
+    P* q = src.load(std::memory_order_seq_cst);
+    if (p == q) return p;
+    p = q;
+  }
+}
+
+inline bool is_hazardous(const void* p) noexcept {
+  for (auto& s : g_hazard_slots)
+    if (s.ptr.load(std::memory_order_seq_cst) == p) return true;
+  return false;
+}
+
+// 作用域结束时清除本线程的登记
+struct hazard_guard {
+  hazard_slot& slot;
+  ~hazard_guard() { slot.ptr.store(nullptr, std::memory_order_release); }
+};
+
+}  // namespace concurrent_detail
+
+/*============ 无界分段 MPMC 队列 ============*/
+// 一串定长的段，每段 SegmentSize 个槽位，只用一次（不循环）。
+// 入队：fetch_add 段内入队计数拿到槽位下标，写入元素；段用完就挂上新段、推进 _M_tail。
+// 出队：fetch_add 段内出队计数拿到槽位下标，取走元素；段取完就推进 _M_head，旧段回收。
+// 出队方抢到的槽位若生产者还没开始写（只拿到了下标），就把槽位作废，双方各自换下一个槽位；
+// 若生产者正在构造元素，出队方等待构造完成。
+//
+// 回收下来的段先放进退休表，扫描风险指针确认没有线程还在访问后，重置放进空闲表，
+// 下次扩容直接复用，不再分配。段的分配、回收只在每 SegmentSize 次操作中发生一次，用一把锁保护。
+template <typename T, std::size_t SegmentSize = 1024, typename Alloc = std::allocator<T>>
+class segmented_mpmc_queue {
+  static_assert(SegmentSize >= 2, "SegmentSize must be at least 2");
+
+  enum cell_state : unsigned char { _S_empty, _S_writing, _S_ready, _S_abandoned };
+
+  struct cell {
+    std::atomic<unsigned char> state{_S_empty};
+    alignas(T) unsigned char storage[sizeof(T)];
+
+    T* ptr() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+  };
+
+  struct segment {
+    alignas(cache_line_size) std::atomic<std::size_t> enqueue{0};
+    alignas(cache_line_size) std::atomic<std::size_t> dequeue{0};
+    alignas(cache_line_size) std::atomic<segment*> next{nullptr};
+    cell cells[SegmentSize];
+
+    void reset() noexcept {
+      enqueue.store(0, std::memory_order_relaxed);
+      dequeue.store(0, std::memory_order_relaxed);
+      next.store(nullptr, std::memory_order_relaxed);
+      for (auto& c : cells) c.state.store(_S_empty, std::memory_order_relaxed);
+    }
+  };
+
+  using segment_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<segment>;
+  using segment_traits = std::allocator_traits<segment_allocator>;
+
+  static constexpr std::size_t _S_retire_threshold = 4;  // 退休表攒到这么多再扫描风险指针
+  static constexpr std::size_t _S_max_free = 8;         // 空闲表最多留这么多段，多余的释放
+
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using allocator_type = Alloc;
+  static constexpr size_type segment_size = SegmentSize;
+
+  segmented_mpmc_queue() : segmented_mpmc_queue(Alloc()) {}
+  explicit segmented_mpmc_queue(const Alloc& alloc) : _M_alloc(alloc) {
+    segment* s = _M_new_segment();
+    _M_head.store(s, std::memory_order_relaxed);
+    _M_tail.store(s, std::memory_order_relaxed);
+  }
+  segmented_mpmc_queue(const segmented_mpmc_queue&) = delete;
+  segmented_mpmc_queue& operator=(const segmented_mpmc_queue&) = delete;
+
+  ~segmented_mpmc_queue() {
+    segment* s = _M_head.load(std::memory_order_relaxed);
+    while (s) {
+      size_type end = std::min(s->enqueue.load(std::memory_order_relaxed), SegmentSize);
+      for (size_type i = s->dequeue.load(std::memory_order_relaxed); i < end; ++i)
+        if (s->cells[i].state.load(std::memory_order_relaxed) == _S_ready) std::destroy_at(s->cells[i].ptr());
+      segment* next = s->next.load(std::memory_order_relaxed);
+      _M_delete_segment(s);
+      s = next;
+    }
+    for (segment* r : _M_retired) _M_delete_segment(r);
+    for (segment* f : _M_free) _M_delete_segment(f);
+  }
+
+  void push(const T& value) { emplace(value); }
+  void push(T&& value) { emplace(std::move(value)); }
+
+  template <typename... Args>
+  void emplace(Args&&... args) {
+    concurrent_detail::hazard_guard guard{concurrent_detail::local_hazard()};
+    for (;;) {
+      segment* tail = concurrent_detail::protect(_M_tail, guard.slot);
+      size_type idx = tail->enqueue.fetch_add(1, std::memory_order_acq_rel);
+      if (idx < SegmentSize) {
+        cell& c = tail->cells[idx];
+        unsigned char expected = _S_empty;
+        if (!c.state.compare_exchange_strong(expected, _S_writing, std::memory_order_acq_rel)) continue;  // 已被作废
+        try {
+          ::new (static_cast<void*>(c.storage)) T(std::forward<Args>(args)...);
+        } catch (...) {
+          c.state.store(_S_abandoned, std::memory_order_release);
+          throw;
+        }
+        c.state.store(_S_ready, std::memory_order_release);
+        return;
+      }
+      // 段已满：挂上下一段（可能已被别人挂上），并帮忙推进 _M_tail
+      segment* next = tail->next.load(std::memory_order_acquire);
+      if (!next) {
+        segment* fresh = _M_new_segment();
+        if (tail->next.compare_exchange_strong(next, fresh, std::memory_order_acq_rel)) {
+          next = fresh;
+        } else {
+          _M_recycle_unused(fresh);
+        }
+      }
+      _M_tail.compare_exchange_strong(tail, next, std::memory_order_acq_rel);
+    }
+  }
+
+  bool try_pop(T& out) {
+    concurrent_detail::hazard_guard guard{concurrent_detail::local_hazard()};
+    for (;;) {
+      segment* head = concurrent_detail::protect(_M_head, guard.slot);
+      size_type d = head->dequeue.load(std::memory_order_acquire);
+      if (d >= SegmentSize) {  // 本段已取完，转到下一段
+        segment* next = head->next.load(std::memory_order_acquire);
+        if (!next) return false;
+        _M_advance_head(head, next);
+        continue;
+      }
+      // 先看一眼再 fetch_add：空队列上反复出队不会把后面的槽位全作废
+      if (d >= head->enqueue.load(std::memory_order_acquire)) return false;
+      size_type idx = head->dequeue.fetch_add(1, std::memory_order_acq_rel);
+      if (idx >= SegmentSize) continue;
+      cell& c = head->cells[idx];
+      unsigned char state = _S_empty;
+      if (c.state.compare_exchange_strong(state, _S_abandoned, std::memory_order_acq_rel)) continue;
+      concurrent_detail::backoff wait;
+      while (state == _S_writing) {
+        wait.pause();
+        state = c.state.load(std::memory_order_acquire);
+      }
+      if (state == _S_abandoned) continue;  // 生产者构造时抛了异常
+      struct destroy_guard {
+        T* p;
+        ~destroy_guard() { std::destroy_at(p); }
+      } element{c.ptr()};
+      out = std::move(*element.p);
+      return true;
+    }
+  }
+
+  // 近似值：有线程并发出入队时仅供参考
+  bool empty() const noexcept {
+    segment* head = _M_head.load(std::memory_order_acquire);
+    size_type d = head->dequeue.load(std::memory_order_acquire);
+    size_type e = head->enqueue.load(std::memory_order_acquire);
+    return d >= std::min(e, SegmentSize) && !head->next.load(std::memory_order_acquire);
+  }
+
+private:
+  void _M_advance_head(segment* head, segment* next) {
+    // 先让 _M_tail 越过 head，保证 head 退休后不会再从 _M_tail 被读到
+    segment* tail = head;
+    _M_tail.compare_exchange_strong(tail, next, std::memory_order_acq_rel);
+    if (_M_head.compare_exchange_strong(head, next, std::memory_order_acq_rel)) _M_retire(head);
+  }
+
+  segment* _M_new_segment() {
+    {
+      std::lock_guard<std::mutex> lock(_M_pool_mutex);
+      if (!_M_free.empty()) {
+        segment* s = _M_free.back();
+        _M_free.pop_back();
+        return s;
+      }
+    }
+    segment* s = segment_traits::allocate(_M_alloc, 1);
+    ::new (static_cast<void*>(s)) segment();
+    return s;
+  }
+
+  void _M_delete_segment(segment* s) noexcept {
+    std::destroy_at(s);
+    segment_traits::deallocate(_M_alloc, s, 1);
+  }
+
+  // 从未挂进队列的段，直接放回空闲表
+  void _M_recycle_unused(segment* s) {
+    std::lock_guard<std::mutex> lock(_M_pool_mutex);
+    if (_M_free.size() < _S_max_free) {
+      _M_free.push_back(s);
+    } else {
+      _M_delete_segment(s);
+    }
+  }
+
+  void _M_retire(segment* s) {
+    std::lock_guard<std::mutex> lock(_M_pool_mutex);
+    _M_retired.push_back(s);
+    if (_M_retired.size() < _S_retire_threshold) return;
+    std::size_t kept = 0;
+    for (segment* r : _M_retired) {
+      if (concurrent_detail::is_hazardous(r)) {
+        _M_retired[kept++] = r;
+      } else if (_M_free.size() < _S_max_free) {
+        r->reset();
+        _M_free.push_back(r);
+      } else {
+        _M_delete_segment(r);
+      }
+    }
+    _M_retired.resize(kept);
+  }
+
+  [[no_unique_address]] segment_allocator _M_alloc;
+  alignas(cache_line_size) std::atomic<segment*> _M_head{nullptr};
+  alignas(cache_line_size) std::atomic<segment*> _M_tail{nullptr};
+  alignas(cache_line_size) std::mutex _M_pool_mutex;
+  std::vector<segment*> _M_retired;
+  std::vector<segment*> _M_free;
+};
+
+}  // namespace leistd
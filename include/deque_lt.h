@@ -0,0 +1,671 @@
+#pragma once
+#include <algorithm>         // max, move, move_backward, rotate, equal
+#include <compare>
+#include <cstddef>           // size_t, ptrdiff_t
+#include <initializer_list>
+#include <iterator>
+#include <memory>            // allocator_traits
+#include <stdexcept>         // out_of_range
+#include <type_traits>
+#include <utility>
+
+namespace leistd {
+
+// 默认每块约 1KB 的元素，至少 16 个
+template <typename T>
+inline constexpr std::size_t deque_default_block_size = std::max<std::size_t>(16, 1024 / sizeof(T));
+
+/*============ 双端队列 ============*/
+// 元素存放在定长的块里，块指针按顺序排在一张映射表（map）中：
+// - 两端插入/删除只动首尾块，块用完才新开一块，O(1) 摊还；映射表两端留有空位，用完时整体居中或扩容
+// - 下标访问 = 块号 + 块内偏移，O(1)
+// - 批量插入先一次性备好所需的块，再逐个构造；中间插入/删除只搬动离 pos 较近的一侧
+// - 缓存一个被删空的块（_M_spare）：FIFO 用法下块在头部被删空、在尾部被重新用上，不会反复向分配器申请
+//
+// 迭代器记录（元素指针，所在块首地址，块号，映射表控制块）。块号从第一个块的 0 开始，向前为负，
+// 映射表搬动或扩容只改控制块里的表指针和起始块号，因此两端 push 不会使任何迭代器失效
+// （std::deque 的迭代器直接指向映射表中的槽位，映射表一扩容就全部失效）。
+// 控制块单独分配，swap/移动构造后迭代器随元素一起转移到新容器。
+template <typename T, typename Alloc = std::allocator<T>, std::size_t BlockSize = deque_default_block_size<T>>
+class deque {
+  static_assert(BlockSize >= 2, "deque: BlockSize must be at least 2");
+
+  using AllocTraits = std::allocator_traits<Alloc>;
+
+  // 块号 b 的块首地址在 map[b - base]
+  struct map_ctrl {
+    T** map;
+    std::size_t map_size;
+    std::ptrdiff_t base;
+
+    T* block(std::ptrdiff_t b) const noexcept { return map[b - base]; }
+  };
+
+  // 向下取整的除法，块号可以为负
+  static std::ptrdiff_t _S_floor_div(std::ptrdiff_t a, std::ptrdiff_t b) noexcept {
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+  }
+
+  /*============ 迭代器定义 ============*/
+  template <typename Ref, typename Ptr>
+  struct deque_iterator {
+    using value_type = T;
+    using reference = Ref;
+    using pointer = Ptr;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::random_access_iterator_tag;
+
+    T* cur = nullptr;
+    T* first = nullptr;
+    std::ptrdiff_t block = 0;
+    const map_ctrl* ctrl = nullptr;
+
+    deque_iterator() = default;
+    deque_iterator(T* c, T* f, std::ptrdiff_t b, const map_ctrl* m) : cur(c), first(f), block(b), ctrl(m) {}
+    deque_iterator(const deque_iterator<T&, T*>& it)  // 非 const -> const
+        : cur(it.cur), first(it.first), block(it.block), ctrl(it.ctrl) {}
+    deque_iterator& operator=(const deque_iterator&) = default;
+
+    reference operator*() const { return *cur; }
+    pointer operator->() const { return cur; }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    void set_block(std::ptrdiff_t b) noexcept {
+      block = b;
+      first = ctrl->block(b);
+    }
+
+    deque_iterator& operator++() {
+      if (++cur == first + BlockSize) {
+        set_block(block + 1);
+        cur = first;
+      }
+      return *this;
+    }
+    deque_iterator operator++(int) {
+      deque_iterator tmp(*this);
+      ++(*this);
+      return tmp;
+    }
+
+    deque_iterator& operator--() {
+      if (cur == first) {
+        set_block(block - 1);
+        cur = first + BlockSize;
+      }
+      --cur;
+      return *this;
+    }
+    deque_iterator operator--(int) {
+      deque_iterator tmp(*this);
+      --(*this);
+      return tmp;
+    }
+
+    // 块内移动只改指针，跨块时按块号查一次映射表
+    deque_iterator& operator+=(difference_type n) {
+      difference_type off = (cur - first) + n;
+      if (off >= 0 && off < static_cast<difference_type>(BlockSize)) {
+        cur += n;
+      } else {
+        difference_type jump = _S_floor_div(off, BlockSize);
+        set_block(block + jump);
+        cur = first + (off - jump * static_cast<difference_type>(BlockSize));
+      }
+      return *this;
+    }
+    deque_iterator& operator-=(difference_type n) { return *this += -n; }
+
+    friend deque_iterator operator+(deque_iterator it, difference_type n) { return it += n; }
+    friend deque_iterator operator+(difference_type n, deque_iterator it) { return it += n; }
+    friend deque_iterator operator-(deque_iterator it, difference_type n) { return it -= n; }
+
+    friend difference_type operator-(const deque_iterator& a, const deque_iterator& b) {
+      return (a.block - b.block) * static_cast<difference_type>(BlockSize) + (a.cur - a.first) - (b.cur - b.first);
+    }
+
+    friend bool operator==(const deque_iterator& a, const deque_iterator& b) { return a.cur == b.cur; }
+    friend auto operator<=>(const deque_iterator& a, const deque_iterator& b) { return (a - b) <=> 0; }
+  };
+
+public:
+  /*============ 类型定义 ============*/
+  using value_type = T;
+  using allocator_type = Alloc;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using iterator = deque_iterator<T&, T*>;
+  using const_iterator = deque_iterator<const T&, const T*>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  static constexpr size_type block_size = BlockSize;
+
+  /*============ 构造/析构 ============*/
+  // 空 deque 不分配任何内存，第一次插入时才建立映射表
+  deque() : deque(Alloc()) {}
+
+  explicit deque(const Alloc& alloc) : _M_alloc(alloc) {}
+
+  explicit deque(size_type count, const Alloc& alloc = Alloc()) : deque(alloc) { resize(count); }
+
+  deque(size_type count, const T& value, const Alloc& alloc = Alloc()) : deque(alloc) {
+    insert(end(), count, value);
+  }
+
+  template <std::input_iterator InputIt>
+  deque(InputIt first, InputIt last, const Alloc& alloc = Alloc()) : deque(alloc) {
+    insert(end(), first, last);
+  }
+
+  deque(std::initializer_list<T> ilist, const Alloc& alloc = Alloc()) : deque(alloc) {
+    insert(end(), ilist.begin(), ilist.end());
+  }
+
+  deque(const deque& other) : deque(AllocTraits::select_on_container_copy_construction(other._M_alloc)) {
+    insert(end(), other.begin(), other.end());
+  }
+
+  deque(deque&& other) noexcept : _M_alloc(other._M_alloc) { _M_take(other); }
+
+  deque& operator=(const deque& other) {
+    if (this == &other) return *this;
+    if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+      if (_M_alloc != other._M_alloc) _M_release();  // 块要还给原来的分配器
+      _M_alloc = other._M_alloc;
+    }
+    clear();
+    insert(end(), other.begin(), other.end());
+    return *this;
+  }
+
+  // 分配器会传播或两边相等时直接接管映射表和所有块，否则逐个移动元素
+  deque& operator=(deque&& other) {
+    if (this == &other) return *this;
+    if (_M_can_steal(other)) {
+      _M_release();
+      if constexpr (AllocTraits::propagate_on_container_move_assignment::value) _M_alloc = other._M_alloc;
+      _M_take(other);
+    } else {
+      clear();
+      _M_insert_range(end(), std::make_move_iterator(other.begin()), other.size());
+      other.clear();
+    }
+    return *this;
+  }
+
+  deque& operator=(std::initializer_list<T> ilist) {
+    clear();
+    insert(end(), ilist.begin(), ilist.end());
+    return *this;
+  }
+
+  ~deque() { _M_release(); }
+
+  friend void swap(deque& lhs, deque& rhs) noexcept {
+    using std::swap;
+    swap(lhs._M_ctrl, rhs._M_ctrl);
+    swap(lhs._M_start, rhs._M_start);
+    swap(lhs._M_finish, rhs._M_finish);
+    swap(lhs._M_spare, rhs._M_spare);
+    if constexpr (AllocTraits::propagate_on_container_swap::value) swap(lhs._M_alloc, rhs._M_alloc);
+  }
+
+  allocator_type get_allocator() const { return _M_alloc; }
+
+  /*============ 容量接口 ============*/
+  bool empty() const noexcept { return _M_start.cur == _M_finish.cur; }
+  size_type size() const noexcept { return _M_finish - _M_start; }
+
+  // 释放缓存的空块，并把映射表收缩到刚好容纳现有的块
+  void shrink_to_fit() {
+    if (_M_spare) {
+      AllocTraits::deallocate(_M_alloc, _M_spare, BlockSize);
+      _M_spare = nullptr;
+    }
+    if (_M_ctrl && _M_ctrl->map_size > _M_block_count() + 2) _M_move_map(_M_block_count() + 2, 1);
+  }
+
+  /*============ 迭代器接口 ============*/
+  iterator begin() noexcept { return _M_start; }
+  iterator end() noexcept { return _M_finish; }
+  const_iterator begin() const noexcept { return _M_start; }
+  const_iterator end() const noexcept { return _M_finish; }
+  const_iterator cbegin() const noexcept { return _M_start; }
+  const_iterator cend() const noexcept { return _M_finish; }
+
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+  const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+  const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+  /*============ 访问接口 ============*/
+  T& operator[](size_type n) { return _M_start[n]; }
+  const T& operator[](size_type n) const { return _M_start[n]; }
+
+  T& at(size_type n) {
+    if (n >= size()) throw std::out_of_range("deque");
+    return _M_start[n];
+  }
+  const T& at(size_type n) const {
+    if (n >= size()) throw std::out_of_range("deque");
+    return _M_start[n];
+  }
+
+  T& front() { return *_M_start.cur; }
+  const T& front() const { return *_M_start.cur; }
+  T& back() { return *std::prev(end()); }
+  const T& back() const { return *std::prev(end()); }
+
+  /*============ 两端插入/删除 ============*/
+  void push_back(const T& value) { emplace_back(value); }
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+
+  void push_front(const T& value) { emplace_front(value); }
+  void push_front(T&& value) { emplace_front(std::move(value)); }
+
+  // 块内还有空位时直接构造；换块（及第一次插入）走 _M_emplace_*_aux
+  template <typename... Args>
+  T& emplace_back(Args&&... args) {
+    if (_M_ctrl && _M_finish.cur + 1 != _M_finish.first + BlockSize) [[likely]] {
+      AllocTraits::construct(_M_alloc, _M_finish.cur, std::forward<Args>(args)...);
+      return *_M_finish.cur++;
+    }
+    return _M_emplace_back_aux(std::forward<Args>(args)...);
+  }
+
+  template <typename... Args>
+  T& emplace_front(Args&&... args) {
+    if (_M_start.cur != _M_start.first) [[likely]] {
+      AllocTraits::construct(_M_alloc, _M_start.cur - 1, std::forward<Args>(args)...);
+      return *--_M_start.cur;
+    }
+    return _M_emplace_front_aux(std::forward<Args>(args)...);
+  }
+
+  void pop_back() {
+    if (empty()) return;
+    if (_M_finish.cur == _M_finish.first) {
+      _M_free_block(_M_finish.block);
+      _M_finish.set_block(_M_finish.block - 1);
+      _M_finish.cur = _M_finish.first + BlockSize;
+    }
+    AllocTraits::destroy(_M_alloc, --_M_finish.cur);
+  }
+
+  void pop_front() {
+    if (empty()) return;
+    AllocTraits::destroy(_M_alloc, _M_start.cur);
+    if (++_M_start.cur == _M_start.first + BlockSize) [[unlikely]] {
+      _M_free_block(_M_start.block);
+      _M_start.set_block(_M_start.block + 1);
+      _M_start.cur = _M_start.first;
+    }
+  }
+
+  /*============ 中间插入/删除 ============*/
+  iterator insert(const_iterator pos, const T& value) { return emplace(pos, value); }
+  iterator insert(const_iterator pos, T&& value) { return emplace(pos, std::move(value)); }
+
+  // 在离 pos 较近的一端构造，再旋转到位；只搬动较短的一侧
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args&&... args) {
+    difference_type index = pos - cbegin();
+    if (index == 0) {
+      emplace_front(std::forward<Args>(args)...);
+      return begin();
+    }
+    if (pos == cend()) {
+      emplace_back(std::forward<Args>(args)...);
+      return end() - 1;
+    }
+    if (static_cast<size_type>(index) < size() - index) {
+      emplace_front(std::forward<Args>(args)...);
+      std::rotate(begin(), begin() + 1, begin() + index + 1);
+    } else {
+      emplace_back(std::forward<Args>(args)...);
+      std::rotate(begin() + index, end() - 1, end());
+    }
+    return begin() + index;
+  }
+
+  // 批量插入：在较近的一端一次性备好所需的块，整段构造后再旋转到位。返回第一个插入元素
+  iterator insert(const_iterator pos, size_type count, const T& value) {
+    return _M_insert_n(pos, count, [&](T* p) { AllocTraits::construct(_M_alloc, p, value); });
+  }
+
+  template <std::input_iterator InputIt>
+  iterator insert(const_iterator pos, InputIt first, InputIt last) {
+    if constexpr (std::forward_iterator<InputIt>) {
+      return _M_insert_range(pos, first, std::distance(first, last));
+    } else {
+      // 单遍迭代器无法预知个数：先收进临时 deque
+      deque tmp(get_allocator());
+      for (; first != last; ++first) tmp.emplace_back(*first);
+      return _M_insert_range(pos, std::make_move_iterator(tmp.begin()), tmp.size());
+    }
+  }
+
+  iterator insert(const_iterator pos, std::initializer_list<T> ilist) {
+    return insert(pos, ilist.begin(), ilist.end());
+  }
+
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+  // 把较短一侧的元素搬过来补上空缺，再从那一端删除
+  iterator erase(const_iterator first, const_iterator last) {
+    difference_type index = first - cbegin();
+    difference_type n = last - first;
+    if (n == 0) return begin() + index;
+    iterator f = begin() + index;
+    iterator l = f + n;
+    if (static_cast<size_type>(index) < size() - index - n) {
+      std::move_backward(begin(), f, l);
+      _M_erase_front(n);
+    } else {
+      std::move(l, end(), f);
+      _M_erase_back(n);
+    }
+    return begin() + index;
+  }
+
+  // 只保留 _M_start 所在的块，映射表保留
+  void clear() noexcept {
+    if (!_M_ctrl) return;
+    _M_erase_back(size());
+  }
+
+  void resize(size_type count) { _M_resize(count, [&](T* p) { AllocTraits::construct(_M_alloc, p); }); }
+  void resize(size_type count, const T& value) {
+    _M_resize(count, [&](T* p) { AllocTraits::construct(_M_alloc, p, value); });
+  }
+
+  /*============ 操作符重载 ============*/
+  friend bool operator==(const deque& lhs, const deque& rhs) {
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+  }
+
+private:
+  /*============ 内存管理 ============*/
+  using MapAlloc = typename AllocTraits::template rebind_alloc<T*>;
+  using MapTraits = std::allocator_traits<MapAlloc>;
+  using CtrlAlloc = typename AllocTraits::template rebind_alloc<map_ctrl>;
+  using CtrlTraits = std::allocator_traits<CtrlAlloc>;
+
+  static constexpr size_type _S_initial_map_size = 8;
+
+  bool _M_can_steal(const deque& other) const noexcept {
+    if constexpr (AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value)
+      return true;
+    else
+      return _M_alloc == other._M_alloc;
+  }
+
+  void _M_take(deque& other) noexcept {
+    _M_ctrl = other._M_ctrl;
+    _M_start = other._M_start;
+    _M_finish = other._M_finish;
+    _M_spare = other._M_spare;
+    other._M_ctrl = nullptr;
+    other._M_start = other._M_finish = iterator();
+    other._M_spare = nullptr;
+  }
+
+  size_type _M_block_count() const noexcept { return _M_finish.block - _M_start.block + 1; }
+
+  void _M_set_block(std::ptrdiff_t b, T* block) noexcept { _M_ctrl->map[b - _M_ctrl->base] = block; }
+
+  // 建立控制块、映射表和第一个块；块号 0 放在映射表正中间，两端都留有空位
+  void _M_initialize() {
+    CtrlAlloc ca(_M_alloc);
+    MapAlloc ma(_M_alloc);
+    constexpr size_type size = _S_initial_map_size;
+    map_ctrl* ctrl = CtrlTraits::allocate(ca, 1);
+    T** map = nullptr;
+    try {
+      map = MapTraits::allocate(ma, size);
+      std::fill_n(map, size, nullptr);
+      map[size / 2] = _M_allocate_block();
+    } catch (...) {
+      if (map) MapTraits::deallocate(ma, map, size);
+      CtrlTraits::deallocate(ca, ctrl, 1);
+      throw;
+    }
+    _M_ctrl = ::new (static_cast<void*>(ctrl)) map_ctrl{map, size, -static_cast<std::ptrdiff_t>(size / 2)};
+    _M_start = _M_finish = iterator(map[size / 2], map[size / 2], 0, ctrl);
+  }
+
+  // 析构所有元素，释放所有块、映射表和控制块
+  void _M_release() noexcept {
+    if (!_M_ctrl) return;
+    clear();
+    AllocTraits::deallocate(_M_alloc, _M_start.first, BlockSize);
+    if (_M_spare) AllocTraits::deallocate(_M_alloc, _M_spare, BlockSize);
+    MapAlloc ma(_M_alloc);
+    MapTraits::deallocate(ma, _M_ctrl->map, _M_ctrl->map_size);
+    CtrlAlloc ca(_M_alloc);
+    CtrlTraits::deallocate(ca, _M_ctrl, 1);
+    _M_ctrl = nullptr;
+    _M_start = _M_finish = iterator();
+    _M_spare = nullptr;
+  }
+
+  T* _M_allocate_block() {
+    if (T* b = _M_spare) {
+      _M_spare = nullptr;
+      return b;
+    }
+    return AllocTraits::allocate(_M_alloc, BlockSize);
+  }
+
+  // 块号 b 的块已经没有元素：留作缓存或还给分配器
+  void _M_free_block(std::ptrdiff_t b) noexcept {
+    T*& slot = _M_ctrl->map[b - _M_ctrl->base];
+    if (!_M_spare) {
+      _M_spare = slot;
+    } else {
+      AllocTraits::deallocate(_M_alloc, slot, BlockSize);
+    }
+    slot = nullptr;
+  }
+
+  void _M_free_blocks(std::ptrdiff_t first, std::ptrdiff_t last) noexcept {
+    for (; first != last; ++first) _M_free_block(first);
+  }
+
+  static void _M_destroy(Alloc& alloc, iterator first, iterator last) noexcept {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      for (; first != last; ++first) AllocTraits::destroy(alloc, first.cur);
+    }
+  }
+
+  // 保证映射表在前端（at_front）或后端还能再放 add 个块
+  void _M_reserve_map(size_type add, bool at_front) {
+    std::ptrdiff_t first_slot = _M_start.block - _M_ctrl->base;
+    std::ptrdiff_t last_slot = _M_finish.block - _M_ctrl->base;
+    size_type room = at_front ? static_cast<size_type>(first_slot) : _M_ctrl->map_size - last_slot - 1;
+    if (room >= add) return;
+    // 表的空位超过一半时原地居中即可，否则换一张更大的表；新块那一端多留出 add 个空位
+    size_type need = _M_block_count() + add;
+    size_type old_size = _M_ctrl->map_size;
+    size_type new_size = old_size > 2 * need ? old_size : old_size + std::max(old_size, add) + 2;
+    _M_move_map(new_size, (new_size - need) / 2 + (at_front ? add : 0));
+  }
+
+  // 把现有块的槽位搬到大小为 new_size 的表（大小不变时就是原表）中下标 lead 开始的位置
+  void _M_move_map(size_type new_size, size_type lead) {
+    map_ctrl& c = *_M_ctrl;
+    size_type used = _M_block_count();
+    T** old_first = c.map + (_M_start.block - c.base);
+    if (new_size == c.map_size) {
+      T** new_first = c.map + lead;
+      if (new_first < old_first) {
+        std::copy(old_first, old_first + used, new_first);
+      } else {
+        std::copy_backward(old_first, old_first + used, new_first + used);
+      }
+    } else {
+      MapAlloc ma(_M_alloc);
+      T** new_map = MapTraits::allocate(ma, new_size);
+      std::copy(old_first, old_first + used, new_map + lead);
+      MapTraits::deallocate(ma, c.map, c.map_size);
+      c.map = new_map;
+      c.map_size = new_size;
+    }
+    std::fill(c.map, c.map + lead, nullptr);
+    std::fill(c.map + lead + used, c.map + c.map_size, nullptr);
+    c.base = _M_start.block - static_cast<std::ptrdiff_t>(lead);
+  }
+
+  // 在前端备好 n 个未构造的槽位（一次性分配所需的块），返回新的起点
+  iterator _M_reserve_front(size_type n) {
+    size_type room = _M_start.cur - _M_start.first;
+    if (n > room) {
+      size_type blocks = (n - room + BlockSize - 1) / BlockSize;
+      _M_reserve_map(blocks, true);
+      std::ptrdiff_t b = _M_start.block;
+      const std::ptrdiff_t stop = b - static_cast<std::ptrdiff_t>(blocks);
+      try {
+        for (; b != stop; --b) _M_set_block(b - 1, _M_allocate_block());
+      } catch (...) {
+        _M_free_blocks(b, _M_start.block);
+        throw;
+      }
+    }
+    return _M_start - n;
+  }
+
+  // 在后端备好 n 个未构造的槽位，返回新的终点；新终点所在的块也已分配
+  iterator _M_reserve_back(size_type n) {
+    size_type blocks = (_M_finish.cur - _M_finish.first + n) / BlockSize;
+    if (blocks) {
+      _M_reserve_map(blocks, false);
+      std::ptrdiff_t b = _M_finish.block;
+      const std::ptrdiff_t stop = b + static_cast<std::ptrdiff_t>(blocks);
+      try {
+        for (; b != stop; ++b) _M_set_block(b + 1, _M_allocate_block());
+      } catch (...) {
+        _M_free_blocks(_M_finish.block + 1, b + 1);
+        throw;
+      }
+    }
+    return _M_finish + n;
+  }
+
+  // 在离 pos 较近的一端备好 n 个槽位，用 construct 逐个构造，再旋转到 pos。
+  // 构造抛异常时已构造的元素和新备的块全部撤销，deque 保持原样
+  template <typename Construct>
+  iterator _M_insert_n(const_iterator pos, size_type n, Construct construct) {
+    difference_type index = pos - cbegin();
+    if (n == 0) return begin() + index;
+    if (!_M_ctrl) _M_initialize();
+    if (static_cast<size_type>(index) < size() - index) {
+      iterator new_start = _M_reserve_front(n);
+      iterator cur = new_start;
+      try {
+        for (; cur != _M_start; ++cur) construct(cur.cur);
+      } catch (...) {
+        _M_destroy(_M_alloc, new_start, cur);
+        _M_free_blocks(new_start.block, _M_start.block);
+        throw;
+      }
+      _M_start = new_start;
+      if (index) std::rotate(begin(), begin() + n, begin() + n + index);
+    } else {
+      iterator new_finish = _M_reserve_back(n);
+      iterator cur = _M_finish;
+      try {
+        for (; cur != new_finish; ++cur) construct(cur.cur);
+      } catch (...) {
+        _M_destroy(_M_alloc, _M_finish, cur);
+        _M_free_blocks(_M_finish.block + 1, new_finish.block + 1);
+        throw;
+      }
+      _M_finish = new_finish;
+      if (static_cast<size_type>(index) + n != size()) std::rotate(begin() + index, end() - n, end());
+    }
+    return begin() + index;
+  }
+
+  // _M_finish 始终落在已分配的块里：填满尾块的最后一个槽位之前先备好下一块
+  template <typename... Args>
+  T& _M_emplace_back_aux(Args&&... args) {
+    if (!_M_ctrl) {
+      _M_initialize();
+      return emplace_back(std::forward<Args>(args)...);
+    }
+    _M_reserve_map(1, false);
+    _M_set_block(_M_finish.block + 1, _M_allocate_block());
+    try {
+      AllocTraits::construct(_M_alloc, _M_finish.cur, std::forward<Args>(args)...);
+    } catch (...) {
+      _M_free_block(_M_finish.block + 1);
+      throw;
+    }
+    T* p = _M_finish.cur;
+    _M_finish.set_block(_M_finish.block + 1);
+    _M_finish.cur = _M_finish.first;
+    return *p;
+  }
+
+  template <typename... Args>
+  T& _M_emplace_front_aux(Args&&... args) {
+    if (!_M_ctrl) _M_initialize();
+    _M_reserve_map(1, true);
+    T* block = _M_allocate_block();
+    _M_set_block(_M_start.block - 1, block);
+    try {
+      AllocTraits::construct(_M_alloc, block + BlockSize - 1, std::forward<Args>(args)...);
+    } catch (...) {
+      _M_free_block(_M_start.block - 1);
+      throw;
+    }
+    _M_start.set_block(_M_start.block - 1);
+    _M_start.cur = _M_start.first + BlockSize - 1;
+    return *_M_start.cur;
+  }
+
+  // 从 first 开始依次取 n 个元素插入 pos 前
+  template <typename It>
+  iterator _M_insert_range(const_iterator pos, It first, size_type n) {
+    return _M_insert_n(pos, n, [&](T* p) {
+      AllocTraits::construct(_M_alloc, p, *first);
+      ++first;
+    });
+  }
+
+  void _M_erase_front(size_type n) noexcept {
+    iterator new_start = _M_start + n;
+    _M_destroy(_M_alloc, _M_start, new_start);
+    _M_free_blocks(_M_start.block, new_start.block);
+    _M_start = new_start;
+  }
+
+  void _M_erase_back(size_type n) noexcept {
+    iterator new_finish = _M_finish - n;
+    _M_destroy(_M_alloc, new_finish, _M_finish);
+    _M_free_blocks(new_finish.block + 1, _M_finish.block + 1);
+    _M_finish = new_finish;
+  }
+
+  template <typename Construct>
+  void _M_resize(size_type count, Construct construct) {
+    size_type n = size();
+    if (count < n) {
+      _M_erase_back(n - count);
+    } else {
+      _M_insert_n(cend(), count - n, construct);
+    }
+  }
+
+private:
+  map_ctrl* _M_ctrl = nullptr;  // 空 deque 为 nullptr
+  iterator _M_start;
+  iterator _M_finish;
+  T* _M_spare = nullptr;        // 缓存的一个空块
+  Alloc _M_alloc;
+};
+
+}  // namespace leistd
@@ -0,0 +1,957 @@
+#pragma once
+#include <algorithm>         // max, min
+#include <bit>               // bit_ceil, countr_zero
+#include <cstddef>           // size_t, ptrdiff_t
+#include <cstdint>
+#include <cstring>           // memcpy, memset
+#include <initializer_list>
+#include <iterator>
+#include <memory>            // allocator_traits
+#include <stdexcept>         // out_of_range
+#include <tuple>             // forward_as_tuple
+#include <type_traits>
+#include <utility>
+
+#if defined(__GNUC__) && defined(__x86_64__)  // x86-64 上 SSE2 是基线指令集
+#include <emmintrin.h>
+#define LEISTD_HASH_TABLE_SSE2 1
+#endif
+
+#include "hash_lt.h"
+#include "relocate_lt.h"
+
+namespace leistd {
+
+namespace hash_table_detail {
+
+/*============ 控制字节 ============*/
+// 每个槽位对应一个控制字节：满槽存哈希值的低 7 位（H2，0..127），空槽为 ctrl_empty，
+// 表尾之后是一组 ctrl_sentinel。空位和哨兵的最高位都是 1，满槽的最高位是 0。
+using ctrl_t = std::int8_t;
+inline constexpr ctrl_t ctrl_empty = -128;   // 0b10000000
+inline constexpr ctrl_t ctrl_sentinel = -1;  // 0b11111111
+
+// 空表共用的一组哨兵：查找读到它立即结束，迭代器从它开始即为 end()
+inline ctrl_t* empty_ctrl() noexcept {
+  alignas(16) static constexpr ctrl_t group[16] = {-1, -1, -1, -1, -1, -1, -1, -1,
+                                                   -1, -1, -1, -1, -1, -1, -1, -1};
+  return const_cast<ctrl_t*>(group);
+}
+
+// 组匹配结果：每个命中的控制字节对应一位（SWAR 版是每字节的最高位，Shift = 3），从低位起逐个取出
+template <int Shift>
+struct bitmask {
+  std::uint64_t bits;
+
+  explicit operator bool() const noexcept { return bits != 0; }
+  std::size_t lowest() const noexcept { return static_cast<std::size_t>(std::countr_zero(bits)) >> Shift; }
+  void clear_lowest() noexcept { bits &= bits - 1; }
+};
+
+#ifdef LEISTD_HASH_TABLE_SSE2
+// 一次比较 16 个控制字节；从任意槽位开始非对齐加载
+struct group {
+  static constexpr std::size_t width = 16;
+  __m128i ctrl;
+
+  explicit group(const ctrl_t* p) noexcept : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))) {}
+
+  bitmask<0> match(ctrl_t h2) const noexcept { return {_S_mask(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl))}; }
+  bitmask<0> match_empty() const noexcept { return match(ctrl_empty); }
+  // 空位或哨兵：直接取每字节的最高位
+  bitmask<0> match_special() const noexcept { return {_S_mask(ctrl)}; }
+  // 满槽或哨兵（迭代器用来跳过空位）
+  bitmask<0> match_non_empty() const noexcept { return {match_empty().bits ^ 0xffffu}; }
+
+  static std::uint64_t _S_mask(__m128i v) noexcept { return static_cast<std::uint16_t>(_mm_movemask_epi8(v)); }
+};
+#else
+// 可移植的 SWAR 版本：一个 64 位字当作 8 个字节并行处理
+struct group {
+  static constexpr std::size_t width = 8;
+  static constexpr std::uint64_t lsbs = 0x0101010101010101ull;
+  static constexpr std::uint64_t msbs = 0x8080808080808080ull;
+  std::uint64_t ctrl = 0;
+
+  // 按小端拼字，使第 i 个控制字节落在第 i 个字节上；编译器会合并成一次加载
+  explicit group(const ctrl_t* p) noexcept {
+    for (std::size_t i = 0; i < width; ++i) ctrl |= std::uint64_t(static_cast<std::uint8_t>(p[i])) << (8 * i);
+  }
+
+  // 经典的"字内找零字节"。可能有假阳性，但只会落在值为 h2 ^ 1 的满槽上，调用方本来就要比较键
+  bitmask<3> match(ctrl_t h2) const noexcept {
+    std::uint64_t x = ctrl ^ (lsbs * static_cast<std::uint8_t>(h2));
+    return {(x - lsbs) & ~x & msbs};
+  }
+  // 最高位为 1 且第 1 位为 0 的只有 ctrl_empty
+  bitmask<3> match_empty() const noexcept { return {ctrl & ~(ctrl << 6) & msbs}; }
+  bitmask<3> match_special() const noexcept { return {ctrl & msbs}; }
+  bitmask<3> match_non_empty() const noexcept { return {match_empty().bits ^ msbs}; }
+};
+#endif
+
+// 把用户哈希值打散：乘一个奇数常量，取 128 位乘积高低两半异或。
+// std::hash<int> 之类的恒等哈希也能得到分布均匀的 H1（高位）和 H2（低 7 位）
+inline std::size_t mix(std::size_t h) noexcept {
+#ifdef __SIZEOF_INT128__
+  unsigned __int128 p = static_cast<unsigned __int128>(h) * 0x9e3779b97f4a7c15ull;
+  return static_cast<std::size_t>(static_cast<std::uint64_t>(p) ^ static_cast<std::uint64_t>(p >> 64));
+#else
+  std::uint64_t x = h;
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdull;
+  x ^= x >> 33;
+  return static_cast<std::size_t>(x);
+#endif
+}
+
+// 哈希与相等比较都声明了 is_transparent 时，查找接口接受任意可比较的键类型
+template <typename Hash, typename Eq>
+inline constexpr bool is_transparent_v = requires {
+  typename Hash::is_transparent;
+  typename Eq::is_transparent;
+};
+
+// 透明时 key_arg<K2> 就是 K2（可推导），否则固定为 key_type，调用处走隐式转换
+template <bool Transparent>
+struct key_arg_impl {
+  template <typename K2, typename Key>
+  using type = Key;
+};
+template <>
+struct key_arg_impl<true> {
+  template <typename K2, typename Key>
+  using type = K2;
+};
+
+// 集合：元素就是键
+template <typename K>
+struct set_policy {
+  using key_type = K;
+  using value_type = K;
+  static constexpr bool is_set = true;
+  static constexpr bool nothrow_transfer = std::is_nothrow_move_constructible_v<K>;
+  static constexpr bool trivially_relocatable = is_trivially_relocatable_v<K>;
+
+  static const K& key(const value_type& v) noexcept { return v; }
+
+  template <typename Alloc>
+  static void transfer(Alloc& alloc, value_type* dst, value_type* src) noexcept {
+    std::allocator_traits<Alloc>::construct(alloc, dst, std::move(*src));
+    std::allocator_traits<Alloc>::destroy(alloc, src);
+  }
+};
+
+// 映射：元素是 pair<const K, V>。搬动槽位时源对象马上析构，键按右值取出，避免拷贝
+template <typename K, typename V>
+struct map_policy {
+  using key_type = K;
+  using value_type = std::pair<const K, V>;
+  static constexpr bool is_set = false;
+  static constexpr bool nothrow_transfer =
+      std::is_nothrow_move_constructible_v<K> && std::is_nothrow_move_constructible_v<V>;
+  static constexpr bool trivially_relocatable = is_trivially_relocatable_v<K> && is_trivially_relocatable_v<V>;
+
+  static const K& key(const value_type& v) noexcept { return v.first; }
+
+  template <typename Alloc>
+  static void transfer(Alloc& alloc, value_type* dst, value_type* src) noexcept {
+    std::allocator_traits<Alloc>::construct(alloc, dst, std::piecewise_construct,
+                                            std::forward_as_tuple(std::move(const_cast<K&>(src->first))),
+                                            std::forward_as_tuple(std::move(src->second)));
+    std::allocator_traits<Alloc>::destroy(alloc, src);
+  }
+};
+
+}  // namespace hash_table_detail
+
+/*============ 开放寻址哈希表 ============*/
+// flat_hash_set / flat_hash_map 的公共实现，SwissTable 式的扁平布局：
+// - 元素直接存放在一个槽位数组里，另有一个控制字节数组；两者一次分配
+// - 查找时把哈希值拆成 H1（定位起始槽）和 H2（7 位指纹），一次用 SIMD 比较一组控制字节的指纹，
+//   指纹相同才去比较键；组内出现空位即可断定不存在，绝大多数查找只碰一组控制字节和一次键比较
+// - 线性探测且不回绕：[0, capacity) 是起始槽的范围，其后跟一段溢出区，再后面是一组哨兵。
+//   元素只会落在起始槽之后，簇不会跨越表尾
+// - 删除不留墓碑：把同一簇里后面的元素往前挪填补空位（backward shift），表里只有满槽和空槽，
+//   删除再多也不会让查找变慢，也不需要为清理墓碑而重建。元素只会向低地址移动，
+//   因此 erase(it) 返回的迭代器继续向后遍历时不会重复或漏掉元素
+// - 最大负载 7/8；溢出区被簇占满时（极少见，或哈希函数很差）加倍溢出区而不是加倍容量
+//
+// 插入、rehash 和删除都会移动元素，迭代器、指针、引用随之失效（std::unordered_map 的节点地址是稳定的）。
+// 元素的移动构造须为 noexcept，哈希函数不应抛异常。
+template <typename Policy, typename Hash, typename Eq, typename Alloc>
+class raw_hash_table {
+  using ctrl_t = hash_table_detail::ctrl_t;
+  using group = hash_table_detail::group;
+  using AllocTraits = std::allocator_traits<Alloc>;
+
+  static_assert(std::is_same_v<typename AllocTraits::value_type, typename Policy::value_type>,
+                "raw_hash_table: allocator value_type must match the element type");
+  static_assert(Policy::nothrow_transfer || Policy::trivially_relocatable,
+                "raw_hash_table: elements must be nothrow move constructible");
+
+  static constexpr bool _S_transparent = hash_table_detail::is_transparent_v<Hash, Eq>;
+
+protected:
+  template <typename K2>
+  using key_arg =
+      typename hash_table_detail::key_arg_impl<_S_transparent>::template type<K2, typename Policy::key_type>;
+
+public:
+  /*============ 类型定义 ============*/
+  using key_type = typename Policy::key_type;
+  using value_type = typename Policy::value_type;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using hasher = Hash;
+  using key_equal = Eq;
+  using allocator_type = Alloc;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+
+  /*============ 迭代器定义 ============*/
+  // 记录 (控制字节指针, 槽位指针)；++ 时按组跳过空位，停在下一个满槽或表尾的哨兵上
+  template <bool Const>
+  class table_iterator {
+    friend class raw_hash_table;
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename Policy::value_type;
+    using difference_type = std::ptrdiff_t;
+    // 集合的元素就是键，不允许通过迭代器修改
+    using reference = std::conditional_t<Const || Policy::is_set, const value_type&, value_type&>;
+    using pointer = std::conditional_t<Const || Policy::is_set, const value_type*, value_type*>;
+
+    table_iterator() = default;
+    table_iterator(const table_iterator&) = default;
+    table_iterator& operator=(const table_iterator&) = default;
+    table_iterator(const table_iterator<false>& it) requires Const  // 非 const -> const
+        : _M_ctrl(it._M_ctrl), _M_slot(it._M_slot) {}
+
+    reference operator*() const { return *_M_slot; }
+    pointer operator->() const { return _M_slot; }
+
+    table_iterator& operator++() {
+      ++_M_ctrl;
+      ++_M_slot;
+      _M_skip_empty();
+      return *this;
+    }
+    table_iterator operator++(int) {
+      table_iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    friend bool operator==(const table_iterator& a, const table_iterator& b) { return a._M_ctrl == b._M_ctrl; }
+
+  private:
+    friend class table_iterator<true>;
+
+    table_iterator(const ctrl_t* c, value_type* s) : _M_ctrl(c), _M_slot(s) {}
+
+    void _M_skip_empty() noexcept {
+      for (;;) {
+        if (auto m = group(_M_ctrl).match_non_empty()) {
+          _M_ctrl += m.lowest();
+          _M_slot += m.lowest();
+          return;
+        }
+        _M_ctrl += group::width;
+        _M_slot += group::width;
+      }
+    }
+
+    const ctrl_t* _M_ctrl = nullptr;
+    value_type* _M_slot = nullptr;
+  };
+
+  using iterator = table_iterator<false>;
+  using const_iterator = table_iterator<true>;
+
+  /*============ 构造/析构 ============*/
+  // 空表不分配内存，控制字节指向共享的哨兵组
+  raw_hash_table() noexcept(noexcept(Hash()) && noexcept(Eq()) && noexcept(Alloc())) : raw_hash_table(0) {}
+
+  explicit raw_hash_table(size_type bucket_count, const Hash& hash = Hash(), const Eq& eq = Eq(),
+                          const Alloc& alloc = Alloc())
+      : _M_hasher(hash), _M_eq(eq), _M_alloc(alloc) {
+    if (bucket_count) _M_resize(_S_capacity_for(bucket_count), 0);
+  }
+
+  explicit raw_hash_table(const Alloc& alloc) : raw_hash_table(0, Hash(), Eq(), alloc) {}
+
+  raw_hash_table(const raw_hash_table& other)
+      : _M_hasher(other._M_hasher),
+        _M_eq(other._M_eq),
+        _M_alloc(AllocTraits::select_on_container_copy_construction(other._M_alloc)) {
+    _M_copy_from(other);
+  }
+
+  raw_hash_table(raw_hash_table&& other) noexcept
+      : _M_hasher(std::move(other._M_hasher)), _M_eq(std::move(other._M_eq)), _M_alloc(other._M_alloc) {
+    _M_take(other);
+  }
+
+  raw_hash_table& operator=(const raw_hash_table& other) {
+    if (this == &other) return *this;
+    _M_release();
+    if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) _M_alloc = other._M_alloc;
+    _M_hasher = other._M_hasher;
+    _M_eq = other._M_eq;
+    _M_copy_from(other);
+    return *this;
+  }
+
+  // 分配器会传播或两边相等时直接接管整张表，否则逐个移动元素
+  raw_hash_table& operator=(raw_hash_table&& other) {
+    if (this == &other) return *this;
+    _M_release();
+    _M_hasher = std::move(other._M_hasher);
+    _M_eq = std::move(other._M_eq);
+    if (_M_can_steal(other)) {
+      if constexpr (AllocTraits::propagate_on_container_move_assignment::value) _M_alloc = other._M_alloc;
+      _M_take(other);
+    } else {
+      reserve(other.size());
+      for (auto& v : other) _M_emplace_key(Policy::key(v), std::move(v));
+      other.clear();
+    }
+    return *this;
+  }
+
+  ~raw_hash_table() { _M_release(); }
+
+  void swap(raw_hash_table& other) noexcept {
+    using std::swap;
+    swap(_M_ctrl, other._M_ctrl);
+    swap(_M_slots, other._M_slots);
+    swap(_M_mask, other._M_mask);
+    swap(_M_total, other._M_total);
+    swap(_M_size, other._M_size);
+    swap(_M_growth_left, other._M_growth_left);
+    swap(_M_hasher, other._M_hasher);
+    swap(_M_eq, other._M_eq);
+    if constexpr (AllocTraits::propagate_on_container_swap::value) swap(_M_alloc, other._M_alloc);
+  }
+
+  allocator_type get_allocator() const { return _M_alloc; }
+  hasher hash_function() const { return _M_hasher; }
+  key_equal key_eq() const { return _M_eq; }
+
+  /*============ 迭代器接口 ============*/
+  iterator begin() noexcept { return _M_iterator_at(0); }
+  const_iterator begin() const noexcept { return const_cast<raw_hash_table*>(this)->begin(); }
+  const_iterator cbegin() const noexcept { return begin(); }
+  iterator end() noexcept { return iterator(_M_ctrl + _M_total, _M_slots + _M_total); }
+  const_iterator end() const noexcept { return const_cast<raw_hash_table*>(this)->end(); }
+  const_iterator cend() const noexcept { return end(); }
+
+  /*============ 容量接口 ============*/
+  bool empty() const noexcept { return _M_size == 0; }
+  size_type size() const noexcept { return _M_size; }
+  size_type max_size() const noexcept { return AllocTraits::max_size(_M_alloc) / 2; }
+
+  // 起始槽的个数（不含溢出区），与 std::unordered_map 的桶数对应
+  size_type bucket_count() const noexcept { return _M_total ? _M_mask + 1 : 0; }
+  float load_factor() const noexcept { return _M_total ? static_cast<float>(_M_size) / bucket_count() : 0.0f; }
+  float max_load_factor() const noexcept { return 0.875f; }
+
+  // 保证再插入到 count 个元素之前不会 rehash
+  void reserve(size_type count) {
+    if (count > _M_size + _M_growth_left) _M_resize(_S_capacity_for(count), 0);
+  }
+
+  // 桶数调整到至少 count 且能容纳现有元素；count 为 0 且表空时释放内存
+  void rehash(size_type count) {
+    if (count == 0 && _M_size == 0) {
+      _M_release();
+      return;
+    }
+    size_type cap = std::max(_S_capacity_for(_M_size), count ? std::bit_ceil(count) : 0);
+    if (cap != bucket_count()) _M_resize(cap, 0);
+  }
+
+  /*============ 查找 ============*/
+  // 哈希与相等比较都透明时接受任意可比较的键，比如对 string 键直接用 string_view 或字面量查找
+  template <typename K2 = key_type>
+  iterator find(const key_arg<K2>& key) {
+    size_type i = _M_find(key, _M_hash(key));
+    return i == npos ? end() : _M_iterator_exact(i);
+  }
+  template <typename K2 = key_type>
+  const_iterator find(const key_arg<K2>& key) const {
+    return const_cast<raw_hash_table*>(this)->find(key);
+  }
+
+  template <typename K2 = key_type>
+  bool contains(const key_arg<K2>& key) const {
+    return _M_find(key, _M_hash(key)) != npos;
+  }
+  template <typename K2 = key_type>
+  size_type count(const key_arg<K2>& key) const {
+    return contains(key);
+  }
+
+  /*============ 删除 ============*/
+  // 返回下一个元素：被挪进当前槽位的元素（尚未遍历到）或后面第一个满槽
+  iterator erase(const_iterator pos) {
+    size_type i = pos._M_ctrl - _M_ctrl;
+    _M_erase_at(i);
+    return _M_iterator_at(i);
+  }
+  iterator erase(iterator pos) { return erase(const_iterator(pos)); }
+
+  // 先析构整段并标为空，再让后面同一簇的元素重新落位
+  iterator erase(const_iterator first, const_iterator last) {
+    size_type lo = first._M_ctrl - _M_ctrl, hi = last._M_ctrl - _M_ctrl;
+    if (lo == hi) return _M_iterator_exact(lo);
+    for (size_type i = lo; i < hi; ++i) {
+      if (_M_ctrl[i] < 0) continue;
+      AllocTraits::destroy(_M_alloc, _M_slots + i);
+      _M_ctrl[i] = hash_table_detail::ctrl_empty;
+      --_M_size;
+      ++_M_growth_left;
+    }
+    _M_close_gaps(hi);
+    return _M_iterator_at(lo);
+  }
+
+  template <typename K2 = key_type>
+  size_type erase(const key_arg<K2>& key) {
+    size_type i = _M_find(key, _M_hash(key));
+    if (i == npos) return 0;
+    _M_erase_at(i);
+    return 1;
+  }
+
+  // 析构所有元素，保留容量
+  void clear() noexcept {
+    if (!_M_total) return;
+    _M_destroy_all();
+    std::memset(_M_ctrl, static_cast<unsigned char>(hash_table_detail::ctrl_empty), _M_total);
+    _M_size = 0;
+    _M_growth_left = _S_growth(_M_mask + 1);
+  }
+
+  /*============ 操作符重载 ============*/
+  // 大小相同且每个元素都能在对方找到相等的元素（映射还要比较值）
+  friend bool operator==(const raw_hash_table& lhs, const raw_hash_table& rhs) {
+    if (lhs.size() != rhs.size()) return false;
+    for (const auto& v : lhs) {
+      auto it = rhs.find(Policy::key(v));
+      if (it == rhs.end() || !(*it == v)) return false;
+    }
+    return true;
+  }
+
+protected:
+  static constexpr size_type npos = static_cast<size_type>(-1);
+
+  // 查找 key；不存在时在探测序列的第一个空位上登记一个满槽，调用方随后在该槽位构造元素。
+  // 返回 (下标, 是否新登记)
+  template <typename K2>
+  std::pair<size_type, bool> _M_find_or_prepare_insert(const K2& key) {
+    const std::size_t h = _M_hash(key);
+    const ctrl_t h2 = _S_h2(h);
+    for (size_type pos = _S_h1(h) & _M_mask;; pos += group::width) {
+      group g(_M_ctrl + pos);
+      for (auto m = g.match(h2); m; m.clear_lowest()) {
+        size_type i = pos + m.lowest();
+        if (_M_eq(Policy::key(_M_slots[i]), key)) return {i, false};
+      }
+      // 线性探测：键不在表中时，这一组的第一个空位就是从起始槽往后的第一个空位
+      if (auto e = g.match_empty()) {
+        if (_M_growth_left > 0) [[likely]]
+          return {_M_occupy(pos + e.lowest(), h2), true};
+        break;
+      }
+      if (g.match_special()) break;  // 碰到表尾哨兵，溢出区已用完
+    }
+    return {_M_occupy(_M_prepare_insert_slow(h), h2), true};
+  }
+
+  // 查找 key，不存在则在登记的槽位上用 args 构造元素；构造抛异常时撤销登记
+  template <typename K2, typename... Args>
+  std::pair<iterator, bool> _M_emplace_key(const K2& key, Args&&... args) {
+    auto [i, inserted] = _M_find_or_prepare_insert(key);
+    if (inserted) {
+      try {
+        AllocTraits::construct(_M_alloc, _M_slots + i, std::forward<Args>(args)...);
+      } catch (...) {
+        _M_ctrl[i] = hash_table_detail::ctrl_empty;  // 登记前就是空位，恢复原样不破坏探测不变式
+        --_M_size;
+        ++_M_growth_left;
+        throw;
+      }
+    }
+    return {_M_iterator_exact(i), inserted};
+  }
+
+  template <typename K2>
+  size_type _M_find(const K2& key, std::size_t h) const {
+    const ctrl_t h2 = _S_h2(h);
+    for (size_type pos = _S_h1(h) & _M_mask;; pos += group::width) {
+      group g(_M_ctrl + pos);
+      for (auto m = g.match(h2); m; m.clear_lowest()) {
+        size_type i = pos + m.lowest();
+        if (_M_eq(Policy::key(_M_slots[i]), key)) [[likely]]
+          return i;
+      }
+      if (g.match_special()) [[likely]]
+        return npos;
+    }
+  }
+
+  iterator _M_iterator_exact(size_type i) noexcept { return iterator(_M_ctrl + i, _M_slots + i); }
+
+private:
+  /*============ 内存管理 ============*/
+  using IndexAlloc = typename AllocTraits::template rebind_alloc<size_type>;
+  using IndexTraits = std::allocator_traits<IndexAlloc>;
+
+  // pair<const K, V> 本身不是平凡可复制的，按键和值分别判断能否直接搬比特位
+  static constexpr bool _S_bitwise_relocate =
+      Policy::trivially_relocatable && alloc_has_trivial_construct_v<Alloc, value_type>;
+  static constexpr size_type _S_min_capacity = 8;
+  static constexpr size_type _S_max_overflow = 32;
+
+  // 槽位数组和控制字节数组的一次分配
+  struct storage {
+    ctrl_t* ctrl;
+    value_type* slots;
+    size_type mask;
+    size_type total;
+  };
+
+  static std::size_t _S_h1(std::size_t h) noexcept { return h >> 7; }
+  static ctrl_t _S_h2(std::size_t h) noexcept { return static_cast<ctrl_t>(h & 0x7f); }
+
+  // 容量 cap 时最多容纳的元素数：负载上限 7/8
+  static size_type _S_growth(size_type cap) noexcept { return cap - cap / 8; }
+
+  static size_type _S_capacity_for(size_type count) noexcept {
+    size_type cap = _S_min_capacity;
+    while (_S_growth(cap) < count) cap *= 2;
+    return cap;
+  }
+
+  // total 个槽位之后紧跟 total + group::width 个控制字节，按 value_type 为单位分配
+  static size_type _S_alloc_units(size_type total) noexcept {
+    return total + (total + group::width + sizeof(value_type) - 1) / sizeof(value_type);
+  }
+
+  template <typename K2>
+  std::size_t _M_hash(const K2& key) const {
+    return hash_table_detail::mix(_M_hasher(key));
+  }
+
+  size_type _M_home(const value_type& v) const { return _S_h1(_M_hash(Policy::key(v))) & _M_mask; }
+
+  storage _M_allocate(size_type cap, size_type overflow) {
+    size_type total = cap + overflow;
+    value_type* slots = AllocTraits::allocate(_M_alloc, _S_alloc_units(total));
+    ctrl_t* ctrl = reinterpret_cast<ctrl_t*>(slots + total);
+    std::memset(ctrl, static_cast<unsigned char>(hash_table_detail::ctrl_empty), total);
+    std::memset(ctrl + total, static_cast<unsigned char>(hash_table_detail::ctrl_sentinel), group::width);
+    return {ctrl, slots, cap - 1, total};
+  }
+
+  void _M_deallocate(const storage& s) noexcept { AllocTraits::deallocate(_M_alloc, s.slots, _S_alloc_units(s.total)); }
+
+  // 从起始槽 home 往后找第一个空位；碰到哨兵返回 npos
+  static size_type _S_find_free(const ctrl_t* ctrl, size_type home) noexcept {
+    for (size_type pos = home;; pos += group::width) {
+      group g(ctrl + pos);
+      if (auto e = g.match_empty()) return pos + e.lowest();
+      if (g.match_special()) return npos;
+    }
+  }
+
+  size_type _M_occupy(size_type i, ctrl_t h2) noexcept {
+    _M_ctrl[i] = h2;
+    ++_M_size;
+    --_M_growth_left;
+    return i;
+  }
+
+  // 找不到可用空位：满了就加倍容量，否则是溢出区被占满，加倍溢出区
+  size_type _M_prepare_insert_slow(std::size_t h) {
+    size_type cap = bucket_count();
+    if (_M_growth_left == 0)
+      _M_resize(cap ? cap * 2 : _S_min_capacity, 0);
+    else
+      _M_resize(cap, (_M_total - cap) * 2);
+    for (;;) {
+      size_type i = _S_find_free(_M_ctrl, _S_h1(h) & _M_mask);
+      if (i != npos) return i;
+      _M_resize(_M_mask + 1, (_M_total - _M_mask - 1) * 2);
+    }
+  }
+
+  // 重建为 cap 个起始槽、至少 overflow 个溢出槽的新表（overflow 为 0 表示默认大小）。
+  // 第一遍只算位置：每个元素在新表中的下标记在临时数组里，溢出区不够就加倍重来；
+  // 第二遍按记下的下标搬元素，不会失败。任何一步抛异常，原表都保持不变
+  void _M_resize(size_type cap, size_type overflow) {
+    if (overflow == 0) overflow = std::min(cap, _S_max_overflow);
+    IndexAlloc ia(_M_alloc);
+    size_type* dest = _M_size ? IndexTraits::allocate(ia, _M_size) : nullptr;
+    storage s{};
+    try {
+      for (;;) {
+        s = _M_allocate(cap, overflow);
+        if (_M_place_all(s, dest)) break;
+        _M_deallocate(s);
+        s.slots = nullptr;
+        overflow *= 2;
+      }
+    } catch (...) {
+      if (s.slots) _M_deallocate(s);
+      if (dest) IndexTraits::deallocate(ia, dest, _M_size);
+      throw;
+    }
+
+    if constexpr (_S_bitwise_relocate) {
+      for (size_type i = 0, k = 0; i < _M_total; ++i)
+        if (_M_ctrl[i] >= 0) std::memcpy(static_cast<void*>(s.slots + dest[k++]), _M_slots + i, sizeof(value_type));
+    } else {
+      for (size_type i = 0, k = 0; i < _M_total; ++i)
+        if (_M_ctrl[i] >= 0) Policy::transfer(_M_alloc, s.slots + dest[k++], _M_slots + i);
+    }
+    if (dest) IndexTraits::deallocate(ia, dest, _M_size);
+    if (_M_total) _M_deallocate({_M_ctrl, _M_slots, _M_mask, _M_total});
+    _M_ctrl = s.ctrl;
+    _M_slots = s.slots;
+    _M_mask = s.mask;
+    _M_total = s.total;
+    _M_growth_left = _S_growth(cap) - _M_size;
+  }
+
+  // 按原表的槽位顺序在新表 s 的控制字节上占位，下标依次写入 dest；溢出区不够时返回 false
+  bool _M_place_all(storage& s, size_type* dest) const {
+    for (size_type i = 0, k = 0; i < _M_total; ++i) {
+      if (_M_ctrl[i] < 0) continue;
+      std::size_t h = _M_hash(Policy::key(_M_slots[i]));
+      size_type j = _S_find_free(s.ctrl, _S_h1(h) & s.mask);
+      if (j == npos) return false;
+      s.ctrl[j] = _S_h2(h);
+      dest[k++] = j;
+    }
+    return true;
+  }
+
+  // 把槽位 j 的元素搬到空槽 hole
+  void _M_move_slot(size_type hole, size_type j) noexcept {
+    if constexpr (_S_bitwise_relocate)
+      std::memcpy(static_cast<void*>(_M_slots + hole), _M_slots + j, sizeof(value_type));
+    else
+      Policy::transfer(_M_alloc, _M_slots + hole, _M_slots + j);
+    _M_ctrl[hole] = _M_ctrl[j];
+  }
+
+  // backward shift：往后扫描同一簇，起始槽不在 (hole, j] 之内的元素挪进空位，空位随之后移，直到簇尾
+  void _M_erase_at(size_type i) {
+    AllocTraits::destroy(_M_alloc, _M_slots + i);
+    --_M_size;
+    ++_M_growth_left;
+    size_type hole = i;
+    for (size_type j = i + 1; _M_ctrl[j] >= 0; ++j) {
+      if (_M_home(_M_slots[j]) <= hole) {
+        _M_move_slot(hole, j);
+        hole = j;
+      }
+    }
+    _M_ctrl[hole] = hash_table_detail::ctrl_empty;
+  }
+
+  // 一次留下多个空位后使用：从 j 开始直到簇尾，每个元素挪到从其起始槽往后的第一个空位
+  void _M_close_gaps(size_type j) {
+    for (; _M_ctrl[j] >= 0; ++j) {
+      size_type home = _M_home(_M_slots[j]);
+      if (home == j) continue;
+      size_type free = _S_find_free(_M_ctrl, home);
+      if (free < j) {
+        _M_move_slot(free, j);
+        _M_ctrl[j] = hash_table_detail::ctrl_empty;
+      }
+    }
+  }
+
+  // 从下标 i 起第一个满槽的迭代器
+  iterator _M_iterator_at(size_type i) noexcept {
+    iterator it(_M_ctrl + i, _M_slots + i);
+    it._M_skip_empty();
+    return it;
+  }
+
+  void _M_destroy_all() noexcept {
+    if constexpr (!std::is_trivially_destructible_v<value_type> ||
+                  !alloc_has_trivial_construct_v<Alloc, value_type>) {
+      for (size_type i = 0; i < _M_total; ++i)
+        if (_M_ctrl[i] >= 0) AllocTraits::destroy(_M_alloc, _M_slots + i);
+    }
+  }
+
+  // 析构所有元素并释放内存，回到不分配内存的空表
+  void _M_release() noexcept {
+    if (_M_total) {
+      _M_destroy_all();
+      _M_deallocate({_M_ctrl, _M_slots, _M_mask, _M_total});
+    }
+    _M_ctrl = hash_table_detail::empty_ctrl();
+    _M_slots = nullptr;
+    _M_mask = 0;
+    _M_total = 0;
+    _M_size = 0;
+    _M_growth_left = 0;
+  }
+
+  // 哈希函数相同，元素照搬到相同的槽位：拷贝控制字节，逐个拷贝构造满槽
+  void _M_copy_from(const raw_hash_table& other) {
+    if (!other._M_size) return;
+    size_type overflow = other._M_total - other._M_mask - 1;
+    storage s = _M_allocate(other._M_mask + 1, overflow);
+    std::memcpy(s.ctrl, other._M_ctrl, other._M_total);
+    size_type i = 0;
+    try {
+      for (; i < s.total; ++i)
+        if (s.ctrl[i] >= 0) AllocTraits::construct(_M_alloc, s.slots + i, other._M_slots[i]);
+    } catch (...) {
+      for (size_type k = 0; k < i; ++k)
+        if (s.ctrl[k] >= 0) AllocTraits::destroy(_M_alloc, s.slots + k);
+      _M_deallocate(s);
+      throw;
+    }
+    _M_ctrl = s.ctrl;
+    _M_slots = s.slots;
+    _M_mask = s.mask;
+    _M_total = s.total;
+    _M_size = other._M_size;
+    _M_growth_left = other._M_growth_left;
+  }
+
+  bool _M_can_steal(const raw_hash_table& other) const noexcept {
+    if constexpr (AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value)
+      return true;
+    else
+      return _M_alloc == other._M_alloc;
+  }
+
+  void _M_take(raw_hash_table& other) noexcept {
+    _M_ctrl = other._M_ctrl;
+    _M_slots = other._M_slots;
+    _M_mask = other._M_mask;
+    _M_total = other._M_total;
+    _M_size = other._M_size;
+    _M_growth_left = other._M_growth_left;
+    other._M_ctrl = hash_table_detail::empty_ctrl();
+    other._M_slots = nullptr;
+    other._M_mask = other._M_total = other._M_size = other._M_growth_left = 0;
+  }
+
+  /* 成员变量 */
+  ctrl_t* _M_ctrl = hash_table_detail::empty_ctrl();
+  value_type* _M_slots = nullptr;
+  size_type _M_mask = 0;         // 起始槽个数 - 1
+  size_type _M_total = 0;        // 起始槽 + 溢出区的槽位数，控制字节 [_M_total, _M_total + width) 是哨兵
+  size_type _M_size = 0;
+  size_type _M_growth_left = 0;  // 到负载上限之前还能插入的元素数
+  [[no_unique_address]] Hash _M_hasher;
+  [[no_unique_address]] Eq _M_eq;
+  [[no_unique_address]] Alloc _M_alloc;
+};
+
+/*============ 扁平哈希集合 ============*/
+template <typename K, typename Hash = hash<K>, typename Eq = equal_to<K>, typename Alloc = std::allocator<K>>
+class flat_hash_set : public raw_hash_table<hash_table_detail::set_policy<K>, Hash, Eq, Alloc> {
+  using base = raw_hash_table<hash_table_detail::set_policy<K>, Hash, Eq, Alloc>;
+
+public:
+  using typename base::const_iterator;
+  using typename base::iterator;
+  using typename base::size_type;
+  using typename base::value_type;
+
+  using base::base;
+
+  template <std::input_iterator InputIt>
+  flat_hash_set(InputIt first, InputIt last, size_type bucket_count = 0, const Hash& hash = Hash(),
+                const Eq& eq = Eq(), const Alloc& alloc = Alloc())
+      : base(bucket_count, hash, eq, alloc) {
+    insert(first, last);
+  }
+
+  flat_hash_set(std::initializer_list<K> ilist, size_type bucket_count = 0, const Hash& hash = Hash(),
+                const Eq& eq = Eq(), const Alloc& alloc = Alloc())
+      : flat_hash_set(ilist.begin(), ilist.end(), bucket_count, hash, eq, alloc) {}
+
+  flat_hash_set& operator=(std::initializer_list<K> ilist) {
+    this->clear();
+    insert(ilist);
+    return *this;
+  }
+
+  /*============ 插入 ============*/
+  std::pair<iterator, bool> insert(const K& key) { return this->_M_emplace_key(key, key); }
+  std::pair<iterator, bool> insert(K&& key) { return this->_M_emplace_key(key, std::move(key)); }
+
+  // 前向迭代器区间先按长度预留，重复元素多时会多预留一些
+  template <std::input_iterator InputIt>
+  void insert(InputIt first, InputIt last) {
+    if constexpr (std::forward_iterator<InputIt>)
+      this->reserve(this->size() + static_cast<size_type>(std::distance(first, last)));
+    for (; first != last; ++first) emplace(*first);
+  }
+  void insert(std::initializer_list<K> ilist) { insert(ilist.begin(), ilist.end()); }
+
+  // 参数本身就是一个键时直接查找；否则先构造出键才能算哈希，键已存在时临时对象直接丢弃
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    if constexpr (sizeof...(Args) == 1 && (std::is_same_v<std::remove_cvref_t<Args>, K> && ...)) {
+      return this->_M_emplace_key(args..., std::forward<Args>(args)...);
+    } else {
+      K key(std::forward<Args>(args)...);
+      return this->_M_emplace_key(key, std::move(key));
+    }
+  }
+
+  friend void swap(flat_hash_set& lhs, flat_hash_set& rhs) noexcept { lhs.swap(rhs); }
+};
+
+/*============ 扁平哈希映射 ============*/
+template <typename K, typename V, typename Hash = hash<K>, typename Eq = equal_to<K>,
+          typename Alloc = std::allocator<std::pair<const K, V>>>
+class flat_hash_map : public raw_hash_table<hash_table_detail::map_policy<K, V>, Hash, Eq, Alloc> {
+  using base = raw_hash_table<hash_table_detail::map_policy<K, V>, Hash, Eq, Alloc>;
+
+  template <typename K2>
+  using key_arg = typename base::template key_arg<K2>;
+
+public:
+  using mapped_type = V;
+  using typename base::const_iterator;
+  using typename base::iterator;
+  using typename base::size_type;
+  using typename base::value_type;
+
+  using base::base;
+
+  template <std::input_iterator InputIt>
+  flat_hash_map(InputIt first, InputIt last, size_type bucket_count = 0, const Hash& hash = Hash(),
+                const Eq& eq = Eq(), const Alloc& alloc = Alloc())
+      : base(bucket_count, hash, eq, alloc) {
+    insert(first, last);
+  }
+
+  flat_hash_map(std::initializer_list<value_type> ilist, size_type bucket_count = 0, const Hash& hash = Hash(),
+                const Eq& eq = Eq(), const Alloc& alloc = Alloc())
+      : flat_hash_map(ilist.begin(), ilist.end(), bucket_count, hash, eq, alloc) {}
+
+  flat_hash_map& operator=(std::initializer_list<value_type> ilist) {
+    this->clear();
+    insert(ilist);
+    return *this;
+  }
+
+  /*============ 元素访问 ============*/
+  V& operator[](const K& key) { return try_emplace(key).first->second; }
+  V& operator[](K&& key) { return try_emplace(std::move(key)).first->second; }
+
+  template <typename K2 = K>
+  V& at(const key_arg<K2>& key) {
+    auto it = this->find(key);
+    if (it == this->end()) throw std::out_of_range("flat_hash_map::at");
+    return it->second;
+  }
+  template <typename K2 = K>
+  const V& at(const key_arg<K2>& key) const {
+    return const_cast<flat_hash_map*>(this)->at(key);
+  }
+
+  /*============ 插入 ============*/
+  std::pair<iterator, bool> insert(const value_type& v) { return this->_M_emplace_key(v.first, v); }
+  std::pair<iterator, bool> insert(value_type&& v) { return this->_M_emplace_key(v.first, std::move(v)); }
+
+  template <typename P>
+    requires std::is_constructible_v<value_type, P&&>
+  std::pair<iterator, bool> insert(P&& v) {
+    return emplace(std::forward<P>(v));
+  }
+
+  template <std::input_iterator InputIt>
+  void insert(InputIt first, InputIt last) {
+    if constexpr (std::forward_iterator<InputIt>)
+      this->reserve(this->size() + static_cast<size_type>(std::distance(first, last)));
+    for (; first != last; ++first) emplace(*first);
+  }
+  void insert(std::initializer_list<value_type> ilist) { insert(ilist.begin(), ilist.end()); }
+
+  // 参数是一个元素或 (键, 值) 时直接用其中的键查找；
+  // 否则先在一个键可修改的 pair 里构造，找到空位后把键和值都移动进去
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    if constexpr (sizeof...(Args) == 1 && (std::is_same_v<std::remove_cvref_t<Args>, value_type> && ...)) {
+      return this->_M_emplace_key(args.first..., std::forward<Args>(args)...);
+    } else if constexpr (sizeof...(Args) == 2 && _S_first_is_key<Args...>) {
+      return _M_emplace_pair(std::forward<Args>(args)...);
+    } else {
+      std::pair<K, V> tmp(std::forward<Args>(args)...);
+      return this->_M_emplace_key(tmp.first, std::move(tmp.first), std::move(tmp.second));
+    }
+  }
+
+  // 键已存在时什么都不构造，args 也不会被移动
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const K& key, Args&&... args) {
+    return this->_M_emplace_key(key, std::piecewise_construct, std::forward_as_tuple(key),
+                                std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+    return this->_M_emplace_key(key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+                                std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const K& key, M&& obj) {
+    auto res = try_emplace(key, std::forward<M>(obj));
+    if (!res.second) res.first->second = std::forward<M>(obj);
+    return res;
+  }
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(K&& key, M&& obj) {
+    auto res = try_emplace(std::move(key), std::forward<M>(obj));
+    if (!res.second) res.first->second = std::forward<M>(obj);
+    return res;
+  }
+
+  friend void swap(flat_hash_map& lhs, flat_hash_map& rhs) noexcept { lhs.swap(rhs); }
+
+private:
+  template <typename A, typename... Rest>
+  static constexpr bool _S_first_is_key = std::is_same_v<std::remove_cvref_t<A>, K>;
+
+  template <typename KK, typename M>
+  std::pair<iterator, bool> _M_emplace_pair(KK&& key, M&& obj) {
+    return this->_M_emplace_key(key, std::forward<KK>(key), std::forward<M>(obj));
+  }
+};
+
+// 遍历中删除满足 pred 的元素；erase(it) 的返回值保证不重复、不遗漏
+template <typename K, typename Hash, typename Eq, typename Alloc, typename Pred>
+typename flat_hash_set<K, Hash, Eq, Alloc>::size_type erase_if(flat_hash_set<K, Hash, Eq, Alloc>& c, Pred pred) {
+  auto old = c.size();
+  for (auto it = c.begin(); it != c.end();) it = pred(*it) ? c.erase(it) : std::next(it);
+  return old - c.size();
+}
+
+template <typename K, typename V, typename Hash, typename Eq, typename Alloc, typename Pred>
+typename flat_hash_map<K, V, Hash, Eq, Alloc>::size_type erase_if(flat_hash_map<K, V, Hash, Eq, Alloc>& c,
+                                                                   Pred pred) {
+  auto old = c.size();
+  for (auto it = c.begin(); it != c.end();) it = pred(*it) ? c.erase(it) : std::next(it);
+  return old - c.size();
+}
+
+}  // namespace leistd
@@ -0,0 +1,794 @@
+#pragma once
+#include <algorithm>         // sort, stable_sort, unique, inplace_merge, equal
+#include <compare>
+#include <cstddef>           // size_t, ptrdiff_t
+#include <functional>        // less
+#include <initializer_list>
+#include <iterator>
+#include <memory>            // to_address
+#include <stdexcept>         // out_of_range, invalid_argument
+#include <type_traits>
+#include <utility>           // pair, move
+
+#include "search_lt.h"
+#include "vector.h"
+
+namespace leistd {
+
+// 标记输入已按比较器严格递增（有序且无重复），构造时跳过排序和去重
+struct sorted_unique_t {
+  explicit sorted_unique_t() = default;
+};
+inline constexpr sorted_unique_t sorted_unique{};
+
+namespace flat_tree_detail {
+
+// 比较器声明了 is_transparent 时，查找接口接受任意可比较的键类型
+template <typename Compare>
+inline constexpr bool is_transparent_v = requires { typename Compare::is_transparent; };
+
+// 透明时 key_arg<K2> 就是 K2（可推导），否则固定为 key_type，调用处走隐式转换
+template <bool Transparent>
+struct key_arg_impl {
+  template <typename K2, typename Key>
+  using type = Key;
+};
+template <>
+struct key_arg_impl<true> {
+  template <typename K2, typename Key>
+  using type = K2;
+};
+
+/*============ 无分支二分查找 ============*/
+// 直接用 search_lt.h 的无分支二分（表超出 L1 时带预取），换算成下标。返回第一个不小于 key 的下标
+template <typename T, typename Kx, typename Compare>
+std::size_t lower_bound_index(const T* first, std::size_t n, const Kx& key, const Compare& comp) {
+  return static_cast<std::size_t>(search_detail::lower_bound(first, static_cast<std::ptrdiff_t>(n), key, comp) - first);
+}
+
+// 第一个大于 key 的下标
+template <typename T, typename Kx, typename Compare>
+std::size_t upper_bound_index(const T* first, std::size_t n, const Kx& key, const Compare& comp) {
+  return static_cast<std::size_t>(search_detail::upper_bound(first, static_cast<std::ptrdiff_t>(n), key, comp) - first);
+}
+
+}  // namespace flat_tree_detail
+
+/*============ 有序扁平集合 ============*/
+// 元素按 Compare 升序存放在一个连续容器里：查找是对连续数组的无分支二分，遍历就是顺序扫描，没有节点和指针。
+// 适合读多写少的表。单个插入/删除要挪动其后的元素（O(n)）；批量插入把新元素追加到末尾，
+// 排序去重后与原有部分原地归并，整批只花 O(n + m log m)。
+// KeyContainer 须是连续存储的序列容器（默认 leistd::vector）
+template <typename K, typename Compare = std::less<K>, typename KeyContainer = vector<K>>
+class flat_set {
+  template <typename K2>
+  using key_arg =
+      typename flat_tree_detail::key_arg_impl<flat_tree_detail::is_transparent_v<Compare>>::template type<K2, K>;
+
+public:
+  /*============ 类型定义 ============*/
+  using key_type = K;
+  using value_type = K;
+  using key_compare = Compare;
+  using value_compare = Compare;
+  using container_type = KeyContainer;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  // 元素就是键，不允许通过迭代器修改：两种迭代器都是指向常量的指针
+  using iterator = const K*;
+  using const_iterator = const K*;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = reverse_iterator;
+
+  /*============ 构造 ============*/
+  flat_set() = default;
+  explicit flat_set(const Compare& comp) : _M_comp(comp) {}
+
+  // 接管一个任意顺序的容器：排序一次再去重
+  explicit flat_set(KeyContainer keys, const Compare& comp = Compare()) : _M_keys(std::move(keys)), _M_comp(comp) {
+    _M_merge_tail(0);
+  }
+  // 调用方保证 keys 严格递增
+  flat_set(sorted_unique_t, KeyContainer keys, const Compare& comp = Compare())
+      : _M_keys(std::move(keys)), _M_comp(comp) {}
+
+  template <std::input_iterator InputIt>
+  flat_set(InputIt first, InputIt last, const Compare& comp = Compare()) : _M_comp(comp) {
+    insert(first, last);
+  }
+  template <std::input_iterator InputIt>
+  flat_set(sorted_unique_t, InputIt first, InputIt last, const Compare& comp = Compare()) : _M_comp(comp) {
+    _M_append(first, last);
+  }
+
+  flat_set(std::initializer_list<K> ilist, const Compare& comp = Compare())
+      : flat_set(ilist.begin(), ilist.end(), comp) {}
+  flat_set(sorted_unique_t s, std::initializer_list<K> ilist, const Compare& comp = Compare())
+      : flat_set(s, ilist.begin(), ilist.end(), comp) {}
+
+  flat_set& operator=(std::initializer_list<K> ilist) {
+    clear();
+    insert(ilist);
+    return *this;
+  }
+
+  /*============ 迭代器 ============*/
+  iterator begin() const noexcept { return _M_data(); }
+  iterator end() const noexcept { return _M_data() + size(); }
+  iterator cbegin() const noexcept { return begin(); }
+  iterator cend() const noexcept { return end(); }
+  reverse_iterator rbegin() const noexcept { return reverse_iterator(end()); }
+  reverse_iterator rend() const noexcept { return reverse_iterator(begin()); }
+
+  /*============ 容量 ============*/
+  bool empty() const noexcept { return _M_keys.size() == 0; }
+  size_type size() const noexcept { return _M_keys.size(); }
+  void reserve(size_type n) { _M_keys.reserve(n); }
+  void clear() noexcept { _M_keys.clear(); }
+
+  /*============ 插入 ============*/
+  std::pair<iterator, bool> insert(const K& key) { return _M_insert_unique(key); }
+  std::pair<iterator, bool> insert(K&& key) { return _M_insert_unique(std::move(key)); }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    if constexpr (sizeof...(Args) == 1 && (std::is_same_v<std::remove_cvref_t<Args>, K> && ...)) {
+      return _M_insert_unique(std::forward<Args>(args)...);
+    } else {
+      return _M_insert_unique(K(std::forward<Args>(args)...));
+    }
+  }
+
+  // 批量插入：追加到末尾后整体归并，不是逐个 O(n) 插入；与已有元素相等的新元素被丢弃
+  template <std::input_iterator InputIt>
+  void insert(InputIt first, InputIt last) {
+    size_type mid = size();
+    _M_append(first, last);
+    _M_merge_tail(mid);
+  }
+  // 新元素已严格递增：排序那一步会被 is_sorted 识别出来跳过，归并照常进行
+  template <std::input_iterator InputIt>
+  void insert(sorted_unique_t, InputIt first, InputIt last) {
+    insert(first, last);
+  }
+  void insert(std::initializer_list<K> ilist) { insert(ilist.begin(), ilist.end()); }
+
+  /*============ 删除 ============*/
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+  iterator erase(const_iterator first, const_iterator last) {
+    size_type i = static_cast<size_type>(first - _M_data());
+    _M_keys.erase(_M_keys.begin() + i, _M_keys.begin() + (last - _M_data()));
+    return _M_data() + i;
+  }
+  template <typename K2 = K>
+  size_type erase(const key_arg<K2>& key) {
+    auto [lo, hi] = equal_range(key);
+    size_type n = static_cast<size_type>(hi - lo);
+    erase(lo, hi);
+    return n;
+  }
+
+  /*============ 查找 ============*/
+  template <typename K2 = K>
+  iterator find(const key_arg<K2>& key) const {
+    size_type i = _M_lower(key);
+    return i != size() && !_M_comp(key, _M_data()[i]) ? _M_data() + i : end();
+  }
+  template <typename K2 = K>
+  bool contains(const key_arg<K2>& key) const {
+    return find<K2>(key) != end();
+  }
+  template <typename K2 = K>
+  size_type count(const key_arg<K2>& key) const {
+    return contains<K2>(key) ? 1 : 0;
+  }
+  template <typename K2 = K>
+  iterator lower_bound(const key_arg<K2>& key) const {
+    return _M_data() + _M_lower(key);
+  }
+  template <typename K2 = K>
+  iterator upper_bound(const key_arg<K2>& key) const {
+    return _M_data() + flat_tree_detail::upper_bound_index(_M_data(), size(), key, _M_comp);
+  }
+  template <typename K2 = K>
+  std::pair<iterator, iterator> equal_range(const key_arg<K2>& key) const {
+    iterator lo = lower_bound<K2>(key);
+    return {lo, lo != end() && !_M_comp(key, *lo) ? lo + 1 : lo};
+  }
+
+  /*============ 底层容器 ============*/
+  key_compare key_comp() const { return _M_comp; }
+  value_compare value_comp() const { return _M_comp; }
+
+  // 取走底层容器，集合变空
+  KeyContainer extract() && {
+    KeyContainer keys(std::move(_M_keys));
+    _M_keys.clear();
+    return keys;
+  }
+  // 调用方保证 keys 严格递增
+  void replace(KeyContainer&& keys) { _M_keys = std::move(keys); }
+
+  void swap(flat_set& other) noexcept {
+    using std::swap;
+    swap(_M_keys, other._M_keys);
+    swap(_M_comp, other._M_comp);
+  }
+  friend void swap(flat_set& lhs, flat_set& rhs) noexcept { lhs.swap(rhs); }
+
+  friend bool operator==(const flat_set& a, const flat_set& b) {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+  }
+
+  template <typename K2, typename C2, typename KC2, typename Pred>
+  friend typename flat_set<K2, C2, KC2>::size_type erase_if(flat_set<K2, C2, KC2>& c, Pred pred);
+
+private:
+  K* _M_data() noexcept { return std::to_address(_M_keys.begin()); }
+  const K* _M_data() const noexcept { return std::to_address(_M_keys.begin()); }
+
+  template <typename Kx>
+  size_type _M_lower(const Kx& key) const {
+    return flat_tree_detail::lower_bound_index(_M_data(), size(), key, _M_comp);
+  }
+
+  template <typename KK>
+  std::pair<iterator, bool> _M_insert_unique(KK&& key) {
+    size_type i = _M_lower(key);
+    if (i != size() && !_M_comp(key, _M_data()[i])) return {_M_data() + i, false};
+    _M_keys.insert(_M_keys.begin() + i, std::forward<KK>(key));
+    return {_M_data() + i, true};
+  }
+
+  // 原样追加到末尾；构造元素抛异常时撤掉已追加的部分
+  template <typename InputIt>
+  void _M_append(InputIt first, InputIt last) {
+    size_type old = size();
+    if constexpr (std::forward_iterator<InputIt>)
+      _M_keys.reserve(old + static_cast<size_type>(std::distance(first, last)));
+    try {
+      for (; first != last; ++first) _M_keys.push_back(K(*first));
+    } catch (...) {
+      _M_keys.erase(_M_keys.begin() + old, _M_keys.end());
+      throw;
+    }
+  }
+
+  // [0, mid) 是原有的严格递增部分，[mid, size) 是新追加的任意元素。新元素排序去重后与原有部分原地归并；
+  // inplace_merge 是稳定的，相等时原有元素在前，再去重一次就保留了原有的。比较抛异常时集合被清空
+  void _M_merge_tail(size_type mid) {
+    auto equiv = [this](const K& a, const K& b) { return !_M_comp(a, b); };
+    try {
+      K* base = _M_data();
+      K* m = base + mid;
+      K* last = base + size();
+      if (!std::is_sorted(m, last, _M_comp)) std::sort(m, last, _M_comp);
+      last = std::unique(m, last, equiv);
+      // 新元素全部大于原有最大值（按序追加）时不必归并
+      if (mid != 0 && m != last && !_M_comp(m[-1], *m)) {
+        std::inplace_merge(base, m, last, _M_comp);
+        last = std::unique(base, last, equiv);
+      }
+      _M_keys.erase(_M_keys.begin() + (last - base), _M_keys.end());
+    } catch (...) {
+      clear();
+      throw;
+    }
+  }
+
+  KeyContainer _M_keys;
+  [[no_unique_address]] Compare _M_comp;
+};
+
+// 与 std::erase_if 一样放在命名空间作用域，leistd::erase_if(s, pred) 和 ADL 调用都可以。
+// 一趟压缩，不逐个调用 erase；pred 抛异常时集合被清空
+template <typename K, typename Compare, typename KeyContainer, typename Pred>
+typename flat_set<K, Compare, KeyContainer>::size_type erase_if(flat_set<K, Compare, KeyContainer>& c, Pred pred) {
+  K* base = c._M_data();
+  std::size_t n = c.size(), w = 0;
+  try {
+    for (std::size_t i = 0; i < n; ++i) {
+      if (pred(std::as_const(base[i]))) continue;
+      if (w != i) base[w] = std::move(base[i]);
+      ++w;
+    }
+  } catch (...) {
+    c.clear();
+    throw;
+  }
+  c._M_keys.erase(c._M_keys.begin() + w, c._M_keys.end());
+  return n - w;
+}
+
+/*============ 有序扁平映射 ============*/
+// 键和值分别存放在两个连续容器里（同一下标对应同一元素）：二分查找只触碰键数组，
+// 值不会把键挤出缓存，对键小值大的表尤其划算。其余取舍同 flat_set。
+// 迭代器解引用得到 pair<const K&, V&> 形式的临时对象，而不是容器里存放的 pair
+template <typename K, typename V, typename Compare = std::less<K>, typename KeyContainer = vector<K>,
+          typename MappedContainer = vector<V>>
+class flat_map {
+  template <typename K2>
+  using key_arg =
+      typename flat_tree_detail::key_arg_impl<flat_tree_detail::is_transparent_v<Compare>>::template type<K2, K>;
+
+public:
+  /*============ 类型定义 ============*/
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = std::pair<K, V>;
+  using key_compare = Compare;
+  using reference = std::pair<const K&, V&>;
+  using const_reference = std::pair<const K&, const V&>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using key_container_type = KeyContainer;
+  using mapped_container_type = MappedContainer;
+
+  /*============ 迭代器定义 ============*/
+  // 记录 (键指针, 值指针)，两者同步移动
+  template <bool Const>
+  class pair_iterator {
+    friend class flat_map;
+    using mapped_ptr = std::conditional_t<Const, const V*, V*>;
+
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = flat_map::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::conditional_t<Const, flat_map::const_reference, flat_map::reference>;
+    // operator-> 返回一个持有 reference 的代理对象，it->second 可以直接读写值
+    struct pointer {
+      reference ref;
+      const reference* operator->() const noexcept { return &ref; }
+    };
+
+    pair_iterator() = default;
+    pair_iterator(const pair_iterator&) = default;
+    pair_iterator& operator=(const pair_iterator&) = default;
+    pair_iterator(const pair_iterator<false>& it) requires Const  // 非 const -> const
+        : _M_key(it._M_key), _M_val(it._M_val) {}
+
+    reference operator*() const { return {*_M_key, *_M_val}; }
+    pointer operator->() const { return {**this}; }
+    reference operator[](difference_type n) const { return {_M_key[n], _M_val[n]}; }
+
+    pair_iterator& operator++() {
+      ++_M_key;
+      ++_M_val;
+      return *this;
+    }
+    pair_iterator operator++(int) {
+      pair_iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+    pair_iterator& operator--() {
+      --_M_key;
+      --_M_val;
+      return *this;
+    }
+    pair_iterator operator--(int) {
+      pair_iterator tmp = *this;
+      --*this;
+      return tmp;
+    }
+    pair_iterator& operator+=(difference_type n) {
+      _M_key += n;
+      _M_val += n;
+      return *this;
+    }
+    pair_iterator& operator-=(difference_type n) { return *this += -n; }
+
+    friend pair_iterator operator+(pair_iterator it, difference_type n) { return it += n; }
+    friend pair_iterator operator+(difference_type n, pair_iterator it) { return it += n; }
+    friend pair_iterator operator-(pair_iterator it, difference_type n) { return it -= n; }
+    friend difference_type operator-(const pair_iterator& a, const pair_iterator& b) { return a._M_key - b._M_key; }
+    friend bool operator==(const pair_iterator& a, const pair_iterator& b) { return a._M_key == b._M_key; }
+    friend auto operator<=>(const pair_iterator& a, const pair_iterator& b) { return a._M_key <=> b._M_key; }
+
+  private:
+    friend class pair_iterator<true>;
+
+    pair_iterator(const K* k, mapped_ptr v) : _M_key(k), _M_val(v) {}
+
+    const K* _M_key = nullptr;
+    mapped_ptr _M_val = nullptr;
+  };
+
+  using iterator = pair_iterator<false>;
+  using const_iterator = pair_iterator<true>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  // extract() 的返回值
+  struct containers {
+    KeyContainer keys;
+    MappedContainer values;
+  };
+
+  /*============ 构造 ============*/
+  flat_map() = default;
+  explicit flat_map(const Compare& comp) : _M_comp(comp) {}
+
+  // 接管两个任意顺序、等长的容器：排序一次再去重，相等的键保留先出现的
+  flat_map(KeyContainer keys, MappedContainer values, const Compare& comp = Compare())
+      : _M_keys(std::move(keys)), _M_values(std::move(values)), _M_comp(comp) {
+    _M_check_sizes();
+    _M_sort_unique();
+  }
+  // 调用方保证 keys 严格递增
+  flat_map(sorted_unique_t, KeyContainer keys, MappedContainer values, const Compare& comp = Compare())
+      : _M_keys(std::move(keys)), _M_values(std::move(values)), _M_comp(comp) {
+    _M_check_sizes();
+  }
+
+  template <std::input_iterator InputIt>
+  flat_map(InputIt first, InputIt last, const Compare& comp = Compare()) : _M_comp(comp) {
+    insert(first, last);
+  }
+  template <std::input_iterator InputIt>
+  flat_map(sorted_unique_t, InputIt first, InputIt last, const Compare& comp = Compare()) : _M_comp(comp) {
+    if constexpr (std::forward_iterator<InputIt>) reserve(static_cast<size_type>(std::distance(first, last)));
+    for (; first != last; ++first) {
+      value_type v(*first);
+      _M_keys.push_back(std::move(v.first));
+      _M_values.push_back(std::move(v.second));
+    }
+  }
+
+  flat_map(std::initializer_list<value_type> ilist, const Compare& comp = Compare())
+      : flat_map(ilist.begin(), ilist.end(), comp) {}
+  flat_map(sorted_unique_t s, std::initializer_list<value_type> ilist, const Compare& comp = Compare())
+      : flat_map(s, ilist.begin(), ilist.end(), comp) {}
+
+  flat_map& operator=(std::initializer_list<value_type> ilist) {
+    clear();
+    insert(ilist);
+    return *this;
+  }
+
+  /*============ 迭代器 ============*/
+  iterator begin() noexcept { return _M_iter(0); }
+  iterator end() noexcept { return _M_iter(size()); }
+  const_iterator begin() const noexcept { return _M_iter(0); }
+  const_iterator end() const noexcept { return _M_iter(size()); }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+  const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+  const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+  /*============ 容量 ============*/
+  bool empty() const noexcept { return _M_keys.size() == 0; }
+  size_type size() const noexcept { return _M_keys.size(); }
+  void reserve(size_type n) {
+    _M_keys.reserve(n);
+    _M_values.reserve(n);
+  }
+  void clear() noexcept {
+    _M_keys.clear();
+    _M_values.clear();
+  }
+
+  /*============ 元素访问 ============*/
+  V& operator[](const K& key) { return try_emplace(key).first->second; }
+  V& operator[](K&& key) { return try_emplace(std::move(key)).first->second; }
+
+  template <typename K2 = K>
+  V& at(const key_arg<K2>& key) {
+    size_type i = _M_find_index(key);
+    if (i == size()) throw std::out_of_range("flat_map::at");
+    return _M_vdata()[i];
+  }
+  template <typename K2 = K>
+  const V& at(const key_arg<K2>& key) const {
+    return const_cast<flat_map*>(this)->at<K2>(key);
+  }
+
+  /*============ 插入 ============*/
+  std::pair<iterator, bool> insert(const value_type& v) { return _M_try_emplace(v.first, v.second); }
+  std::pair<iterator, bool> insert(value_type&& v) { return _M_try_emplace(std::move(v.first), std::move(v.second)); }
+
+  template <typename P>
+    requires std::is_constructible_v<value_type, P&&>
+  std::pair<iterator, bool> insert(P&& v) {
+    return emplace(std::forward<P>(v));
+  }
+
+  // 批量插入：新元素按键稳定排序、去重，再与原数组线性归并，整批 O(n + m log m)。
+  // 批内相等的键保留先出现的，与已有键相等的新元素被丢弃
+  template <std::input_iterator InputIt>
+  void insert(InputIt first, InputIt last) {
+    vector<value_type> batch;
+    if constexpr (std::forward_iterator<InputIt>) batch.reserve(static_cast<size_type>(std::distance(first, last)));
+    for (; first != last; ++first) batch.push_back(value_type(*first));
+    _M_merge(batch);
+  }
+  template <std::input_iterator InputIt>
+  void insert(sorted_unique_t, InputIt first, InputIt last) {
+    insert(first, last);
+  }
+  void insert(std::initializer_list<value_type> ilist) { insert(ilist.begin(), ilist.end()); }
+
+  // 参数是 (键, 值) 时直接用其中的键查找；否则先构造出一个 pair
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    if constexpr (sizeof...(Args) == 2 && _S_first_is_key<Args...>) {
+      return _M_try_emplace(std::forward<Args>(args)...);
+    } else {
+      value_type tmp(std::forward<Args>(args)...);
+      return _M_try_emplace(std::move(tmp.first), std::move(tmp.second));
+    }
+  }
+
+  // 键已存在时什么都不构造，args 也不会被移动
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const K& key, Args&&... args) {
+    return _M_try_emplace(key, std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(K&& key, Args&&... args) {
+    return _M_try_emplace(std::move(key), std::forward<Args>(args)...);
+  }
+
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const K& key, M&& obj) {
+    auto res = try_emplace(key, std::forward<M>(obj));
+    if (!res.second) res.first->second = std::forward<M>(obj);
+    return res;
+  }
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(K&& key, M&& obj) {
+    auto res = try_emplace(std::move(key), std::forward<M>(obj));
+    if (!res.second) res.first->second = std::forward<M>(obj);
+    return res;
+  }
+
+  /*============ 删除 ============*/
+  // iterator 单独一个重载：透明比较器下 erase(key) 模板对 iterator 是精确匹配，不能让它抢走
+  iterator erase(iterator pos) { return erase(const_iterator(pos)); }
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+  iterator erase(const_iterator first, const_iterator last) {
+    size_type i = _M_index(first), j = _M_index(last);
+    _M_keys.erase(_M_keys.begin() + i, _M_keys.begin() + j);
+    _M_values.erase(_M_values.begin() + i, _M_values.begin() + j);
+    return _M_iter(i);
+  }
+  template <typename K2 = K>
+  size_type erase(const key_arg<K2>& key) {
+    size_type i = _M_find_index(key);
+    if (i == size()) return 0;
+    erase(_M_iter(i));
+    return 1;
+  }
+
+  /*============ 查找 ============*/
+  template <typename K2 = K>
+  iterator find(const key_arg<K2>& key) {
+    return _M_iter(_M_find_index(key));
+  }
+  template <typename K2 = K>
+  const_iterator find(const key_arg<K2>& key) const {
+    return _M_iter(_M_find_index(key));
+  }
+  template <typename K2 = K>
+  bool contains(const key_arg<K2>& key) const {
+    return _M_find_index(key) != size();
+  }
+  template <typename K2 = K>
+  size_type count(const key_arg<K2>& key) const {
+    return contains<K2>(key) ? 1 : 0;
+  }
+  template <typename K2 = K>
+  iterator lower_bound(const key_arg<K2>& key) {
+    return _M_iter(_M_lower(key));
+  }
+  template <typename K2 = K>
+  const_iterator lower_bound(const key_arg<K2>& key) const {
+    return _M_iter(_M_lower(key));
+  }
+  template <typename K2 = K>
+  iterator upper_bound(const key_arg<K2>& key) {
+    return _M_iter(_M_upper(key));
+  }
+  template <typename K2 = K>
+  const_iterator upper_bound(const key_arg<K2>& key) const {
+    return _M_iter(_M_upper(key));
+  }
+  template <typename K2 = K>
+  std::pair<iterator, iterator> equal_range(const key_arg<K2>& key) {
+    size_type i = _M_lower(key);
+    return {_M_iter(i), _M_iter(i != size() && !_M_comp(key, _M_kdata()[i]) ? i + 1 : i)};
+  }
+  template <typename K2 = K>
+  std::pair<const_iterator, const_iterator> equal_range(const key_arg<K2>& key) const {
+    auto [lo, hi] = const_cast<flat_map*>(this)->equal_range<K2>(key);
+    return {lo, hi};
+  }
+
+  /*============ 底层容器 ============*/
+  key_compare key_comp() const { return _M_comp; }
+  const KeyContainer& keys() const noexcept { return _M_keys; }
+  const MappedContainer& values() const noexcept { return _M_values; }
+
+  // 取走两个底层容器，映射变空
+  containers extract() && {
+    containers c{std::move(_M_keys), std::move(_M_values)};
+    clear();
+    return c;
+  }
+  // 调用方保证 keys 严格递增
+  void replace(KeyContainer&& keys, MappedContainer&& values) {
+    if (keys.size() != values.size()) throw std::invalid_argument("flat_map: keys and values differ in size");
+    _M_keys = std::move(keys);
+    _M_values = std::move(values);
+  }
+
+  void swap(flat_map& other) noexcept {
+    using std::swap;
+    swap(_M_keys, other._M_keys);
+    swap(_M_values, other._M_values);
+    swap(_M_comp, other._M_comp);
+  }
+  friend void swap(flat_map& lhs, flat_map& rhs) noexcept { lhs.swap(rhs); }
+
+  friend bool operator==(const flat_map& a, const flat_map& b) {
+    size_type n = a.size();
+    return n == b.size() && std::equal(a._M_kdata(), a._M_kdata() + n, b._M_kdata()) &&
+           std::equal(a._M_vdata(), a._M_vdata() + n, b._M_vdata());
+  }
+
+  template <typename K2, typename V2, typename C2, typename KC2, typename MC2, typename Pred>
+  friend typename flat_map<K2, V2, C2, KC2, MC2>::size_type erase_if(flat_map<K2, V2, C2, KC2, MC2>& c, Pred pred);
+
+private:
+  template <typename A, typename... Rest>
+  static constexpr bool _S_first_is_key = std::is_same_v<std::remove_cvref_t<A>, K>;
+
+  K* _M_kdata() noexcept { return std::to_address(_M_keys.begin()); }
+  const K* _M_kdata() const noexcept { return std::to_address(_M_keys.begin()); }
+  V* _M_vdata() noexcept { return std::to_address(_M_values.begin()); }
+  const V* _M_vdata() const noexcept { return std::to_address(_M_values.begin()); }
+
+  iterator _M_iter(size_type i) noexcept { return iterator(_M_kdata() + i, _M_vdata() + i); }
+  const_iterator _M_iter(size_type i) const noexcept { return const_iterator(_M_kdata() + i, _M_vdata() + i); }
+  size_type _M_index(const_iterator it) const noexcept { return static_cast<size_type>(it._M_key - _M_kdata()); }
+
+  template <typename Kx>
+  size_type _M_lower(const Kx& key) const {
+    return flat_tree_detail::lower_bound_index(_M_kdata(), size(), key, _M_comp);
+  }
+  template <typename Kx>
+  size_type _M_upper(const Kx& key) const {
+    return flat_tree_detail::upper_bound_index(_M_kdata(), size(), key, _M_comp);
+  }
+  // 找不到时返回 size()
+  template <typename Kx>
+  size_type _M_find_index(const Kx& key) const {
+    size_type i = _M_lower(key);
+    return i != size() && !_M_comp(key, _M_kdata()[i]) ? i : size();
+  }
+
+  void _M_check_sizes() const {
+    if (_M_keys.size() != _M_values.size()) throw std::invalid_argument("flat_map: keys and values differ in size");
+  }
+
+  // 先插键再插值；值构造抛异常时把键撤掉，映射保持原样
+  template <typename KK, typename... Args>
+  std::pair<iterator, bool> _M_try_emplace(KK&& key, Args&&... args) {
+    size_type i = _M_lower(key);
+    if (i != size() && !_M_comp(key, _M_kdata()[i])) return {_M_iter(i), false};
+    _M_keys.insert(_M_keys.begin() + i, std::forward<KK>(key));
+    try {
+      _M_values.insert(_M_values.begin() + i, V(std::forward<Args>(args)...));
+    } catch (...) {
+      _M_keys.erase(_M_keys.begin() + i);
+      throw;
+    }
+    return {_M_iter(i), true};
+  }
+
+  // 任意顺序的键值：已严格递增时什么都不做，否则配成 pair 后走批量插入的排序去重
+  void _M_sort_unique() {
+    size_type n = size(), i = 1;
+    const K* k = _M_kdata();
+    while (i < n && _M_comp(k[i - 1], k[i])) ++i;
+    if (i >= n) return;
+    vector<value_type> batch;
+    batch.reserve(n);
+    for (i = 0; i < n; ++i) batch.push_back(value_type(std::move(_M_kdata()[i]), std::move(_M_vdata()[i])));
+    clear();
+    _M_merge(batch);
+  }
+
+  // 批量插入的主体。新元素按键稳定排序、去重后：全部大于现有最大键时直接追加；
+  // 否则与原数组线性归并到一对新容器里，键相同时保留原有的。移动元素抛异常时映射被清空（同 std::flat_map）
+  void _M_merge(vector<value_type>& batch) {
+    value_type* b = std::to_address(batch.begin());
+    auto by_key = [this](const value_type& x, const value_type& y) { return _M_comp(x.first, y.first); };
+    auto equiv = [this](const value_type& x, const value_type& y) { return !_M_comp(x.first, y.first); };
+    size_type m = batch.size(), n = size();
+    try {
+      if (!std::is_sorted(b, b + m, by_key)) std::stable_sort(b, b + m, by_key);
+      m = static_cast<size_type>(std::unique(b, b + m, equiv) - b);
+      if (m == 0) return;
+
+      if (n == 0 || _M_comp(_M_kdata()[n - 1], b[0].first)) {
+        reserve(n + m);
+        for (size_type j = 0; j < m; ++j) {
+          _M_keys.push_back(std::move(b[j].first));
+          _M_values.push_back(std::move(b[j].second));
+        }
+        return;
+      }
+
+      KeyContainer keys;
+      MappedContainer values;
+      keys.reserve(n + m);
+      values.reserve(n + m);
+      K* ok = _M_kdata();
+      V* ov = _M_vdata();
+      size_type i = 0, j = 0;
+      while (i < n && j < m) {
+        if (_M_comp(b[j].first, ok[i])) {
+          keys.push_back(std::move(b[j].first));
+          values.push_back(std::move(b[j].second));
+          ++j;
+        } else {
+          if (!_M_comp(ok[i], b[j].first)) ++j;  // 键相同，丢弃新元素
+          keys.push_back(std::move(ok[i]));
+          values.push_back(std::move(ov[i]));
+          ++i;
+        }
+      }
+      for (; i < n; ++i) {
+        keys.push_back(std::move(ok[i]));
+        values.push_back(std::move(ov[i]));
+      }
+      for (; j < m; ++j) {
+        keys.push_back(std::move(b[j].first));
+        values.push_back(std::move(b[j].second));
+      }
+      _M_keys = std::move(keys);
+      _M_values = std::move(values);
+    } catch (...) {
+      clear();
+      throw;
+    }
+  }
+
+  KeyContainer _M_keys;
+  MappedContainer _M_values;
+  [[no_unique_address]] Compare _M_comp;
+};
+
+// pred 收到 const_reference，抛异常时映射被清空；其余同 flat_set 的 erase_if
+template <typename K, typename V, typename Compare, typename KeyContainer, typename MappedContainer, typename Pred>
+typename flat_map<K, V, Compare, KeyContainer, MappedContainer>::size_type erase_if(
+    flat_map<K, V, Compare, KeyContainer, MappedContainer>& c, Pred pred) {
+  using map_type = flat_map<K, V, Compare, KeyContainer, MappedContainer>;
+  K* keys = c._M_kdata();
+  V* values = c._M_vdata();
+  std::size_t n = c.size(), w = 0;
+  try {
+    for (std::size_t i = 0; i < n; ++i) {
+      if (pred(typename map_type::const_reference(keys[i], values[i]))) continue;
+      if (w != i) {
+        keys[w] = std::move(keys[i]);
+        values[w] = std::move(values[i]);
+      }
+      ++w;
+    }
+  } catch (...) {
+    c.clear();
+    throw;
+  }
+  c._M_keys.erase(c._M_keys.begin() + w, c._M_keys.end());
+  c._M_values.erase(c._M_values.begin() + w, c._M_values.end());
+  return n - w;
+}
+
+}  // namespace leistd
@@ -0,0 +1,55 @@
+#pragma once
+#include <algorithm>  // max
+#include <cstddef>    // size_t
+
+namespace leistd {
+
+/*============ 容器扩容策略 ============*/
+// 策略只需提供 static size_t grow(size_t cap, size_t need, size_t elem_size)，
+// 返回不小于 need 的新容量（单位：元素个数）。
+
+// 翻倍：扩容次数最少，但最多浪费一半内存，且释放的旧块永远装不下之后更大的请求
+struct growth_factor_2x {
+  static std::size_t grow(std::size_t cap, std::size_t need, std::size_t /*elem_size*/) {
+    return std::max(cap * 2, need);
+  }
+};
+
+// 1.5 倍：多扩容几次换更低的内存浪费，若干次扩容后之前释放的块之和能被复用
+struct growth_factor_1_5x {
+  static std::size_t grow(std::size_t cap, std::size_t need, std::size_t /*elem_size*/) {
+    return std::max(cap + cap / 2, need);
+  }
+};
+
+// 在 Base 的基础上，把超过一页的请求向上取整到整页，避免大块尾部的半页被白白浪费
+template <typename Base = growth_factor_2x, std::size_t PageSize = 4096>
+struct page_rounded_growth {
+  static std::size_t grow(std::size_t cap, std::size_t need, std::size_t elem_size) {
+    std::size_t n = Base::grow(cap, need, elem_size);
+    std::size_t bytes = n * elem_size;
+    if (bytes < PageSize) return n;
+    bytes = (bytes + PageSize - 1) / PageSize * PageSize;
+    return bytes / elem_size;
+  }
+};
+
+// 把请求字节数向上取整到 jemalloc 风格的尺寸等级（每个 2 的幂区间划分 4 档），
+// 分配器反正会给这么多，多出来的部分直接算进容量。glibc malloc 的 16 字节粒度也被这个划分覆盖。
+inline std::size_t malloc_size_class(std::size_t bytes) {
+  if (bytes <= 16) return 16;
+  std::size_t group = 1;
+  while (group * 2 < bytes) group *= 2;  // group < bytes <= 2 * group
+  std::size_t step = group / 4;
+  return (bytes + step - 1) / step * step;
+}
+
+template <typename Base = growth_factor_1_5x>
+struct size_class_growth {
+  static std::size_t grow(std::size_t cap, std::size_t need, std::size_t elem_size) {
+    std::size_t n = Base::grow(cap, need, elem_size);
+    return malloc_size_class(n * elem_size) / elem_size;
+  }
+};
+
+}  // namespace leistd
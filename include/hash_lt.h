@@ -0,0 +1,143 @@
+#pragma once
+#include <cstddef>      // size_t
+#include <cstdint>
+#include <functional>   // hash, equal_to
+#include <memory>       // allocator
+#include <utility>      // move
+
+#include "hash_bytes_lt.h"
+#include "string_lt.h"
+#include "string_view_lt.h"
+
+namespace leistd {
+
+/*============ 哈希与相等函数对象 ============*/
+// leistd::hash / leistd::equal_to 默认转发到 std 版本，是 leistd 哈希容器的默认参数。
+// leistd 的字符串类型另行特化：两者都按 basic_string_view 接收参数并声明 is_transparent，
+// 于是 flat_hash_map<string, V> 可以直接用 string_view 或字面量查找，不必先构造一个临时 string。
+template <typename T>
+struct hash : std::hash<T> {};
+
+template <typename T>
+struct equal_to : std::equal_to<T> {};
+
+namespace hash_detail {
+
+// 字符串哈希走 hash_bytes，可以带种子：hash<string>(seed) 交给容器即可让每张表用不同的哈希函数。
+// 默认种子 0，与 std::hash<leistd::basic_string> 的结果相同
+template <typename CharT, typename Traits>
+struct string_hash {
+  using is_transparent = void;
+
+  std::uint64_t seed = 0;
+
+  string_hash() = default;
+  explicit string_hash(std::uint64_t s) noexcept : seed(s) {}
+
+  // string、字面量都经隐式转换成视图
+  std::size_t operator()(basic_string_view<CharT, Traits> s) const noexcept {
+    return static_cast<std::size_t>(hash_bytes(s.data(), s.size() * sizeof(CharT), seed));
+  }
+};
+
+template <typename CharT, typename Traits>
+struct string_equal {
+  using is_transparent = void;
+
+  bool operator()(basic_string_view<CharT, Traits> a, basic_string_view<CharT, Traits> b) const noexcept {
+    return a == b;
+  }
+};
+
+}  // namespace hash_detail
+
+template <typename CharT, typename Traits, typename Alloc>
+struct hash<basic_string<CharT, Traits, Alloc>> : hash_detail::string_hash<CharT, Traits> {
+  using hash_detail::string_hash<CharT, Traits>::string_hash;
+};
+
+template <typename CharT, typename Traits>
+struct hash<basic_string_view<CharT, Traits>> : hash_detail::string_hash<CharT, Traits> {
+  using hash_detail::string_hash<CharT, Traits>::string_hash;
+};
+
+template <typename CharT, typename Traits, typename Alloc>
+struct equal_to<basic_string<CharT, Traits, Alloc>> : hash_detail::string_equal<CharT, Traits> {};
+
+template <typename CharT, typename Traits>
+struct equal_to<basic_string_view<CharT, Traits>> : hash_detail::string_equal<CharT, Traits> {};
+
+/*============ 缓存哈希值的字符串 ============*/
+// 构造时算一次哈希值（种子 0）存在对象里，内容此后不可修改。适合反复被哈希的键：
+// 哈希容器插入、rehash 以及 flat_hash_map 删除时挪动元素都要重算键的哈希，换成它只是读一个字段；
+// 相等比较先比哈希值，不同的键几乎都在这一步被排除，不必逐字符比较。
+// 哈希值与同内容的 string / string_view 一致，因此容器里的 hashed_string 键可以直接用 string_view 查找。
+template <typename CharT, typename Traits = char_traits<CharT>, typename Alloc = std::allocator<CharT>>
+class basic_hashed_string {
+public:
+  using string_type = basic_string<CharT, Traits, Alloc>;
+  using view_type = basic_string_view<CharT, Traits>;
+
+  basic_hashed_string() : basic_hashed_string(string_type()) {}
+  explicit basic_hashed_string(string_type s) noexcept : _M_str(std::move(s)), _M_hash(_S_hash(_M_str.view())) {}
+  explicit basic_hashed_string(view_type sv) : basic_hashed_string(string_type(sv)) {}
+  explicit basic_hashed_string(const CharT* s) : basic_hashed_string(view_type(s)) {}
+
+  const string_type& str() const noexcept { return _M_str; }
+  view_type view() const noexcept { return _M_str.view(); }
+  operator view_type() const noexcept { return view(); }
+  // 只读：c_str() 会写终止符，共享的 const 键在多个线程里同时访问会产生数据竞争
+  const CharT* data() const noexcept { return _M_str.view().data(); }
+  std::size_t size() const noexcept { return _M_str.size(); }
+  bool empty() const noexcept { return _M_str.size() == 0; }
+
+  std::size_t hash() const noexcept { return _M_hash; }
+
+  friend bool operator==(const basic_hashed_string& a, const basic_hashed_string& b) noexcept {
+    return a._M_hash == b._M_hash && a.view() == b.view();
+  }
+
+private:
+  static std::size_t _S_hash(view_type sv) noexcept {
+    return static_cast<std::size_t>(hash_bytes(sv.data(), sv.size() * sizeof(CharT)));
+  }
+
+  string_type _M_str;
+  std::size_t _M_hash;
+};
+
+using hashed_string = basic_hashed_string<char>;
+
+// 对 hashed_string 直接返回缓存值；对视图现算，结果一致
+template <typename CharT, typename Traits, typename Alloc>
+struct hash<basic_hashed_string<CharT, Traits, Alloc>> {
+  using is_transparent = void;
+
+  std::size_t operator()(const basic_hashed_string<CharT, Traits, Alloc>& s) const noexcept { return s.hash(); }
+  std::size_t operator()(basic_string_view<CharT, Traits> s) const noexcept {
+    return static_cast<std::size_t>(hash_bytes(s.data(), s.size() * sizeof(CharT)));
+  }
+};
+
+template <typename CharT, typename Traits, typename Alloc>
+struct equal_to<basic_hashed_string<CharT, Traits, Alloc>> {
+  using is_transparent = void;
+
+  bool operator()(const basic_hashed_string<CharT, Traits, Alloc>& a,
+                  const basic_hashed_string<CharT, Traits, Alloc>& b) const noexcept {
+    return a == b;
+  }
+  bool operator()(const basic_hashed_string<CharT, Traits, Alloc>& a,
+                  basic_string_view<CharT, Traits> b) const noexcept {
+    return a.view() == b;
+  }
+};
+
+}  // namespace leistd
+
+template <typename CharT, typename Traits, typename Alloc>
+struct std::hash<leistd::basic_hashed_string<CharT, Traits, Alloc>> {
+  std::size_t operator()(const leistd::basic_hashed_string<CharT, Traits, Alloc>& s) const noexcept {
+    return s.hash();
+  }
+};
@@ -0,0 +1,363 @@
+#pragma once
+#include <cassert>
+#include <cstddef>  // size_t, ptrdiff_t
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace leistd {
+
+/*============ 钩子 ============*/
+// 链接模式：
+// - normal：最省事，元素移出链表后钩子里残留旧指针，is_linked() 不可靠
+// - safe（默认）：移出链表时钩子被清空，is_linked() 可靠；把已链接的钩子再插入、或销毁仍在链表中的对象会触发断言
+// - auto_unlink：对象析构时自动从所在链表摘下，也可以随时调用 unlink()；链表因此无法维护长度，size() 为 O(n)
+enum class link_mode { normal, safe, auto_unlink };
+
+namespace intrusive_detail {
+
+struct list_node {
+  list_node* prev = nullptr;
+  list_node* next = nullptr;
+};
+
+// 钩子成员在 T 中的偏移。成员指针不能直接交给 offsetof，借一块未构造的存储算一次，编译器会折叠成常量
+template <typename T, auto Member>
+std::ptrdiff_t member_offset() noexcept {
+  alignas(T) static const unsigned char probe[sizeof(T)] = {};
+  const T* p = reinterpret_cast<const T*>(probe);
+  return reinterpret_cast<const unsigned char*>(&(p->*Member)) - probe;
+}
+
+// 由钩子地址反推所在的对象
+template <typename T, auto Member, typename Hook>
+T* owner_of(Hook* hook) noexcept {
+  return reinterpret_cast<T*>(reinterpret_cast<unsigned char*>(hook) - member_offset<T, Member>());
+}
+
+}  // namespace intrusive_detail
+
+template <typename T, auto Member>
+class intrusive_list;
+
+// 嵌入到对象中的钩子。拷贝对象时钩子不跟着拷贝，新对象总是未链接的
+template <link_mode Mode = link_mode::safe>
+class basic_list_hook : private intrusive_detail::list_node {
+public:
+  static constexpr link_mode mode = Mode;
+
+  basic_list_hook() noexcept = default;
+  basic_list_hook(const basic_list_hook&) noexcept {}
+  basic_list_hook& operator=(const basic_list_hook&) noexcept { return *this; }
+
+  ~basic_list_hook() {
+    if constexpr (Mode == link_mode::auto_unlink)
+      unlink();
+    else if constexpr (Mode == link_mode::safe)
+      assert(!is_linked() && "intrusive_list: destroying an element that is still linked");
+  }
+
+  bool is_linked() const noexcept { return next != nullptr; }
+
+  // 从所在的链表摘下，O(1)。只有 auto_unlink 钩子提供：其余模式的链表要维护长度，必须通过链表 erase
+  void unlink() noexcept
+    requires(Mode == link_mode::auto_unlink)
+  {
+    if (!next) return;
+    prev->next = next;
+    next->prev = prev;
+    prev = next = nullptr;
+  }
+
+private:
+  template <typename, auto>
+  friend class intrusive_list;
+};
+
+using list_hook = basic_list_hook<link_mode::safe>;
+using auto_unlink_list_hook = basic_list_hook<link_mode::auto_unlink>;
+
+/*============ 侵入式双向链表 ============*/
+// 与 list 相同的哨兵环形结构和迭代器，但节点就是元素里的 list_hook 成员：
+// - 链表不分配也不拥有元素，插入/删除只改指针；元素可以住在对象池、arena 或栈上
+// - 一个类型放几个钩子就能同时挂在几条链表上
+// - 已知元素时 iterator_to / erase(T&) 是 O(1)，不需要查找
+// 哨兵嵌在链表对象里，所以链表可以移动但不能拷贝。元素必须比它所在的链表活得久（auto_unlink 模式除外）
+template <typename T, auto Member>
+class intrusive_list {
+private:
+  using hook_type = std::remove_reference_t<decltype(std::declval<T&>().*Member)>;
+  using node = intrusive_detail::list_node;
+
+  static constexpr link_mode _S_mode = hook_type::mode;
+  static constexpr bool _S_constant_size = _S_mode != link_mode::auto_unlink;
+
+  /*============ 迭代器定义 ============*/
+  template <typename U, typename Ref, typename Ptr>
+  struct list_iterator {
+    using value_type = U;
+    using reference = Ref;
+    using pointer = Ptr;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::bidirectional_iterator_tag;
+
+    node* cur;
+
+    list_iterator(node* n = nullptr) : cur(n) {}
+    list_iterator(const list_iterator<T, T&, T*>& it) : cur(it.cur) {}  // 非 const -> const 迭代器转换
+    list_iterator& operator=(const list_iterator&) = default;
+
+    reference operator*() const { return *_S_to_value(cur); }
+    pointer operator->() const { return _S_to_value(cur); }
+
+    list_iterator& operator++() {
+      cur = cur->next;
+      return *this;
+    }
+    list_iterator operator++(int) {
+      list_iterator tmp(*this);
+      ++(*this);
+      return tmp;
+    }
+
+    list_iterator& operator--() {
+      cur = cur->prev;
+      return *this;
+    }
+    list_iterator operator--(int) {
+      list_iterator tmp(*this);
+      --(*this);
+      return tmp;
+    }
+
+    bool operator==(const list_iterator& rhs) const { return cur == rhs.cur; }
+    bool operator!=(const list_iterator& rhs) const { return cur != rhs.cur; }
+  };
+
+public:
+  /*============ 类型定义 ============*/
+  using value_type = T;
+  using size_type = std::size_t;
+  using iterator = list_iterator<T, T&, T*>;
+  using const_iterator = list_iterator<T, const T&, const T*>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  /*============ 构造/析构 ============*/
+  intrusive_list() noexcept : _M_size(0) { _M_reset(); }
+
+  intrusive_list(const intrusive_list&) = delete;
+  intrusive_list& operator=(const intrusive_list&) = delete;
+
+  intrusive_list(intrusive_list&& other) noexcept : _M_size(0) {
+    _M_reset();
+    _M_take(other);
+  }
+
+  intrusive_list& operator=(intrusive_list&& other) noexcept {
+    if (this == &other) return *this;
+    clear();
+    _M_take(other);
+    return *this;
+  }
+
+  // 只把元素摘下，不销毁它们
+  ~intrusive_list() { clear(); }
+
+  friend void swap(intrusive_list& lhs, intrusive_list& rhs) noexcept {
+    intrusive_list tmp(std::move(lhs));
+    lhs._M_take(rhs);
+    rhs._M_take(tmp);
+  }
+
+  /*============ 容量接口 ============*/
+  bool empty() const noexcept { return _M_head.next == &_M_head; }
+
+  // auto_unlink 模式下元素可能自行离开，只能数一遍
+  size_type size() const noexcept {
+    if constexpr (_S_constant_size) {
+      return _M_size;
+    } else {
+      return std::distance(begin(), end());
+    }
+  }
+
+  /*============ 迭代器接口 ============*/
+  iterator begin() noexcept { return iterator(_M_head.next); }
+  iterator end() noexcept { return iterator(&_M_head); }
+
+  const_iterator begin() const noexcept { return const_iterator(_M_head.next); }
+  const_iterator end() const noexcept { return const_iterator(_M_sentinel()); }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+  reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+  reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+  const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+  const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+  // 由元素直接得到迭代器，O(1)；value 必须在本链表中
+  iterator iterator_to(T& value) noexcept { return iterator(_S_to_node(value)); }
+  const_iterator iterator_to(const T& value) const noexcept {
+    return const_iterator(_S_to_node(const_cast<T&>(value)));
+  }
+
+  /*============ 访问接口 ============*/
+  T& front() noexcept { return *_S_to_value(_M_head.next); }
+  const T& front() const noexcept { return *_S_to_value(_M_head.next); }
+
+  T& back() noexcept { return *_S_to_value(_M_head.prev); }
+  const T& back() const noexcept { return *_S_to_value(_M_head.prev); }
+
+  /*============ 插入接口 ============*/
+  void push_back(T& value) noexcept { _M_link_before(&_M_head, _S_to_node(value)); }
+  void push_front(T& value) noexcept { _M_link_before(_M_head.next, _S_to_node(value)); }
+
+  iterator insert(const_iterator pos, T& value) noexcept {
+    node* n = _S_to_node(value);
+    _M_link_before(pos.cur, n);
+    return iterator(n);
+  }
+
+  /*============ 删除接口 ============*/
+  void pop_front() noexcept {
+    if (!empty()) _M_unlink(_M_head.next);
+  }
+
+  void pop_back() noexcept {
+    if (!empty()) _M_unlink(_M_head.prev);
+  }
+
+  iterator erase(const_iterator pos) noexcept {
+    node* next = pos.cur->next;
+    _M_unlink(pos.cur);
+    return iterator(next);
+  }
+
+  iterator erase(const_iterator first, const_iterator last) noexcept {
+    while (first != last) first = erase(first);
+    return iterator(last.cur);
+  }
+
+  // 从任意位置摘下 value，O(1)
+  void erase(T& value) noexcept { _M_unlink(_S_to_node(value)); }
+
+  // 摘下所有元素。normal 模式只需重置哨兵；其余模式要逐个清空钩子
+  void clear() noexcept {
+    if constexpr (_S_mode != link_mode::normal) {
+      node* cur = _M_head.next;
+      while (cur != &_M_head) {
+        node* next = cur->next;
+        cur->prev = cur->next = nullptr;
+        cur = next;
+      }
+    }
+    _M_reset();
+    _M_size = 0;
+  }
+
+  template <typename UnaryPredicate>
+  size_type remove_if(UnaryPredicate pred) {
+    size_type count = 0;
+    for (node* cur = _M_head.next; cur != &_M_head;) {
+      node* next = cur->next;
+      if (pred(*_S_to_value(cur))) {
+        _M_unlink(cur);
+        ++count;
+      }
+      cur = next;
+    }
+    return count;
+  }
+
+  /*============ 拼接 ============*/
+  void splice(const_iterator pos, intrusive_list& other) noexcept {
+    if (this == &other || other.empty()) return;
+    _M_transfer(pos.cur, other._M_head.next, &other._M_head);
+    _M_size += other._M_size;
+    other._M_size = 0;
+  }
+
+  void splice(const_iterator pos, intrusive_list& other, const_iterator it) noexcept {
+    splice(pos, other, it, std::next(it), 1);
+  }
+
+  // [first, last)：与 list 一样，跨链表时要数出区间长度；已知长度时用带 count 的版本，O(1)
+  void splice(const_iterator pos, intrusive_list& other, const_iterator first, const_iterator last) noexcept {
+    size_type count = 0;
+    if constexpr (_S_constant_size) {
+      if (this != &other)
+        for (node* cur = first.cur; cur != last.cur; cur = cur->next) ++count;
+    }
+    splice(pos, other, first, last, count);
+  }
+
+  void splice(const_iterator pos, intrusive_list& other, const_iterator first, const_iterator last,
+              size_type count) noexcept {
+    if (first == last || pos == first || pos == last) return;  // pos 就是区间端点：顺序不变
+    _M_transfer(pos.cur, first.cur, last.cur);
+    if (this != &other) {
+      other._M_size -= count;
+      _M_size += count;
+    }
+  }
+
+private:
+  static node* _S_to_node(T& value) noexcept { return static_cast<node*>(&(value.*Member)); }
+
+  static T* _S_to_value(node* n) noexcept {
+    return intrusive_detail::owner_of<T, Member>(static_cast<hook_type*>(n));
+  }
+
+  node* _M_sentinel() const noexcept { return const_cast<node*>(&_M_head); }
+
+  void _M_reset() noexcept { _M_head.prev = _M_head.next = &_M_head; }
+
+  void _M_link_before(node* pos, node* n) noexcept {
+    if constexpr (_S_mode != link_mode::normal) assert(!n->next && "intrusive_list: element is already linked");
+    node* prev = pos->prev;
+    n->prev = prev;
+    n->next = pos;
+    prev->next = n;
+    pos->prev = n;
+    ++_M_size;
+  }
+
+  void _M_unlink(node* n) noexcept {
+    n->prev->next = n->next;
+    n->next->prev = n->prev;
+    if constexpr (_S_mode != link_mode::normal) n->prev = n->next = nullptr;
+    --_M_size;
+  }
+
+  // 把 [first, last) 摘下接到 pos 前，不改动 size
+  static void _M_transfer(node* pos, node* first, node* last) noexcept {
+    node* beforeFirst = first->prev;
+    node* beforeLast = last->prev;
+    beforeFirst->next = last;
+    last->prev = beforeFirst;
+
+    node* prev = pos->prev;
+    prev->next = first;
+    first->prev = prev;
+    beforeLast->next = pos;
+    pos->prev = beforeLast;
+  }
+
+  // 接管 other 的整个环（本链表须为空），首尾元素改为指向本对象的哨兵
+  void _M_take(intrusive_list& other) noexcept {
+    if (other.empty()) return;
+    _M_head = other._M_head;
+    _M_head.next->prev = &_M_head;
+    _M_head.prev->next = &_M_head;
+    _M_size = other._M_size;
+    other._M_reset();
+    other._M_size = 0;
+  }
+
+private:
+  node _M_head;  // 哨兵，嵌在对象里
+  size_type _M_size;
+};
+
+}  // namespace leistd
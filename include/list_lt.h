@@ -1,12 +1,29 @@
 #pragma once
+#include <cstddef>
+#include <functional>
 #include <initializer_list>
 #include <iterator>
 #include <memory>
 #include <utility>
 
+// 定义 LEISTD_LIST_USE_NODE_POOL 后，list 默认从共享节点池（带线程本地缓存）分配节点
+#ifdef LEISTD_LIST_USE_NODE_POOL
+#include "pool_allocator_lt.h"
+#endif
+
 namespace leistd {
 
-template <typename T, typename Alloc = std::allocator<T>>
+#ifdef LEISTD_LIST_USE_NODE_POOL
+template <typename T>
+using list_default_allocator = shared_pool_allocator<T>;
+#else
+template <typename T>
+using list_default_allocator = std::allocator<T>;
+#endif
+
+// LazySize 为 true 时不缓存跨链表 splice 之后的长度：区间 splice 变为 O(1)，size() 在需要时再 O(n) 计算。
+// 适合频繁在链表之间成批搬运节点、很少询问长度的场景（例如工作队列之间的批量交接）
+template <typename T, typename Alloc = list_default_allocator<T>, bool LazySize = false>
 class list {
 private:
   /*============ 节点结构 ============*/
@@ -29,6 +46,7 @@ private:
 
     list_iterator(Node* n = nullptr) : node(n) {}
     list_iterator(const list_iterator<T, T&, T*>& it) : node(it.node) {}  // 非 const -> const 迭代器转换
+    list_iterator& operator=(const list_iterator&) = default;
 
     reference operator*() const { return node->data; }
     pointer operator->() const { return &(node->data); }
@@ -67,48 +85,84 @@ public:
   using reverse_iterator = std::reverse_iterator<iterator>;
   using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
+  // 只有 propagate_on_container_swap 时才交换分配器，否则两边的分配器必须相等
   friend void swap(list& lhs, list& rhs) noexcept {
     using std::swap;
     swap(lhs._M_node, rhs._M_node);
     swap(lhs._M_size, rhs._M_size);
-    swap(lhs._M_alloc, rhs._M_alloc);
+    if constexpr (NodeTraits::propagate_on_container_swap::value) swap(lhs._M_alloc, rhs._M_alloc);
   }
 
   /*============ 构造/析构 ============*/
-  list() : _M_size(0) {
-    _M_node = _M_create_node();  // 哨兵节点
-    _M_node->next = _M_node;
-    _M_node->prev = _M_node;
-  }
+  list() : list(Alloc()) {}
+
+  // 有状态的分配器（如 arena_allocator）没有默认构造，需要从这里传入
+  explicit list(const Alloc& alloc) : _M_size(0), _M_alloc(alloc) { _M_init_sentinel(); }
 
-  list(std::initializer_list<T> ilist) : list() {
+  list(std::initializer_list<T> ilist, const Alloc& alloc = Alloc()) : list(alloc) {
     for (auto& x : ilist) push_back(x);
   }
 
-  list(const list& other) : list() {
+  list(const list& other) : list(Alloc(NodeTraits::select_on_container_copy_construction(other._M_alloc))) {
     for (auto& x : other) push_back(x);
   }
 
-  list(list&& other) noexcept : _M_node(other._M_node), _M_size(other._M_size), _M_alloc(std::move(other._M_alloc)) {
-    other._M_node = _M_create_node();
-    other._M_node->next = other._M_node;
-    other._M_node->prev = other._M_node;
+  // 分配器是复制而不是移动过来的：other 还要用它给自己分配新的哨兵节点
+  list(list&& other) noexcept : _M_node(other._M_node), _M_size(other._M_size), _M_alloc(other._M_alloc) {
+    other._M_init_sentinel();
     other._M_size = 0;
   }
 
-  list& operator=(list other) {  // copy-and-swap
-    swap(*this, other);
+  // 拷贝赋值：分配器声明 propagate_on_container_copy_assignment 时连同分配器一起复制
+  list& operator=(const list& other) {
+    if (this == &other) return *this;
+    clear();
+    if constexpr (NodeTraits::propagate_on_container_copy_assignment::value) {
+      if (_M_alloc != other._M_alloc) {  // 哨兵节点只能由分配它的分配器释放
+        _M_free_sentinel();
+        _M_alloc = other._M_alloc;
+        _M_init_sentinel();
+      }
+    }
+    for (auto& x : other) push_back(x);
+    return *this;
+  }
+
+  // 移动赋值：分配器会传播或两边相等时直接接管节点，否则只能逐个移动元素
+  list& operator=(list&& other) {
+    if (this == &other) return *this;
+    clear();
+    if (_M_can_steal(other)) {
+      _M_free_sentinel();
+      if constexpr (NodeTraits::propagate_on_container_move_assignment::value) _M_alloc = other._M_alloc;
+      _M_node = other._M_node;
+      _M_size = other._M_size;
+      other._M_init_sentinel();
+      other._M_size = 0;
+    } else {
+      for (auto& x : other) push_back(std::move(x));
+      other.clear();
+    }
     return *this;
   }
 
   ~list() {
     clear();
-    _M_destroy_node(_M_node);
+    _M_free_sentinel();
   }
 
+  allocator_type get_allocator() const { return Alloc(_M_alloc); }
+
   /*============ 容量接口 ============*/
-  bool empty() const { return _M_size == 0; }
-  size_type size() const { return _M_size; }
+  bool empty() const { return _M_node->next == _M_node; }
+
+  // LazySize 模式下区间 splice 之后长度未知，第一次调用 size() 时数一遍并缓存
+  size_type size() const {
+    if constexpr (LazySize) {
+      if (_M_size == _S_unknown_size) _M_size = std::distance(begin(), end());
+    }
+    return _M_size;
+  }
 
   /*============ 迭代器接口 ============*/
   iterator begin() { return iterator(_M_node->next); }
@@ -158,7 +212,7 @@ public:
     cur->prev = last;
 
     // 3. 调整 size
-    this->_M_size += other._M_size;
+    _M_add_size(other._M_size);
     other._M_size = 0;
   }
 
@@ -172,7 +226,7 @@ public:
     // 从 other 脱链
     nprev->next = nnext;
     nnext->prev = nprev;
-    --other._M_size;
+    other._M_sub_size(1);
 
     // 插入到 this 的 pos 前
     Node* cur = pos.node;
@@ -181,41 +235,32 @@ public:
     n->prev = prev;
     n->next = cur;
     cur->prev = n;
-    ++this->_M_size;
+    _M_add_size(1);
   }
 
-  // [first, last)
+  // [first, last)：重新链接本身是 O(1) 的，但维护两边的 size 需要数出区间长度，因此是 O(n)。
+  // 同一链表内移动、或 LazySize 模式下不需要计数，整个操作 O(1)
   void splice(const_iterator pos, list& other, const_iterator first, const_iterator last) {
     if (first == last) return;  // 空区间
-
-    // 1. 取出区间 [first, last)
-    Node* firstNode = first.node;
-    Node* lastNode = last.node;  // 注意 last 不包含
-    Node* beforeFirst = firstNode->prev;
-    Node* beforeLast = lastNode->prev;
-
-    // 2. 从 other 脱链
-    beforeFirst->next = lastNode;
-    lastNode->prev = beforeFirst;
-
-    // 计算区间大小（只能 O(n) 遍历）
-    size_type count = 0;
-    for (Node* cur = firstNode; cur != lastNode; cur = cur->next) {
-      ++count;
+    if (this == &other) return _M_transfer(pos.node, first.node, last.node);
+    if constexpr (LazySize) {
+      _M_transfer(pos.node, first.node, last.node);
+      _M_size = other._M_size = _S_unknown_size;  // 等到调用 size() 时再数
+    } else {
+      size_type count = 0;
+      for (Node* cur = first.node; cur != last.node; cur = cur->next) ++count;
+      splice(pos, other, first, last, count);
     }
-    other._M_size -= count;
-
-    // 3. 插入到 this 的 pos 前
-    Node* cur = pos.node;
-    Node* prev = cur->prev;
-
-    prev->next = firstNode;
-    firstNode->prev = prev;
-
-    beforeLast->next = cur;
-    cur->prev = beforeLast;
+  }
 
-    this->_M_size += count;
+  // 调用方已经知道区间长度（count 必须等于 distance(first, last)）时用这个版本，O(1)
+  void splice(const_iterator pos, list& other, const_iterator first, const_iterator last, size_type count) {
+    if (first == last) return;
+    _M_transfer(pos.node, first.node, last.node);
+    if (this != &other) {
+      other._M_sub_size(count);
+      _M_add_size(count);
+    }
   }
 
   // 插入多个相同元素
@@ -256,7 +301,7 @@ public:
     tail->prev->next = _M_node;
     _M_node->prev = tail->prev;
     _M_destroy_node(tail);
-    --_M_size;
+    _M_sub_size(1);
   }
 
   void pop_front() {
@@ -265,7 +310,23 @@ public:
     head->next->prev = _M_node;
     _M_node->next = head->next;
     _M_destroy_node(head);
-    --_M_size;
+    _M_sub_size(1);
+  }
+
+  // 删除 pos 处的元素，返回其后继
+  iterator erase(const_iterator pos) {
+    Node* n = pos.node;
+    Node* next = n->next;
+    n->prev->next = next;
+    next->prev = n->prev;
+    _M_destroy_node(n);
+    _M_sub_size(1);
+    return iterator(next);
+  }
+
+  iterator erase(const_iterator first, const_iterator last) {
+    while (first != last) first = erase(first);
+    return iterator(last.node);
   }
 
   template <typename... Args>
@@ -283,7 +344,7 @@ public:
     prev->next = node;
     cur->prev = node;
 
-    ++_M_size;
+    _M_add_size(1);
     return iterator(node);
   }
 
@@ -297,51 +358,126 @@ public:
     emplace(begin(), std::forward<Args>(args)...);
   }
 
-  // 合并两个有序链表
-  void merge(list& other) {
+  // 合并两个有序链表：只重新链接节点，稳定（相等元素中 *this 的在前）
+  void merge(list& other) { merge(other, std::less<>()); }
+  void merge(list&& other) { merge(other, std::less<>()); }
+
+  template <typename Compare>
+  void merge(list& other, Compare comp) {
     if (this == &other || other.empty()) return;
+    Node* chain = _M_merge_chains(_M_detach_chain(), other._M_detach_chain(), comp);
+    _M_attach_chain(chain);
+    _M_add_size(other._M_size);
+    other._M_size = 0;
+  }
 
-    Node* thisCur = _M_node->next;
-    Node* otherCur = other._M_node->next;
+  template <typename Compare>
+  void merge(list&& other, Compare comp) {
+    merge(other, comp);
+  }
 
-    while (thisCur != _M_node && otherCur != other._M_node) {
-      if (otherCur->data < thisCur->data) {
-        Node* nextOther = otherCur->next;
+  // 自底向上的自然归并排序：不分配内存，不移动元素，只重新链接节点，稳定，O(n log r)（r 为自然有序段数）
+  // 1. 从头切出一段自然有序段（非降序原样取出，严格降序就地翻转），已经有序的输入只需一遍扫描
+  // 2. 像二进制计数器一样把有序段放进 pending[i]：槽位已占用就与之归并并进位，pending[i] 大约含 2^i 个有序段
+  // 3. 最后从低位到高位把 pending 中剩余的段依次归并
+  void sort() { sort(std::less<>()); }
+
+  template <typename Compare>
+  void sort(Compare comp) {
+    if (_M_node->next == _M_node->prev) return;  // 0 或 1 个元素
+    Node* rest = _M_detach_chain();
+    Node* pending[64] = {};
+
+    while (rest) {
+      Node* run = rest;
+      rest = rest->next;
+      if (rest && comp(rest->data, run->data)) {
+        // 严格降序段：逐个摘到段首，翻转后变成升序，相等元素不会出现在段内，因此仍然稳定
+        run->next = nullptr;
+        while (rest && comp(rest->data, run->data)) {
+          Node* next = rest->next;
+          rest->next = run;
+          run = rest;
+          rest = next;
+        }
+      } else {
+        Node* last = run;
+        while (rest && !comp(rest->data, last->data)) {
+          last = rest;
+          rest = rest->next;
+        }
+        last->next = nullptr;
+      }
 
-        // 将 otherCur 插入 thisCur 前面
-        otherCur->prev->next = otherCur->next;
-        otherCur->next->prev = otherCur->prev;
+      // pending 中的段都在 run 之前，作为左操作数以保持稳定
+      std::size_t i = 0;
+      for (; i < 63 && pending[i]; ++i) {
+        run = _M_merge_chains(pending[i], run, comp);
+        pending[i] = nullptr;
+      }
+      if (pending[i]) run = _M_merge_chains(pending[i], run, comp);
+      pending[i] = run;
+    }
 
-        Node* thisPrev = thisCur->prev;
-        thisPrev->next = otherCur;
-        otherCur->prev = thisPrev;
-        otherCur->next = thisCur;
-        thisCur->prev = otherCur;
+    Node* result = nullptr;
+    for (Node* run : pending)
+      if (run) result = result ? _M_merge_chains(run, result, comp) : run;
+    _M_attach_chain(result);
+  }
 
-        otherCur = nextOther;
-        ++_M_size;
-        --other._M_size;
+  // 删除相邻的重复元素，返回删除的个数。一遍扫描完成脱链，被删节点最后统一析构，
+  // 所以 pred 引用链表内元素也是安全的
+  size_type unique() { return unique(std::equal_to<>()); }
+
+  template <typename BinaryPredicate>
+  size_type unique(BinaryPredicate pred) {
+    if (_M_node->next == _M_node->prev) return 0;
+    Node* removed = nullptr;
+    size_type count = 0;
+    Node* keep = _M_node->next;
+    for (Node* cur = keep->next; cur != _M_node;) {
+      Node* next = cur->next;
+      if (pred(keep->data, cur->data)) {
+        _M_unlink_to(cur, removed);
+        ++count;
       } else {
-        thisCur = thisCur->next;
+        keep = cur;
       }
+      cur = next;
     }
+    _M_destroy_chain(removed);
+    return count;
+  }
 
-    // 如果 this 链表到尾部了，直接接上剩余的 other
-    if (otherCur != other._M_node) {
-      Node* tail = _M_node->prev;
-      tail->next = otherCur;
-      otherCur->prev = tail;
-
-      _M_node->prev = other._M_node->prev;
-      other._M_node->prev->next = _M_node;
+  // 删除所有满足 pred 的元素，返回删除的个数；与 unique 一样先脱链后析构
+  template <typename UnaryPredicate>
+  size_type remove_if(UnaryPredicate pred) {
+    Node* removed = nullptr;
+    size_type count = 0;
+    for (Node* cur = _M_node->next; cur != _M_node;) {
+      Node* next = cur->next;
+      if (pred(cur->data)) {
+        _M_unlink_to(cur, removed);
+        ++count;
+      }
+      cur = next;
+    }
+    _M_destroy_chain(removed);
+    return count;
+  }
 
-      _M_size += other._M_size;
-      other._M_size = 0;
+  // value 可以引用链表内的元素
+  size_type remove(const T& value) {
+    return remove_if([&value](const T& x) { return x == value; });
+  }
 
-      // 重置 other 链表为空
-      other._M_node->next = other._M_node;
-      other._M_node->prev = other._M_node;
-    }
+  // 交换每个节点（含哨兵）的 prev/next
+  void reverse() noexcept {
+    Node* cur = _M_node;
+    do {
+      std::swap(cur->prev, cur->next);
+      cur = cur->prev;  // 交换后 prev 是原来的 next
+    } while (cur != _M_node);
   }
 
   void clear() {
@@ -361,11 +497,23 @@ private:
   using NodeAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<Node>;
   using NodeTraits = std::allocator_traits<NodeAlloc>;
 
-  Node* _M_create_node() {
-    Node* node = NodeTraits::allocate(_M_alloc, 1);
-    return node;  // 哨兵节点不构造 data
+  // 哨兵节点只分配不构造 data，首尾都指向自己
+  void _M_init_sentinel() {
+    _M_node = NodeTraits::allocate(_M_alloc, 1);
+    _M_node->next = _M_node;
+    _M_node->prev = _M_node;
   }
 
+  // 移动赋值时能否直接接管 other 的节点
+  bool _M_can_steal(const list& other) const noexcept {
+    if constexpr (NodeTraits::propagate_on_container_move_assignment::value || NodeTraits::is_always_equal::value)
+      return true;
+    else
+      return _M_alloc == other._M_alloc;
+  }
+
+  void _M_free_sentinel() noexcept { NodeTraits::deallocate(_M_alloc, _M_node, 1); }
+
   template <typename U>
   Node* _M_create_node(U&& value) {
     Node* node = NodeTraits::allocate(_M_alloc, 1);
@@ -383,10 +531,103 @@ private:
     prev->next = node;
     pos->prev = node;
 
-    ++_M_size;
+    _M_add_size(1);
     return iterator(node);
   }
 
+  // 把 [first, last) 从所在链表摘下，接到 pos 前，不改动任何 size
+  static void _M_transfer(Node* pos, Node* first, Node* last) noexcept {
+    Node* beforeFirst = first->prev;
+    Node* beforeLast = last->prev;  // 注意 last 不包含
+
+    // 1. 从原链表脱链
+    beforeFirst->next = last;
+    last->prev = beforeFirst;
+
+    // 2. 插入到 pos 前
+    Node* prev = pos->prev;
+    prev->next = first;
+    first->prev = prev;
+    beforeLast->next = pos;
+    pos->prev = beforeLast;
+  }
+
+  // LazySize 模式下 _M_size 可能是 _S_unknown_size，加减时要保持“未知”
+  void _M_add_size(size_type n) noexcept {
+    if constexpr (LazySize) {
+      if (_M_size == _S_unknown_size || n == _S_unknown_size) {
+        _M_size = _S_unknown_size;
+        return;
+      }
+    }
+    _M_size += n;
+  }
+
+  void _M_sub_size(size_type n) noexcept {
+    if constexpr (LazySize) {
+      if (_M_size == _S_unknown_size) return;
+    }
+    _M_size -= n;
+  }
+
+  // 把所有节点摘成以 nullptr 结尾的单链（只维护 next），链表变为空（_M_size 不变）
+  Node* _M_detach_chain() noexcept {
+    if (_M_node->next == _M_node) return nullptr;
+    Node* first = _M_node->next;
+    _M_node->prev->next = nullptr;
+    _M_node->next = _M_node->prev = _M_node;
+    return first;
+  }
+
+  // 把单链挂回空链表，顺带补齐 prev 指针
+  void _M_attach_chain(Node* first) noexcept {
+    Node* prev = _M_node;
+    for (Node* cur = first; cur; cur = cur->next) {
+      prev->next = cur;
+      cur->prev = prev;
+      prev = cur;
+    }
+    prev->next = _M_node;
+    _M_node->prev = prev;
+  }
+
+  // 归并两条有序单链，相等时 a 的元素在前
+  template <typename Compare>
+  static Node* _M_merge_chains(Node* a, Node* b, Compare& comp) {
+    Node* head;
+    Node** tail = &head;
+    while (a && b) {
+      if (comp(b->data, a->data)) {
+        *tail = b;
+        tail = &b->next;
+        b = b->next;
+      } else {
+        *tail = a;
+        tail = &a->next;
+        a = a->next;
+      }
+    }
+    *tail = a ? a : b;
+    return head;
+  }
+
+  // 把 node 从链表中摘下，压到 removed 单链上
+  void _M_unlink_to(Node* node, Node*& removed) noexcept {
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+    node->next = removed;
+    removed = node;
+    _M_sub_size(1);
+  }
+
+  void _M_destroy_chain(Node* node) {
+    while (node) {
+      Node* next = node->next;
+      _M_destroy_node(node);
+      node = next;
+    }
+  }
+
   void _M_destroy_node(Node* node) {
     if (node == _M_node) return;                   // 哨兵节点可单独析构
     NodeTraits::destroy(_M_alloc, &(node->data));  // 调用 data 的析构函数
@@ -394,9 +635,14 @@ private:
   }
 
 private:
-  Node* _M_node;  // 哨兵节点
-  size_type _M_size;
+  static constexpr size_type _S_unknown_size = size_type(-1);
+
+  Node* _M_node;              // 哨兵节点
+  mutable size_type _M_size;  // LazySize 模式下可能是 _S_unknown_size
   NodeAlloc _M_alloc;
 };
 
+template <typename T, typename Alloc = list_default_allocator<T>>
+using lazy_size_list = list<T, Alloc, true>;
+
 }  // namespace leistd
@@ -0,0 +1,342 @@
+#pragma once
+#include <cstddef>      // size_t, max_align_t
+#include <mutex>        // mutex, lock_guard
+#include <new>          // operator new, bad_array_new_length
+#include <type_traits>  // false_type, true_type
+
+namespace leistd {
+
+/*============ 按尺寸分级的 slab 内存池 ============*/
+// 面向链表节点这类“大量同尺寸、单个分配”的对象：
+// - 尺寸按 16 字节分级（16, 32, ..., 256），每级一串 slab，slab 一次向堆申请一大块
+// - 释放的对象挂到该级的空闲链表（链表指针就存放在对象本身里），下次分配直接取走
+// - 新 slab 不预先切分，按需从尚未使用的部分切出对象，不会一次性触碰整块内存
+// - 超过 256 字节、一次要多个对象或对齐要求超过 16 的请求，直接交给 operator new
+namespace pool_detail {
+
+inline constexpr std::size_t granularity = 16;
+inline constexpr std::size_t max_pooled_size = 256;
+inline constexpr std::size_t class_count = max_pooled_size / granularity;
+inline constexpr std::size_t slab_bytes = 16 * 1024;
+
+// 0 字节的请求也占一个最小的对象，落在第 0 级
+inline constexpr std::size_t class_index(std::size_t bytes) {
+  return bytes == 0 ? 0 : (bytes + granularity - 1) / granularity - 1;
+}
+inline constexpr std::size_t class_size(std::size_t index) { return (index + 1) * granularity; }
+
+// 能走池的请求：单个对象、尺寸和对齐都在分级范围内
+inline constexpr bool pooled(std::size_t bytes, std::size_t n, std::size_t align) {
+  return n == 1 && bytes <= max_pooled_size && align <= granularity;
+}
+
+struct free_node {
+  free_node* next;
+};
+
+struct alignas(granularity) slab_header {
+  slab_header* prev;
+};
+
+// 一个尺寸级：slab 链 + 空闲链表 + 最新 slab 中还没切出去的部分。本身不加锁
+class size_class_pool {
+public:
+  size_class_pool() noexcept = default;
+  size_class_pool(const size_class_pool&) = delete;
+  size_class_pool& operator=(const size_class_pool&) = delete;
+  ~size_class_pool() { release(); }
+
+  void* allocate(std::size_t obj_size) {
+    if (_free) {
+      free_node* n = _free;
+      _free = n->next;
+      return n;
+    }
+    if (_bump == _bump_end) refill(obj_size);
+    void* p = _bump;
+    _bump += obj_size;
+    return p;
+  }
+
+  void deallocate(void* p) noexcept {
+    free_node* n = static_cast<free_node*>(p);
+    n->next = _free;
+    _free = n;
+  }
+
+  // 把一串已经链好的对象 [first, last] 挂回空闲链表
+  void deallocate_chain(free_node* first, free_node* last) noexcept {
+    last->next = _free;
+    _free = first;
+  }
+
+  // 归还所有 slab；之前分配出去的对象全部失效
+  void release() noexcept {
+    while (_slabs) {
+      slab_header* prev = _slabs->prev;
+      ::operator delete(_slabs);
+      _slabs = prev;
+    }
+    _free = nullptr;
+    _bump = _bump_end = nullptr;
+  }
+
+private:
+  void refill(std::size_t obj_size) {
+    std::size_t count = slab_bytes / obj_size;
+    slab_header* s = static_cast<slab_header*>(::operator new(sizeof(slab_header) + count * obj_size));
+    s->prev = _slabs;
+    _slabs = s;
+    _bump = reinterpret_cast<char*>(s + 1);
+    _bump_end = _bump + count * obj_size;
+  }
+
+  free_node* _free = nullptr;
+  char* _bump = nullptr;
+  char* _bump_end = nullptr;
+  slab_header* _slabs = nullptr;
+};
+
+}  // namespace pool_detail
+
+/*============ 单线程节点池 ============*/
+// 每个尺寸级一个 size_class_pool。一个 slab_pool 可以只给一个容器用，也可以由同一线程的多个容器共享；
+// 析构时一次性归还所有 slab
+class slab_pool {
+public:
+  slab_pool() noexcept = default;
+  slab_pool(const slab_pool&) = delete;
+  slab_pool& operator=(const slab_pool&) = delete;
+
+  void* allocate(std::size_t bytes, std::size_t n = 1, std::size_t align = alignof(std::max_align_t)) {
+    if (!pool_detail::pooled(bytes, n, align)) return allocate_large(bytes, n, align);
+    std::size_t idx = pool_detail::class_index(bytes);
+    return _classes[idx].allocate(pool_detail::class_size(idx));
+  }
+
+  void deallocate(void* p, std::size_t bytes, std::size_t n = 1,
+                  std::size_t align = alignof(std::max_align_t)) noexcept {
+    if (!pool_detail::pooled(bytes, n, align)) return deallocate_large(p, align);
+    _classes[pool_detail::class_index(bytes)].deallocate(p);
+  }
+
+  void release() noexcept {
+    for (auto& c : _classes) c.release();
+  }
+
+  static void* allocate_large(std::size_t bytes, std::size_t n, std::size_t align) {
+    if (bytes != 0 && n > std::size_t(-1) / bytes) throw std::bad_array_new_length();
+    if (align > alignof(std::max_align_t)) return ::operator new(bytes * n, std::align_val_t(align));
+    return ::operator new(bytes * n);
+  }
+
+  static void deallocate_large(void* p, std::size_t align) noexcept {
+    if (align > alignof(std::max_align_t))
+      ::operator delete(p, std::align_val_t(align));
+    else
+      ::operator delete(p);
+  }
+
+private:
+  pool_detail::size_class_pool _classes[pool_detail::class_count];
+};
+
+/*============ 进程级共享节点池 ============*/
+// 每个尺寸级一把锁保护的中心池；线程本地缓存按批（batch 个）从中心池取、还，
+// 常规的分配/释放只碰本线程的缓存，不加锁。节点可以在一个线程分配、另一个线程释放。
+class shared_slab_pool {
+public:
+  static constexpr std::size_t batch = 32;
+
+  static shared_slab_pool& instance() {
+    // 故意不析构：其他静态对象或线程缓存在退出阶段仍可能归还节点
+    static shared_slab_pool* pool = new shared_slab_pool;
+    return *pool;
+  }
+
+  // 直接访问中心池（加锁），不经过线程缓存
+  void* allocate(std::size_t idx) {
+    std::lock_guard<std::mutex> lock(_central[idx].mutex);
+    return _central[idx].pool.allocate(pool_detail::class_size(idx));
+  }
+
+  void deallocate(void* p, std::size_t idx) noexcept {
+    std::lock_guard<std::mutex> lock(_central[idx].mutex);
+    _central[idx].pool.deallocate(p);
+  }
+
+  // 取出 count 个对象，串成链表返回。中途申请 slab 失败时把已经取出的部分还回去再抛出
+  pool_detail::free_node* allocate_batch(std::size_t idx, std::size_t count) {
+    std::lock_guard<std::mutex> lock(_central[idx].mutex);
+    pool_detail::free_node* head = nullptr;
+    pool_detail::free_node* tail = nullptr;
+    try {
+      for (std::size_t i = 0; i < count; ++i) {
+        auto* n = static_cast<pool_detail::free_node*>(_central[idx].pool.allocate(pool_detail::class_size(idx)));
+        n->next = head;
+        head = n;
+        if (!tail) tail = n;
+      }
+    } catch (...) {
+      if (head) _central[idx].pool.deallocate_chain(head, tail);
+      throw;
+    }
+    return head;
+  }
+
+  void deallocate_batch(std::size_t idx, pool_detail::free_node* first, pool_detail::free_node* last) noexcept {
+    std::lock_guard<std::mutex> lock(_central[idx].mutex);
+    _central[idx].pool.deallocate_chain(first, last);
+  }
+
+private:
+  shared_slab_pool() = default;
+
+  struct central {
+    std::mutex mutex;
+    pool_detail::size_class_pool pool;
+  };
+  central _central[pool_detail::class_count];
+};
+
+namespace pool_detail {
+
+// 线程本地缓存：每级一条空闲链表，超过 2 * batch 个时把一批还给中心池；线程退出时全部归还
+class thread_cache {
+public:
+  thread_cache() = default;
+  thread_cache(const thread_cache&) = delete;
+  thread_cache& operator=(const thread_cache&) = delete;
+
+  ~thread_cache() {
+    for (std::size_t idx = 0; idx < class_count; ++idx)
+      if (_bins[idx].count) flush(idx, _bins[idx].count);
+    destroyed() = true;
+  }
+
+  void* allocate(std::size_t idx) {
+    bin& b = _bins[idx];
+    if (!b.head) {
+      b.head = shared_slab_pool::instance().allocate_batch(idx, shared_slab_pool::batch);
+      b.count = shared_slab_pool::batch;
+    }
+    free_node* n = b.head;
+    b.head = n->next;
+    --b.count;
+    return n;
+  }
+
+  void deallocate(void* p, std::size_t idx) noexcept {
+    bin& b = _bins[idx];
+    free_node* n = static_cast<free_node*>(p);
+    n->next = b.head;
+    b.head = n;
+    if (++b.count > 2 * shared_slab_pool::batch) flush(idx, shared_slab_pool::batch);
+  }
+
+  // 本线程的缓存；线程退出阶段缓存已析构后返回 nullptr，调用方改走中心池
+  static thread_cache* local() {
+    if (destroyed()) return nullptr;
+    thread_local thread_cache cache;
+    return &cache;
+  }
+
+private:
+  static bool& destroyed() noexcept {
+    thread_local bool flag = false;  // 平凡类型，不参与析构顺序
+    return flag;
+  }
+
+  struct bin {
+    free_node* head = nullptr;
+    std::size_t count = 0;
+  };
+
+  // 从链表头摘下 count 个还给中心池
+  void flush(std::size_t idx, std::size_t count) noexcept {
+    bin& b = _bins[idx];
+    free_node* first = b.head;
+    free_node* last = first;
+    for (std::size_t i = 1; i < count; ++i) last = last->next;
+    b.head = last->next;
+    b.count -= count;
+    shared_slab_pool::instance().deallocate_batch(idx, first, last);
+  }
+
+  bin _bins[class_count];
+};
+
+}  // namespace pool_detail
+
+/*============ 分配器 ============*/
+// 绑定到一个 slab_pool 对象；与 arena_allocator 一样，容器拷贝/移动/交换时分配器不跟着走
+template <typename T>
+class pool_allocator {
+public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::false_type;
+  using propagate_on_container_swap = std::false_type;
+  using is_always_equal = std::false_type;
+
+  pool_allocator(slab_pool& pool) noexcept : _pool(&pool) {}
+
+  template <typename U>
+  pool_allocator(const pool_allocator<U>& other) noexcept : _pool(other.pool()) {}
+
+  T* allocate(std::size_t n) { return static_cast<T*>(_pool->allocate(sizeof(T), n, alignof(T))); }
+  void deallocate(T* p, std::size_t n) noexcept { _pool->deallocate(p, sizeof(T), n, alignof(T)); }
+
+  slab_pool* pool() const noexcept { return _pool; }
+
+  template <typename U>
+  bool operator==(const pool_allocator<U>& other) const noexcept {
+    return _pool == other.pool();
+  }
+
+private:
+  slab_pool* _pool;
+};
+
+// 使用进程级共享池的无状态分配器。ThreadCache 为 false 时每次都加锁访问中心池
+template <typename T, bool ThreadCache = true>
+class shared_pool_allocator {
+public:
+  using value_type = T;
+  using is_always_equal = std::true_type;
+
+  template <typename U>
+  struct rebind {
+    using other = shared_pool_allocator<U, ThreadCache>;
+  };
+
+  shared_pool_allocator() noexcept = default;
+  template <typename U>
+  shared_pool_allocator(const shared_pool_allocator<U, ThreadCache>&) noexcept {}
+
+  T* allocate(std::size_t n) {
+    if (!pool_detail::pooled(sizeof(T), n, alignof(T)))
+      return static_cast<T*>(slab_pool::allocate_large(sizeof(T), n, alignof(T)));
+    constexpr std::size_t idx = pool_detail::class_index(sizeof(T));
+    if constexpr (ThreadCache) {
+      if (auto* cache = pool_detail::thread_cache::local()) return static_cast<T*>(cache->allocate(idx));
+    }
+    return static_cast<T*>(shared_slab_pool::instance().allocate(idx));
+  }
+
+  void deallocate(T* p, std::size_t n) noexcept {
+    if (!pool_detail::pooled(sizeof(T), n, alignof(T))) return slab_pool::deallocate_large(p, alignof(T));
+    constexpr std::size_t idx = pool_detail::class_index(sizeof(T));
+    if constexpr (ThreadCache) {
+      if (auto* cache = pool_detail::thread_cache::local()) return cache->deallocate(p, idx);
+    }
+    shared_slab_pool::instance().deallocate(p, idx);
+  }
+
+  template <typename U>
+  bool operator==(const shared_pool_allocator<U, ThreadCache>&) const noexcept {
+    return true;
+  }
+};
+
+}  // namespace leistd
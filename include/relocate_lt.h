@@ -0,0 +1,95 @@
+#pragma once
+#include <cstddef>  // size_t
+#include <cstring>  // memmove
+#include <memory>   // allocator_traits, unique_ptr
+#include <type_traits>
+#include <utility>  // move_if_noexcept
+
+namespace leistd {
+
+/*============ 可平凡重定位 trait ============*/
+// "重定位" = 在新地址构造 + 析构旧对象。对满足该 trait 的类型，这两步可以合并成一次 memmove。
+// 平凡可复制类型默认满足；用户类型（内部没有指向自身的指针）可以特化为 true_type 来启用快速路径。
+template <typename T>
+struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>> {};
+
+// unique_ptr<T, default_delete> 只持有一个裸指针，搬动比特位是安全的
+template <typename T>
+struct is_trivially_relocatable<std::unique_ptr<T>> : std::true_type {};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+// 分配器自定义了 construct/destroy 时不能绕过它们直接搬内存
+template <typename Alloc, typename T>
+inline constexpr bool alloc_has_trivial_construct_v =
+    !requires(Alloc& a, T* p) { a.construct(p, std::declval<T&&>()); } && !requires(Alloc& a, T* p) { a.destroy(p); };
+
+// 容器实际走 memmove 快速路径的条件
+template <typename Alloc, typename T>
+inline constexpr bool use_bitwise_relocate_v = is_trivially_relocatable_v<T> && alloc_has_trivial_construct_v<Alloc, T>;
+
+/*============ 未初始化内存算法 ============*/
+template <typename Alloc, typename T>
+void destroy_range(Alloc& alloc, T* first, T* last) noexcept {
+  if constexpr (!std::is_trivially_destructible_v<T> || !alloc_has_trivial_construct_v<Alloc, T>) {
+    for (; first != last; ++first) std::allocator_traits<Alloc>::destroy(alloc, first);
+  }
+}
+
+// 把 [first, last) move_if_noexcept 构造到未初始化的 dest，返回目标末尾。
+// 中途抛异常时析构已构造的部分再重新抛出，源区间保持不变（强异常保证）。
+template <typename Alloc, typename T>
+T* uninitialized_move_if_noexcept(Alloc& alloc, T* first, T* last, T* dest) {
+  T* cur = dest;
+  try {
+    for (; first != last; ++first, ++cur) {
+      std::allocator_traits<Alloc>::construct(alloc, cur, std::move_if_noexcept(*first));
+    }
+  } catch (...) {
+    destroy_range(alloc, dest, cur);
+    throw;
+  }
+  return cur;
+}
+
+// 把 [first, last) 重定位到不重叠的未初始化内存 dest，返回目标末尾。
+// 成功后源区间已析构；抛异常时源区间完好、目标区间已清理。
+template <typename Alloc, typename T>
+T* uninitialized_relocate(Alloc& alloc, T* first, T* last, T* dest) {
+  if constexpr (use_bitwise_relocate_v<Alloc, T>) {
+    std::size_t n = last - first;
+    if (n) std::memmove(static_cast<void*>(dest), static_cast<const void*>(first), n * sizeof(T));
+    return dest + n;
+  } else {
+    T* dest_end = uninitialized_move_if_noexcept(alloc, first, last, dest);
+    destroy_range(alloc, first, last);
+    return dest_end;
+  }
+}
+
+// 同一块缓冲区内把 [first, last) 平移到 dest（允许重叠），dest 处的目标槽位必须是未构造的。
+// 仅用于 memmove 路径或 nothrow 移动构造的类型，因此本身不会抛异常。
+template <typename Alloc, typename T>
+void relocate_overlapping(Alloc& alloc, T* first, T* last, T* dest) noexcept {
+  if constexpr (use_bitwise_relocate_v<Alloc, T>) {
+    std::size_t n = last - first;
+    if (n) std::memmove(static_cast<void*>(dest), static_cast<const void*>(first), n * sizeof(T));
+  } else if (dest > first) {
+    // 向后搬：从尾部开始，保证目标槽位要么是原本的空位，要么已被析构
+    T* src = last;
+    T* dst = dest + (last - first);
+    while (src != first) {
+      --src, --dst;
+      std::allocator_traits<Alloc>::construct(alloc, dst, std::move(*src));
+      std::allocator_traits<Alloc>::destroy(alloc, src);
+    }
+  } else if (dest < first) {
+    for (; first != last; ++first, ++dest) {
+      std::allocator_traits<Alloc>::construct(alloc, dest, std::move(*first));
+      std::allocator_traits<Alloc>::destroy(alloc, first);
+    }
+  }
+}
+
+}  // namespace leistd
@@ -0,0 +1,311 @@
+#pragma once
+#include <algorithm>  // max, min
+#include <cstddef>    // size_t, ptrdiff_t
+#include <iterator>   // forward_iterator_tag
+#include <memory>     // shared_ptr, make_shared
+#include <stdexcept>  // out_of_range
+#include <utility>    // move, pair
+
+#include "small_vector.h"
+#include "string_lt.h"
+
+namespace leistd {
+
+/*============ rope：由不可变片段组成的平衡树 ============*/
+// - 叶子引用一个共享的 basic_string 中的一段 [offset, offset + length)，切分叶子只生成新的引用，不拷贝字符
+// - 内部节点只记录左右子树，按高度保持 AVL 平衡；节点一经创建不再修改，多个 rope 可以共享子树
+// - 拼接/切分都基于 join（高度差为 d 时 O(d + 1)），于是 concat、substr、insert、erase 都是 O(log n)
+// - 相邻的小叶子在拼接时合并，逐个追加短片段时叶子数不会随追加次数线性增长
+template <typename CharT, typename Traits = char_traits<CharT> >
+class rope {
+public:
+  using string_type = basic_string<CharT, Traits>;
+  using view_type = basic_string_view<CharT, Traits>;
+  using value_type = CharT;
+  using size_type = std::size_t;
+
+  static constexpr size_t npos = -1;
+
+private:
+  struct node;
+  using node_ptr = std::shared_ptr<const node>;
+
+  struct node {
+    size_t size;
+    int height;  // 叶子为 0
+    node_ptr left, right;
+    std::shared_ptr<const string_type> text;  // 非空表示叶子
+    size_t offset;
+
+    bool is_leaf() const noexcept { return text != nullptr; }
+    view_type chunk() const noexcept { return view_type(text->view().data() + offset, size); }
+  };
+
+public:
+  rope() noexcept = default;
+
+  rope(const CharT* s) : rope(view_type(s)) {}
+  rope(view_type sv) : _root(sv.empty() ? nullptr : make_leaf(std::make_shared<const string_type>(sv))) {}
+  rope(const string_type& str) : rope(str.view()) {}
+
+  // 接管 str 的缓冲区作为一个叶子，不拷贝字符
+  rope(string_type&& str)
+      : _root(str.empty() ? nullptr : make_leaf(std::make_shared<const string_type>(std::move(str)))) {}
+
+  // 观察器
+  size_t size() const noexcept { return _root ? _root->size : 0; }
+  size_t length() const noexcept { return size(); }
+  bool empty() const noexcept { return !_root; }
+  int depth() const noexcept { return height(_root); }
+
+  // 访问：从根往下找，O(log n)
+  CharT operator[](size_t pos) const noexcept {
+    const node* n = _root.get();
+    while (!n->is_leaf()) {
+      if (pos < n->left->size) {
+        n = n->left.get();
+      } else {
+        pos -= n->left->size;
+        n = n->right.get();
+      }
+    }
+    return n->chunk()[pos];
+  }
+
+  CharT at(size_t pos) const {
+    if (pos >= size()) throw std::out_of_range("rope::at: index out of range");
+    return (*this)[pos];
+  }
+
+  /* 拼接 */
+  rope& append(const rope& other) {
+    _root = join(_root, other._root);
+    return *this;
+  }
+
+  rope& append(view_type sv) { return append(rope(sv)); }
+  rope& append(const CharT* s) { return append(rope(s)); }
+
+  rope& operator+=(const rope& other) { return append(other); }
+  rope& operator+=(view_type sv) { return append(sv); }
+  rope& operator+=(const CharT* s) { return append(s); }
+
+  friend rope operator+(const rope& lhs, const rope& rhs) { return rope(join(lhs._root, rhs._root)); }
+
+  /* 切分 */
+  // [pos, pos + count)，与原 rope 共享字符
+  rope substr(size_t pos = 0, size_t count = npos) const {
+    if (pos > size()) throw std::out_of_range("rope::substr: pos out of range");
+    count = std::min(count, size() - pos);
+    node_ptr tail = split(_root, pos).second;
+    return rope(split(tail, count).first);
+  }
+
+  // 在 pos 处插入 other：切开后再拼三段
+  void insert(size_t pos, const rope& other) {
+    if (pos > size()) throw std::out_of_range("rope::insert: pos out of range");
+    auto parts = split(_root, pos);
+    _root = join(join(parts.first, other._root), parts.second);
+  }
+
+  void insert(size_t pos, view_type sv) { insert(pos, rope(sv)); }
+  void insert(size_t pos, const CharT* s) { insert(pos, rope(s)); }
+
+  // 删除 [pos, pos + count)
+  void erase(size_t pos, size_t count = npos) {
+    if (pos > size()) throw std::out_of_range("rope::erase: pos out of range");
+    count = std::min(count, size() - pos);
+    auto head = split(_root, pos);
+    _root = join(head.first, split(head.second, count).second);
+  }
+
+  void clear() noexcept { _root.reset(); }
+
+  /* 片段迭代器 */
+  // 按顺序给出每个叶子的视图，可以直接交给 writev 之类的接口，不拼接也不拷贝
+  class chunk_iterator {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = view_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const view_type*;
+    using reference = view_type;
+
+    chunk_iterator() = default;
+
+    view_type operator*() const { return _stack[_stack.size() - 1].n->chunk(); }
+
+    chunk_iterator& operator++() {
+      _stack.pop_back();
+      // 沿路返回到第一个还没走右子树的祖先。方向记在路径上而不是比较指针：
+      // r += r 之后左右孩子是同一棵共享子树，从左边返回时指针比较会误以为右边也走完了
+      while (_stack.size() && _stack[_stack.size() - 1].went_right) _stack.pop_back();
+      if (_stack.size()) {
+        frame& parent = _stack[_stack.size() - 1];
+        parent.went_right = true;
+        descend_left(parent.n->right.get());
+      }
+      return *this;
+    }
+
+    chunk_iterator operator++(int) {
+      chunk_iterator tmp(*this);
+      ++*this;
+      return tmp;
+    }
+
+    // 共享子树里同一个叶子会出现在多个位置，只比较叶子不够，要比较整条路径
+    bool operator==(const chunk_iterator& other) const {
+      if (_stack.size() != other._stack.size()) return false;
+      for (size_t i = 0; i < _stack.size(); ++i) {
+        if (_stack[i].n != other._stack[i].n || _stack[i].went_right != other._stack[i].went_right) return false;
+      }
+      return true;
+    }
+    bool operator!=(const chunk_iterator& other) const { return !(*this == other); }
+
+  private:
+    friend class rope;
+
+    explicit chunk_iterator(const node* root) {
+      if (root) descend_left(root);
+    }
+
+    void descend_left(const node* n) {
+      _stack.push_back(frame{n, false});
+      while (!n->is_leaf()) {
+        n = n->left.get();
+        _stack.push_back(frame{n, false});
+      }
+    }
+
+    // 路径上的一个节点，以及当前是否在它的右子树里
+    struct frame {
+      const node* n;
+      bool went_right;
+    };
+
+    // 从根到当前叶子的路径；AVL 高度不超过 1.44·log2(叶子数)，一般不会用到堆
+    small_vector<frame, 48> _stack;
+  };
+
+  struct chunk_range {
+    chunk_iterator first, last;
+    chunk_iterator begin() const { return first; }
+    chunk_iterator end() const { return last; }
+  };
+
+  chunk_iterator chunk_begin() const { return chunk_iterator(_root.get()); }
+  chunk_iterator chunk_end() const { return chunk_iterator(); }
+  chunk_range chunks() const { return chunk_range{chunk_begin(), chunk_end()}; }
+
+  // 拼成连续的 basic_string：一次分配，逐片段拷贝
+  string_type flatten() const {
+    string_type result;
+    result.reserve(size());
+    for (view_type chunk : chunks()) result.append(chunk);
+    return result;
+  }
+
+  friend bool operator==(const rope& lhs, const rope& rhs) {
+    if (lhs.size() != rhs.size()) return false;
+    chunk_iterator a = lhs.chunk_begin(), b = rhs.chunk_begin();
+    view_type x, y;
+    while (true) {
+      if (x.empty()) {
+        if (a == lhs.chunk_end()) return true;
+        x = *a++;
+      }
+      if (y.empty()) y = *b++;
+      size_t n = std::min(x.size(), y.size());
+      if (Traits::compare(x.data(), y.data(), n) != 0) return false;
+      x.remove_prefix(n);
+      y.remove_prefix(n);
+    }
+  }
+
+private:
+  // 合并后不超过这么多字符的相邻叶子会被拷贝成一个叶子
+  static constexpr size_t _merge_limit = 256 / sizeof(CharT);
+
+  explicit rope(node_ptr root) noexcept : _root(std::move(root)) {}
+
+  static int height(const node_ptr& n) noexcept { return n ? n->height : -1; }
+
+  static node_ptr make_leaf(std::shared_ptr<const string_type> text, size_t offset, size_t length) {
+    return std::make_shared<const node>(node{length, 0, nullptr, nullptr, std::move(text), offset});
+  }
+
+  static node_ptr make_leaf(std::shared_ptr<const string_type> text) {
+    size_t length = text->size();
+    return make_leaf(std::move(text), 0, length);
+  }
+
+  // 前提：l、r 非空且高度差不超过 1
+  static node_ptr make_node(node_ptr l, node_ptr r) {
+    size_t size = l->size + r->size;
+    int h = std::max(l->height, r->height) + 1;
+    return std::make_shared<const node>(node{size, h, std::move(l), std::move(r), nullptr, 0});
+  }
+
+  static node_ptr merge_leaves(const node& a, const node& b) {
+    auto text = std::make_shared<string_type>();
+    text->reserve(a.size + b.size);
+    text->append(a.chunk()).append(b.chunk());
+    return make_leaf(std::move(text));
+  }
+
+  // 高度差至多为 2 时，通过一次单旋或双旋恢复平衡
+  static node_ptr balance(node_ptr l, node_ptr r) {
+    if (l->height > r->height + 1) {
+      if (height(l->left) >= height(l->right)) return make_node(l->left, make_node(l->right, std::move(r)));
+      const node& lr = *l->right;
+      return make_node(make_node(l->left, lr.left), make_node(lr.right, std::move(r)));
+    }
+    if (r->height > l->height + 1) {
+      if (height(r->right) >= height(r->left)) return make_node(make_node(std::move(l), r->left), r->right);
+      const node& rl = *r->left;
+      return make_node(make_node(std::move(l), rl.left), make_node(rl.right, r->right));
+    }
+    return make_node(std::move(l), std::move(r));
+  }
+
+  // 拼接两棵树：沿较高一侧的边界下降到高度相近处挂上另一棵，回溯时逐层再平衡
+  static node_ptr join(const node_ptr& a, const node_ptr& b) {
+    if (!a) return b;
+    if (!b) return a;
+    if (a->height > b->height + 1) return balance(a->left, join(a->right, b));
+    if (b->height > a->height + 1) return balance(join(a, b->left), b->right);
+
+    // 高度相近：顺带合并紧挨着的两个小叶子
+    if (b->is_leaf() && b->size <= _merge_limit) {
+      if (a->is_leaf() && a->size + b->size <= _merge_limit) return merge_leaves(*a, *b);
+      if (!a->is_leaf() && a->right->is_leaf() && a->right->size + b->size <= _merge_limit)
+        return balance(a->left, merge_leaves(*a->right, *b));
+    }
+    return make_node(a, b);
+  }
+
+  // 切成 [0, pos) 和 [pos, size)；叶子被切开时两半共享原来的字符
+  static std::pair<node_ptr, node_ptr> split(const node_ptr& n, size_t pos) {
+    if (!n || pos == 0) return {nullptr, n};
+    if (pos >= n->size) return {n, nullptr};
+    if (n->is_leaf())
+      return {make_leaf(n->text, n->offset, pos), make_leaf(n->text, n->offset + pos, n->size - pos)};
+
+    size_t left_size = n->left->size;
+    if (pos < left_size) {
+      auto parts = split(n->left, pos);
+      return {std::move(parts.first), join(parts.second, n->right)};
+    }
+    if (pos == left_size) return {n->left, n->right};
+    auto parts = split(n->right, pos - left_size);
+    return {join(n->left, parts.first), std::move(parts.second)};
+  }
+
+  node_ptr _root;
+};
+
+using crope = rope<char>;
+
+}  // namespace leistd
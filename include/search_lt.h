@@ -0,0 +1,275 @@
+#pragma once
+#include <bit>          // bit_width, countr_one
+#include <cstddef>      // size_t
+#include <cstdint>      // uintptr_t
+#include <functional>   // less
+#include <iterator>
+#include <memory>       // to_address
+#include <type_traits>
+#include <utility>      // as_const, swap
+
+#include "array_lt.h"
+#include "vector.h"
+
+namespace leistd {
+
+namespace search_detail {
+
+// leistd::vector 的迭代器只提供随机访问所需的 +、-、[]，不满足 std::random_access_iterator 概念，按类别标签判断
+template <typename It>
+concept random_access_iter =
+    std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<It>::iterator_category>;
+
+// 预取 it 所指元素所在的缓存行；编译期求值或拿不到地址的迭代器什么都不做
+template <typename It>
+constexpr void prefetch(const It& it) noexcept {
+#ifdef __GNUC__
+  if constexpr (requires { std::to_address(it); }) {
+    if (!std::is_constant_evaluated()) __builtin_prefetch(std::to_address(it));
+  }
+#endif
+}
+
+/*============ 无分支二分查找 ============*/
+// 每轮只决定起点是否右移 half：比较结果直接算出新起点（编译成 cmov），区间长度减半。
+// 轮数只取决于 n，不会因为分支预测失败而清空流水线；代价是访存变成一条依赖链，
+// 数组超出缓存时每一轮都要等一次缓存未命中。Prefetch 时顺带预取下一轮两个可能的探测位置，
+// 让这一轮的比较和下一轮的访存重叠
+template <bool Prefetch, typename It, typename Kx, typename Compare>
+constexpr It branchless_lower_bound(It first, typename std::iterator_traits<It>::difference_type n, const Kx& key,
+                                    Compare& comp) {
+  if (n == 0) return first;
+  while (n > 1) {
+    auto half = n / 2;
+    if constexpr (Prefetch) {
+      auto next = (n - half) / 2;
+      prefetch(first + next);
+      prefetch(first + (half + next));
+    }
+    first = comp(first[half], key) ? first + half : first;
+    n -= half;
+  }
+  return first + static_cast<decltype(n)>(comp(*first, key));
+}
+
+// 第一个大于 key 的位置
+template <bool Prefetch, typename It, typename Kx, typename Compare>
+constexpr It branchless_upper_bound(It first, typename std::iterator_traits<It>::difference_type n, const Kx& key,
+                                    Compare& comp) {
+  if (n == 0) return first;
+  while (n > 1) {
+    auto half = n / 2;
+    if constexpr (Prefetch) {
+      auto next = (n - half) / 2;
+      prefetch(first + next);
+      prefetch(first + (half + next));
+    }
+    first = comp(key, first[half]) ? first : first + half;
+    n -= half;
+  }
+  return first + static_cast<decltype(n)>(!comp(key, *first));
+}
+
+// 长度是编译期常量时，每一轮的 half（以及轮数）都是常量，整个查找展开成一串比较 + cmov
+template <std::size_t N, typename T, typename Kx, typename Compare>
+constexpr T* unrolled_lower_bound(T* first, const Kx& key, Compare& comp) {
+  if constexpr (N == 0) {
+    return first;
+  } else if constexpr (N == 1) {
+    return first + static_cast<std::size_t>(comp(*first, key));
+  } else {
+    constexpr std::size_t half = N / 2;
+    first = comp(first[half], key) ? first + half : first;
+    return unrolled_lower_bound<N - half>(first, key, comp);
+  }
+}
+
+// 数出小于 key 的元素个数，有序时就是 lower_bound 的下标。各次比较互不依赖，算术类型会被向量化
+template <std::size_t N, typename T, typename Kx, typename Compare>
+constexpr std::size_t count_less(const T* first, const Kx& key, Compare& comp) {
+  std::size_t c = 0;
+  for (std::size_t i = 0; i < N; ++i) c += static_cast<std::size_t>(comp(first[i], key));
+  return c;
+}
+
+// 不超过这个字节数的算术类型数组改用 count_less。bench_search 中 array<int, N>：N = 64 时计数比展开的二分快 1.8 倍，
+// N = 128 时两者持平
+inline constexpr std::size_t linear_search_bytes = 256;
+
+// 区间不超过这个字节数时不预取：数据已在 L1 里，预取指令只是额外开销（bench_search 中 4K 个 uint32 慢约 15%），
+// 从 L2 大小起预取明显更快
+inline constexpr std::size_t prefetch_min_bytes = 32 * 1024;
+
+template <typename It, typename Kx, typename Compare>
+constexpr It lower_bound(It first, typename std::iterator_traits<It>::difference_type n, const Kx& key,
+                         Compare& comp) {
+  if (static_cast<std::size_t>(n) * sizeof(typename std::iterator_traits<It>::value_type) > prefetch_min_bytes)
+    return branchless_lower_bound<true>(first, n, key, comp);
+  return branchless_lower_bound<false>(first, n, key, comp);
+}
+
+template <typename It, typename Kx, typename Compare>
+constexpr It upper_bound(It first, typename std::iterator_traits<It>::difference_type n, const Kx& key,
+                         Compare& comp) {
+  if (static_cast<std::size_t>(n) * sizeof(typename std::iterator_traits<It>::value_type) > prefetch_min_bytes)
+    return branchless_upper_bound<true>(first, n, key, comp);
+  return branchless_upper_bound<false>(first, n, key, comp);
+}
+
+}  // namespace search_detail
+
+/*============ 有序区间查找 ============*/
+// 与 std::lower_bound 等语义相同，实现换成无分支二分，区间超出 L1 时带预取
+template <search_detail::random_access_iter It, typename Kx, typename Compare = std::less<>>
+constexpr It lower_bound(It first, It last, const Kx& key, Compare comp = Compare()) {
+  return search_detail::lower_bound(first, last - first, key, comp);
+}
+
+template <search_detail::random_access_iter It, typename Kx, typename Compare = std::less<>>
+constexpr It upper_bound(It first, It last, const Kx& key, Compare comp = Compare()) {
+  return search_detail::upper_bound(first, last - first, key, comp);
+}
+
+template <search_detail::random_access_iter It, typename Kx, typename Compare = std::less<>>
+constexpr bool binary_search(It first, It last, const Kx& key, Compare comp = Compare()) {
+  It it = leistd::lower_bound(first, last, key, comp);
+  return it != last && !comp(key, *it);
+}
+
+// 小数组：长度是编译期常量，查找在编译期完全展开；算术类型且整个数组不超过 linear_search_bytes 时直接计数
+template <typename T, std::size_t N, typename Kx, typename Compare = std::less<>>
+constexpr const T* lower_bound(const array<T, N>& a, const Kx& key, Compare comp = Compare()) {
+  if constexpr (std::is_arithmetic_v<T> && N * sizeof(T) <= search_detail::linear_search_bytes)
+    return a.data() + search_detail::count_less<N>(a.data(), key, comp);
+  else
+    return search_detail::unrolled_lower_bound<N>(a.data(), key, comp);
+}
+
+template <typename T, std::size_t N, typename Kx, typename Compare = std::less<>>
+constexpr T* lower_bound(array<T, N>& a, const Kx& key, Compare comp = Compare()) {
+  return a.data() + (leistd::lower_bound(std::as_const(a), key, comp) - a.data());
+}
+
+template <typename T, std::size_t N, typename Kx, typename Compare = std::less<>>
+constexpr bool binary_search(const array<T, N>& a, const Kx& key, Compare comp = Compare()) {
+  const T* it = leistd::lower_bound(a, key, comp);
+  return it != a.data() + N && !comp(key, *it);
+}
+
+/*============ Eytzinger 静态索引 ============*/
+// 把有序序列按完全二叉树的层序重排：节点 k（从 1 开始）的孩子是 2k 和 2k+1。查找从根往下走，
+// 每步 k = 2k + (b[k] < key)，没有分支；靠近根的几层总在缓存里。节点存储对齐到缓存行，
+// 节点 k 往下 log2(64 / sizeof(T)) 层的全部后代恰好占一条缓存行，每步预取它，访存和比较重叠起来。
+// 构造一次、反复查询的只读表用它；查询结果是元素在原有序序列中的下标，不额外存下标表：
+// 完全二叉树里节点的中序位置可以直接由 k 算出来
+template <typename T, typename Compare = std::less<>>
+class eytzinger_index {
+public:
+  using value_type = T;
+  using size_type = std::size_t;
+
+  eytzinger_index() = default;
+
+  // [first, last) 须按 comp 有序
+  template <search_detail::random_access_iter It>
+  eytzinger_index(It first, It last, Compare comp = Compare())
+      : _M_n(static_cast<size_type>(last - first)), _M_comp(comp) {
+    _M_build([&](size_type k) -> const T& { return first[_M_rank(k)]; });
+  }
+
+  template <typename Range>
+    requires requires(const Range& r) { r.begin(); r.end(); }
+  explicit eytzinger_index(const Range& sorted, Compare comp = Compare())
+      : eytzinger_index(sorted.begin(), sorted.end(), comp) {}
+
+  // 拷贝后缓冲区地址变了，要重新对齐
+  eytzinger_index(const eytzinger_index& other) : _M_n(other._M_n), _M_comp(other._M_comp) {
+    _M_build([&](size_type k) -> const T& { return other._M_nodes()[k]; });
+  }
+  eytzinger_index(eytzinger_index&& other) noexcept { swap(other); }
+  eytzinger_index& operator=(eytzinger_index other) noexcept {
+    swap(other);
+    return *this;
+  }
+
+  size_type size() const noexcept { return _M_n; }
+  bool empty() const noexcept { return _M_n == 0; }
+
+  // 第一个不小于 key 的元素在原有序序列中的下标，没有则返回 size()
+  template <typename Kx>
+  size_type lower_bound(const Kx& key) const {
+    size_type k = _M_search(key);
+    return k == 0 ? _M_n : _M_rank(k);
+  }
+
+  template <typename Kx>
+  bool contains(const Kx& key) const {
+    size_type k = _M_search(key);
+    return k != 0 && !_M_comp(key, _M_nodes()[k]);
+  }
+
+  void swap(eytzinger_index& other) noexcept {
+    using std::swap;
+    swap(_M_storage, other._M_storage);
+    swap(_M_offset, other._M_offset);
+    swap(_M_n, other._M_n);
+    swap(_M_comp, other._M_comp);
+  }
+
+private:
+  // 一条缓存行容纳的节点数；元素大小不能整除 64 时不做对齐和预取
+  static constexpr size_type _S_line = 64 % sizeof(T) == 0 ? 64 / sizeof(T) : 1;
+
+  const T* _M_nodes() const noexcept { return std::to_address(_M_storage.begin()) + _M_offset; }
+
+  // node(k) 给出第 k 个节点（1..n）的值。先按最大需要量预留，再选一个偏移让 0 号节点落在缓存行起点上，
+  // 0 号节点和偏移之前的填充位都放 node(1) 的拷贝
+  template <typename NodeFn>
+  void _M_build(NodeFn node) {
+    if (_M_n == 0) return;
+    _M_storage.reserve(_M_n + _S_line);
+    auto addr = reinterpret_cast<std::uintptr_t>(std::to_address(_M_storage.begin()));
+    for (size_type o = 0; o < _S_line; ++o) {
+      if ((addr + o * sizeof(T)) % 64 == 0) {
+        _M_offset = o;
+        break;
+      }
+    }
+    for (size_type i = 0; i <= _M_offset; ++i) _M_storage.push_back(node(1));
+    for (size_type k = 1; k <= _M_n; ++k) _M_storage.push_back(node(k));
+  }
+
+  // 返回第一个不小于 key 的节点，没有则返回 0。走到叶子之下后，k 的二进制末尾连续的 1 是最后几次右转，
+  // 去掉它们和之前的一次左转，剩下的就是最后一次左转所在的节点
+  template <typename Kx>
+  size_type _M_search(const Kx& key) const {
+    const T* b = _M_nodes();
+    size_type k = 1;
+    while (k <= _M_n) {
+#ifdef __GNUC__
+      if constexpr (_S_line > 1)  // 地址可能越过数组末尾，按整数计算；预取无效地址不会出错
+        __builtin_prefetch(reinterpret_cast<const void*>(reinterpret_cast<std::uintptr_t>(b) + k * 64));
+#endif
+      k = 2 * k + static_cast<size_type>(_M_comp(b[k], key));
+    }
+    return k >> (std::countr_one(k) + 1);
+  }
+
+  // 节点 k 的中序位置，即它在有序序列中的下标。共 H 层，最后一层只有前 L 个位置有节点：
+  // 先按满二叉树算出中序位置 r，再减去排在它前面、但最后一层实际不存在的位置数
+  size_type _M_rank(size_type k) const noexcept {
+    size_type h = static_cast<size_type>(std::bit_width(_M_n));
+    size_type last = _M_n - ((size_type(1) << (h - 1)) - 1);
+    size_type d = static_cast<size_type>(std::bit_width(k)) - 1;
+    size_type r = ((2 * (k - (size_type(1) << d)) + 1) << (h - 1 - d)) - 1;
+    size_type before = (r + 1) / 2;  // 满二叉树中排在 k 前面的最后一层位置数
+    return before > last ? r - (before - last) : r;
+  }
+
+  vector<T> _M_storage;
+  size_type _M_offset = 0;  // 0 号节点在 _M_storage 中的位置
+  size_type _M_n = 0;
+  [[no_unique_address]] Compare _M_comp;
+};
+
+}  // namespace leistd
@@ -0,0 +1,157 @@
+#pragma once
+#include <cstddef>  // size_t
+#include <initializer_list>
+#include <iterator>  // move_iterator
+#include <memory>    // allocator_traits
+#include <type_traits>
+
+#include "vector.h"
+
+namespace leistd {
+
+/*============ 带内联缓冲区的分配器 ============*/
+// 第一次申请不超过 N 个元素时直接返回对象内部的缓冲区，之后的请求交给 Alloc。
+// 缓冲区跟着分配器对象走，因此拷贝/移动分配器时不会带走它；只供 small_vector 内部使用。
+template <typename T, std::size_t N, typename Alloc = std::allocator<T>>
+class small_buffer_allocator {
+  using heap_traits = std::allocator_traits<Alloc>;
+
+public:
+  using value_type = T;
+
+  template <typename U>
+  struct rebind {
+    using other = small_buffer_allocator<U, N, typename heap_traits::template rebind_alloc<U>>;
+  };
+
+  small_buffer_allocator() = default;
+  small_buffer_allocator(const small_buffer_allocator& other) : _heap(other._heap) {}
+  small_buffer_allocator& operator=(const small_buffer_allocator&) { return *this; }
+
+  T* allocate(std::size_t n) {
+    if (n <= N && !_inline_used) {
+      _inline_used = true;
+      return inline_data();
+    }
+    return heap_traits::allocate(_heap, n);
+  }
+
+  void deallocate(T* p, std::size_t n) noexcept {
+    if (p == inline_data()) {
+      _inline_used = false;
+      return;
+    }
+    heap_traits::deallocate(_heap, p, n);
+  }
+
+  T* inline_data() noexcept { return reinterpret_cast<T*>(_buf); }
+  const T* inline_data() const noexcept { return reinterpret_cast<const T*>(_buf); }
+
+  // 内联缓冲区属于具体对象，两个分配器只有是同一个对象时才能互相释放
+  bool operator==(const small_buffer_allocator& other) const noexcept { return this == &other; }
+
+private:
+  [[no_unique_address]] Alloc _heap;
+  bool _inline_used = false;
+  alignas(T) unsigned char _buf[N * sizeof(T)];
+};
+
+/*============ small_vector ============*/
+// 前 N 个元素放在对象内部，超出后才走堆分配。迭代器、insert/erase 等全部复用 vector 的实现。
+template <typename T, std::size_t N, typename Alloc = std::allocator<T>, typename GrowthPolicy = growth_factor_2x>
+class small_vector : public vector<T, small_buffer_allocator<T, N, Alloc>, GrowthPolicy> {
+  static_assert(N > 0, "small_vector: N must be positive");
+  using base = vector<T, small_buffer_allocator<T, N, Alloc>, GrowthPolicy>;
+
+public:
+  using typename base::size_type;
+
+  small_vector() {
+    this->reserve(N);  // 落在内联缓冲区上，不会分配
+  }
+
+  small_vector(std::initializer_list<T> init) : small_vector() {
+    this->insert(this->cend(), init);
+  }
+
+  small_vector(const small_vector& other) : small_vector() {
+    this->insert(this->cend(), other.begin(), other.end());
+  }
+
+  small_vector(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) : small_vector() {
+    _M_steal(other);
+  }
+
+  small_vector& operator=(const small_vector& other) {
+    base::operator=(other);
+    return *this;
+  }
+
+  small_vector& operator=(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+    if (this != &other) {
+      this->clear();
+      _M_steal(other);
+    }
+    return *this;
+  }
+
+  // vector::swap 只交换指针，对内联缓冲区不成立：那样各自会拿到指向对方对象内部的指针。
+  // 两边都在堆上时才交换指针（堆缓冲区来自内层的 Alloc，要求两边的 Alloc 相等，与 vector 相同），
+  // 否则借一个临时对象按移动的规则三方交换，内联的元素逐个移动
+  void swap(small_vector& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+    if (this == &other)
+      return;
+    if (!is_inline() && !other.is_inline()) {
+      base::swap(other);
+      return;
+    }
+    small_vector tmp(std::move(other));
+    other = std::move(*this);
+    *this = std::move(tmp);
+  }
+
+  friend void swap(small_vector& lhs, small_vector& rhs) noexcept(std::is_nothrow_move_constructible_v<T>) {
+    lhs.swap(rhs);
+  }
+
+  // 元素是否还在内联缓冲区里
+  bool is_inline() const noexcept {
+    return this->_start == this->_alloc.inline_data();
+  }
+
+  static constexpr size_type inline_capacity() noexcept {
+    return N;
+  }
+
+  // 元素数不超过 N 时搬回内联缓冲区，否则按 vector 的方式收缩
+  void shrink_to_fit() {
+    if (is_inline())
+      return;
+    if (this->size() > N) {
+      base::shrink_to_fit();
+      return;
+    }
+    small_vector heap(std::move(*this));  // 接管堆缓冲区，*this 回到空的内联状态
+    this->insert(this->cend(), std::make_move_iterator(heap.begin()), std::make_move_iterator(heap.end()));
+  }
+
+private:
+  // 前提：*this 为空。对方在堆上就直接接管指针，在内联缓冲区里只能逐个移动
+  void _M_steal(small_vector& other) {
+    if (other.is_inline()) {
+      this->insert(this->cend(), std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+      other.clear();
+      return;
+    }
+
+    this->_alloc.deallocate(this->_start, this->capacity());
+    this->_start = other._start;
+    this->_end = other._end;
+    this->_cap = other._cap;
+
+    other._start = other._end = other._alloc.allocate(N);
+    other._cap = other._start + N;
+  }
+};
+
+}  // namespace leistd
@@ -1,42 +1,26 @@
 #pragma once
 #include <cstddef>  // size_t, ptrdiff_t
 #include <cstring>
+#include <functional>  // less, less_equal
+#include <iterator>    // iterator_traits, distance
 #include <memory>     // std::allocator, allocator_traits
 #include <stdexcept>  // out_of_range
+#include <type_traits>
 
-namespace leistd {
-template <typename CharT>
-struct char_traits {
-  using char_type = CharT;
-
-  static void assign(CharT& c1, const CharT& c2) {
-    c1 = c2;
-  }
-
-  static bool eq(CharT c1, CharT c2) {
-    return c1 == c2;
-  }
-
-  static std::size_t length(const CharT* s) {
-    std::size_t len = 0;
-    while (!eq(s[len], CharT()))
-      ++len;
-    return len;
-  }
-
-  static CharT* copy(CharT* dest, const CharT* src, std::size_t n) {
-    return static_cast<CharT*>(std::memcpy(dest, src, n * sizeof(CharT)));
-  }
-
-  static CharT* move(CharT* dest, const CharT* src, std::size_t n) {
-    return static_cast<CharT*>(std::memmove(dest, src, n * sizeof(CharT)));
-  }
-};
+#include "allocator_lt.h"
+#include "char_traits_lt.h"
+#include "string_view_lt.h"
 
+namespace leistd {
 template <typename CharT, typename Traits = char_traits<CharT>,
           typename Alloc = std::allocator<CharT> >
 class basic_string {
+  using _alloc_traits = std::allocator_traits<Alloc>;
+
   public:
+  using allocator_type = Alloc;
+  using view_type = basic_string_view<CharT, Traits>;
+
   static constexpr size_t npos = -1;
 
   // 迭代器
@@ -280,45 +264,49 @@ private:
     iterator_type _it;
   };
 
-  basic_string() : _alloc(), _size(0), _cap(0) {
-    _data = std::allocator_traits<Alloc>::allocate(_alloc, 1);  // 分配 1 个元素
-    Traits::assign(_data[0], CharT());                          // 放 '\0'
+  // 空串直接指向内联缓冲区，不分配
+  basic_string() noexcept : basic_string(Alloc()) {
   }
 
-  basic_string(const CharT* s) : _data(nullptr), _size(0), _cap(0) {
+  // 有状态的分配器（如 arena_allocator）没有默认构造，需要从这里传入
+  explicit basic_string(const Alloc& alloc) noexcept : _data(_local_buf), _size(0), _alloc(alloc) {
+    Traits::assign(_data[0], CharT());  // 放 '\0'
+  }
+
+  basic_string(const CharT* s, const Alloc& alloc = Alloc()) : basic_string(alloc) {
     size_t len = Traits::length(s);
-    ensure_capacity(len + 1);
+    ensure_capacity(len);
     Traits::copy(_data, s, len);
     _size = len;
     _data[_size] = CharT();
   }
 
+  // 从视图构造：显式，避免把视图悄悄变成一次分配
+  explicit basic_string(view_type sv, const Alloc& alloc = Alloc()) : basic_string(alloc) {
+    append(sv);
+  }
+
   ~basic_string() {
-    if (_data) {
-      std::allocator_traits<Alloc>::deallocate(_alloc, _data, _cap);
-    }
+    dispose();
   }
 
-  // 拷贝构造函数
+  // 拷贝构造函数：短串留在内联缓冲区，长串按实际长度分配；分配器由 select_on_container_copy_construction 决定
   basic_string(const basic_string& other)
-      : _alloc(other._alloc), _size(other._size), _cap(other._size) {
-    // 分配空间
-    _data = std::allocator_traits<Alloc>::allocate(_alloc, _size + 1);
-
-    // 拷贝内容
-    Traits::copy(_data, other._data, _size);
-
-    // null 终止符
-    _data[_size] = CharT();
+      : _data(_local_buf), _size(0), _alloc(_alloc_traits::select_on_container_copy_construction(other._alloc)) {
+    ensure_capacity(other._size);
+    Traits::copy(_data, other._data, other._size);
+    _size = other._size;
+    _data[_size] = CharT();  // null 终止符
   }
 
-  // 移动构造函数
+  // 移动构造函数：长串直接接管缓冲区，短串只拷贝内联字符，都不分配
   basic_string(basic_string&& other) noexcept
-      : _alloc(std::move(other._alloc)), _data(other._data), _size(other._size),
-        _cap(other._cap) {
-    other._data = nullptr;
-    other._size = 0;
-    other._cap = 0;
+      : _data(_local_buf), _size(other._size), _alloc(std::move(other._alloc)) {
+    steal(other);
+  }
+
+  Alloc get_allocator() const noexcept {
+    return _alloc;
   }
 
   // 观察器
@@ -329,7 +317,7 @@ private:
     return _size == 0;
   }
   size_t capacity() const noexcept {
-    return _cap;
+    return is_local() ? _local_capacity : _cap;
   }
 
   const CharT* c_str() const noexcept {
@@ -337,6 +325,14 @@ private:
     return _data;
   }
 
+  view_type view() const noexcept {
+    return view_type(_data, _size);
+  }
+
+  operator view_type() const noexcept {
+    return view();
+  }
+
   // 访问
   /* 不做越界检查 */
   CharT& operator[](size_t pos) noexcept {
@@ -369,23 +365,78 @@ private:
   void push_back(CharT ch) {
     ensure_capacity(_size + 1);  // 至少保证一个空位
     _data[_size++] = ch;
+    _data[_size] = CharT();
   }
 
   basic_string& append(const CharT* s) {
     if (!s)
       return *this;
+    return append(s, Traits::length(s));
+  }
 
-    size_t len = Traits::length(s);  // 1. 获取s长度
-    size_t need = _size + len;
-    ensure_capacity(need);
+  // 追加 s 的前 n 个字符：长度已知，不扫描 '\0'，中间的 '\0' 也照常追加；s 可以指向自身
+  basic_string& append(const CharT* s, size_t n) {
+    bool self = std::less_equal<const CharT*>()(_data, s) && std::less<const CharT*>()(s, _data + _size + 1);
+    size_t offset = self ? s - _data : 0;
 
-    Traits::copy(_data + _size, s, len);
-    _size += len;
+    ensure_capacity(_size + n);  // 可能换缓冲区，自引用时重新定位源
+    if (self)
+      s = _data + offset;
+
+    Traits::copy(_data + _size, s, n);
+    _size += n;
     _data[_size] = CharT();
 
     return *this;  // 支持链式调用
   }
 
+  basic_string& append(view_type sv) {
+    return append(sv.data(), sv.size());
+  }
+
+  basic_string& append(const basic_string& str) {
+    return append(str._data, str._size);
+  }
+
+  // 追加 n 个字符 ch
+  basic_string& append(size_t n, CharT ch) {
+    ensure_capacity(_size + n);
+    Traits::assign(_data + _size, n, ch);
+    _size += n;
+    _data[_size] = CharT();
+    return *this;
+  }
+
+  // 追加区间 [first, last)：前向迭代器先算长度、只扩容一次；输入迭代器只能逐个追加
+  template <typename InputIt, typename = std::enable_if_t<!std::is_integral_v<InputIt> > >
+  basic_string& append(InputIt first, InputIt last) {
+    using category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_pointer_v<InputIt> || std::is_same_v<InputIt, iterator> ||
+                  std::is_same_v<InputIt, const_iterator>) {
+      // 连续内存，可能指向自身，走带自引用检查的指针版本
+      size_t n = last - first;
+      return n ? append(&*first, n) : *this;
+    } else if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>) {
+      size_t n = std::distance(first, last);
+      ensure_capacity(_size + n);
+      for (; first != last; ++first)
+        Traits::assign(_data[_size++], *first);
+      _data[_size] = CharT();
+      return *this;
+    } else {
+      for (; first != last; ++first)
+        push_back(*first);
+      _data[_size] = CharT();
+      return *this;
+    }
+  }
+
+  // 预留至少 n 个字符的空间，按需求精确分配
+  void reserve(size_t n) {
+    if (n > capacity())
+      reallocate(n);
+  }
+
   void pop_back() {
     if (_size == 0)
       return;
@@ -394,26 +445,14 @@ private:
 
   // 用默认字符（'\0'）填充新元素
   void resize(size_t n) {
-    if (n > _size) {
-      if (n > _cap)
-        ensure_capacity(n + 1);
-      for (size_t i = _size; i < n; i++) {
-        _data[i] = '\0';
-      }
-      _size = n;
-    } else if (n < _size) {
-      _size = n;
-    }
+    resize(n, CharT());
   }
 
   // 用指定字符 c 填充新元素
-  void resize(size_t n, char c) {
+  void resize(size_t n, CharT c) {
     if (n > _size) {
-      if (n > _cap)
-        ensure_capacity(n + 1);
-      for (size_t i = _size; i < n; i++) {
-        _data[i] = c;
-      }
+      ensure_capacity(n);
+      Traits::assign(_data + _size, n - _size, c);
       _size = n;
     } else if (n < _size) {
       _size = n;
@@ -426,19 +465,27 @@ private:
     return os.write(str._data, str._size);
   }
 
-  // 拷贝赋值运算符
+  // 拷贝赋值运算符：分配器声明 propagate_on_container_copy_assignment 时连同分配器一起复制
   basic_string& operator=(const basic_string& other) {
     if (this == &other)
       return *this;
 
-    if (_cap < other._size) {
+    if constexpr (_alloc_traits::propagate_on_container_copy_assignment::value) {
+      if (_alloc != other._alloc) {  // 旧缓冲区只能由旧分配器释放
+        dispose();
+        _data = _local_buf;
+      }
+      _alloc = other._alloc;
+    }
+
+    if (capacity() < other._size) {
       // 重新分配内存
       CharT* new_data =
           std::allocator_traits<Alloc>::allocate(_alloc, other._size + 1);
       Traits::copy(new_data, other._data, other._size);
 
       // 释放原有内存
-      std::allocator_traits<Alloc>::deallocate(_alloc, _data, _cap);
+      dispose();
 
       _data = new_data;
       _cap = other._size;
@@ -453,38 +500,87 @@ private:
     return *this;
   }
 
-  // 移动赋值运算符
-  basic_string& operator=(basic_string&& other) noexcept {
+  // 移动赋值运算符：分配器会传播或两边相等时接管缓冲区，否则只能拷贝字符
+  basic_string& operator=(basic_string&& other) noexcept(_alloc_traits::propagate_on_container_move_assignment::value ||
+                                                         _alloc_traits::is_always_equal::value) {
     if (this == &other)
       return *this;
 
+    constexpr bool propagate = _alloc_traits::propagate_on_container_move_assignment::value;
+    if constexpr (!(propagate || _alloc_traits::is_always_equal::value)) {
+      if (_alloc != other._alloc) {
+        _size = 0;
+        append(other._data, other._size);
+        return *this;
+      }
+    }
+
     // 释放自身内存
-    std::allocator_traits<Alloc>::deallocate(_alloc, _data, _cap);
+    dispose();
+    _data = _local_buf;
 
     // 窃取右值对象数据
-    _data = other._data;
     _size = other._size;
-    _cap = other._cap;
-    _alloc = std::move(other._alloc);
-
-    // 重置右值对象
-    other._data = nullptr;
-    other._size = 0;
-    other._cap = 0;
+    if constexpr (propagate)
+      _alloc = std::move(other._alloc);
+    steal(other);
 
     return *this;
   }
 
-  basic_string operator+(const basic_string& other) const {
-    basic_string result(*this);  // 复制当前对象
-    result.append(other._data);  // append other
-    return result;               // 返回新对象
+  // 交换：直接交换缓冲区，只有 propagate_on_container_swap 时才交换分配器。
+  // 与标准容器相同，分配器不传播时要求两边相等，否则缓冲区会由另一个分配器释放
+  void swap(basic_string& other) noexcept {
+    if (this == &other)
+      return;
+    if (is_local() && other.is_local()) {
+      CharT tmp[_local_capacity + 1];
+      Traits::copy(tmp, _local_buf, _local_capacity + 1);
+      Traits::copy(_local_buf, other._local_buf, _local_capacity + 1);
+      Traits::copy(other._local_buf, tmp, _local_capacity + 1);
+    } else if (is_local()) {
+      swap_local_heap(*this, other);
+    } else if (other.is_local()) {
+      swap_local_heap(other, *this);
+    } else {
+      std::swap(_data, other._data);
+      std::swap(_cap, other._cap);
+    }
+    std::swap(_size, other._size);
+    if constexpr (_alloc_traits::propagate_on_container_swap::value) {
+      using std::swap;
+      swap(_alloc, other._alloc);
+    }
+  }
+
+  friend void swap(basic_string& lhs, basic_string& rhs) {
+    lhs.swap(rhs);
   }
 
-  basic_string operator+(const CharT* other) const {
-    basic_string result(*this);
-    result.append(other);
-    return result;
+  // 左操作数是左值：一次分配出结果的准确大小
+  basic_string operator+(const basic_string& other) const& {
+    return concat(other._data, other._size);
+  }
+
+  basic_string operator+(const CharT* other) const& {
+    return concat(other, Traits::length(other));
+  }
+
+  basic_string operator+(view_type other) const& {
+    return concat(other.data(), other.size());
+  }
+
+  // 左操作数是右值：直接在它的缓冲区后面追加，a + b + c + ... 只在容量不够时才扩容
+  basic_string operator+(const basic_string& other) && {
+    return std::move(append(other));
+  }
+
+  basic_string operator+(const CharT* other) && {
+    return std::move(append(other));
+  }
+
+  basic_string operator+(view_type other) && {
+    return std::move(append(other));
   }
 
   basic_string& operator+=(const CharT* s) {
@@ -493,10 +589,18 @@ private:
   }
 
   basic_string& operator+=(const basic_string& other) {
-    append(other._data);
+    return append(other._data, other._size);
+  }
+
+  basic_string& operator+=(CharT ch) {
+    push_back(ch);
     return *this;
   }
 
+  basic_string& operator+=(view_type sv) {
+    return append(sv);
+  }
+
   /* 支持迭代器 */
   iterator begin() {
     return iterator(_data);
@@ -608,135 +712,129 @@ private:
 
   // 查找单个字符
   size_t find(CharT ch, size_t pos = 0) const noexcept {
-    for (size_t i = pos; i < _size; ++i) {
-      if (Traits::eq(_data[i], ch))
-        return i;
-    }
-    return npos;
+    return view().find(ch, pos);
   }
 
   // 查找 C 字符串
   size_t find(const CharT* s, size_t pos = 0) const {
-    if (!s || _size == 0 || pos >= _size)
+    if (!s)
       return npos;
-
-    size_t s_len = Traits::length(s);  // 要查找的字符串长度
-    if (s_len == 0)
-      return pos;  // 空字符串，约定返回 pos
-
-    // 遍历每个可能的起点
-    for (size_t i = pos; i <= _size - s_len; ++i) {
-      // 对比 _data[i..i+s_len-1] 和 s[0..s_len-1]
-      bool match = true;
-      for (size_t j = 0; j < s_len; ++j) {
-        if (!Traits::eq(_data[i + j], s[j])) {
-          match = false;
-          break;
-        }
-      }
-      if (match)
-        return i;  // 找到，返回起点
-    }
-
-    return npos;  // 没找到
+    return view().find(s, pos);
   }
 
   // 查找另一个 string
   size_t find(const basic_string& str, size_t pos = 0) const {
-    if (str.empty() || _size == 0 || pos >= _size)
-      return npos;
+    return view().find(str.view(), pos);
+  }
 
-    size_t s_len = str.size();  // 子串长度
-    if (s_len == 0)
-      return pos;  // 空子串，返回 pos
-
-    // 遍历每个可能的起点
-    for (size_t i = pos; i <= _size - s_len; ++i) {
-      bool match = true;
-      for (size_t j = 0; j < s_len; ++j) {
-        if (!Traits::eq(_data[i + j], str._data[j])) {
-          match = false;
-          break;
-        }
-      }
-      if (match)
-        return i;  // 找到，返回起点
-    }
+  // 查找视图，不需要先构造临时 string
+  size_t find(view_type sv, size_t pos = 0) const noexcept {
+    return view().find(sv, pos);
+  }
 
-    return npos;  // 没找到
+  // 查找 s 的前 n 个字符：实现都在 basic_string_view 里
+  size_t find(const CharT* s, size_t pos, size_t n) const noexcept {
+    return view().find(s, pos, n);
   }
 
   // 从指定位置 pos 开始，查找 第一个在 chars
   // 中出现的字符，注意不是把chars作为子串查找
   size_t find_first_of(const basic_string& chars, size_t pos = 0) const {
-    if (chars.empty() || _size == 0 || pos >= _size)
-      return npos;
+    return view().find_first_of(chars.view(), pos);
+  }
 
-    for (size_t i = pos; i < _size; ++i) {
-      for (size_t j = 0; j < chars.size(); ++j) {
-        if (Traits::eq(_data[i], chars[j])) {
-          return i;  // 找到
-        }
-      }
-    }
-    return npos;  // 没找到
+  size_t find_first_of(view_type chars, size_t pos = 0) const {
+    return view().find_first_of(chars, pos);
+  }
+
+  size_t find_first_of(const CharT* chars, size_t pos = 0) const {
+    return view().find_first_of(view_type(chars), pos);
+  }
+
+  size_t find_first_of(const CharT* chars, size_t pos, size_t n) const {
+    return view().find_first_of(chars, pos, n);
   }
 
   // 从 pos 开始，查找 第一个不在 chars 中的字符
   size_t find_first_not_of(const basic_string& chars, size_t pos = 0) const {
-    if (chars.empty() || _size == 0 || pos >= _size)
-      return npos;
+    return view().find_first_not_of(chars.view(), pos);
+  }
 
-    for (size_t i = pos; i < _size; ++i) {
-      bool found = false;
-      for (size_t j = 0; j < chars.size(); ++j) {
-        if (Traits::eq(_data[i], chars[j])) {
-          found = true;
-          break;
-        }
-      }
-      if (!found)
-        return i;  // 第一个不属于 chars 的字符
-    }
-    return npos;  // 没找到
+  size_t find_first_not_of(view_type chars, size_t pos = 0) const {
+    return view().find_first_not_of(chars, pos);
+  }
+
+  size_t find_first_not_of(const CharT* chars, size_t pos = 0) const {
+    return view().find_first_not_of(view_type(chars), pos);
+  }
+
+  size_t find_first_not_of(const CharT* chars, size_t pos, size_t n) const {
+    return view().find_first_not_of(chars, pos, n);
   }
 
   // 从指定位置 pos 向前（从右到左）查找 最后一个在 chars 中出现的字符
   size_t find_last_of(const basic_string& chars, size_t pos = npos) const {
-    if (_size == 0)
-      return npos;
+    return view().find_last_of(chars.view(), pos);
+  }
 
-    pos = (pos == npos ? _size - 1 : pos);
+  size_t find_last_of(view_type chars, size_t pos = npos) const {
+    return view().find_last_of(chars, pos);
+  }
 
-    for (size_t i = pos + 1; i-- > 0;) {
-      for (size_t j = 0; j < chars.size(); j++) {
-        if (Traits::eq(chars[j], _data[i])) {
-          return i;
-        }
-      }
-    }
-    return npos;
+  size_t find_last_of(const CharT* chars, size_t pos = npos) const {
+    return view().find_last_of(view_type(chars), pos);
+  }
+
+  size_t find_last_of(const CharT* chars, size_t pos, size_t n) const {
+    return view().find_last_of(chars, pos, n);
   }
 
   // 从 pos 向前查找 最后一个不在 chars 中的字符
   size_t find_last_not_of(const basic_string& chars, size_t pos = npos) const {
-    if (_size == 0)
-      return npos;
+    return view().find_last_not_of(chars.view(), pos);
+  }
 
-    pos = (pos == npos ? _size - 1 : pos);
+  size_t find_last_not_of(view_type chars, size_t pos = npos) const {
+    return view().find_last_not_of(chars, pos);
+  }
 
-    for (size_t i = pos + 1; i-- > 0;) {
-      bool found = false;
-      for (size_t j = 0; j < chars.size(); j++) {
-        if (Traits::eq(chars[j], _data[i])) {
-          found = true;
-          break;
-        }
-      }
-      if (!found)
-        return i;
-    }
-    return npos;
+  size_t find_last_not_of(const CharT* chars, size_t pos = npos) const {
+    return view().find_last_not_of(view_type(chars), pos);
+  }
+
+  size_t find_last_not_of(const CharT* chars, size_t pos, size_t n) const {
+    return view().find_last_not_of(chars, pos, n);
+  }
+
+  /* 比较 */
+  int compare(view_type sv) const noexcept {
+    return view().compare(sv);
+  }
+
+  int compare(const basic_string& str) const noexcept {
+    return view().compare(str.view());
+  }
+
+  int compare(const CharT* s) const {
+    return view().compare(view_type(s));
+  }
+
+  // 比较 [pos, pos + count) 与 sv
+  int compare(size_t pos, size_t count, view_type sv) const {
+    return substr_view(pos, count).compare(sv);
+  }
+
+  // 相等比较：长度不同直接返回 false。哈希容器要求键类型支持 ==（反向的写法由 C++20 自动改写）
+  friend bool operator==(const basic_string& lhs, const basic_string& rhs) noexcept {
+    return lhs.view() == rhs.view();
+  }
+
+  friend bool operator==(const basic_string& lhs, view_type rhs) noexcept {
+    return lhs.view() == rhs;
+  }
+
+  friend bool operator==(const basic_string& lhs, const CharT* rhs) {
+    return lhs.view() == view_type(rhs);
   }
 
   basic_string substr(size_t pos = 0, size_t count = npos) const {
@@ -746,169 +844,161 @@ private:
 
     size_t len = std::min(count, _size - pos);
     basic_string result;
-    result.ensure_capacity(len + 1);  // 分配空间
+    result.ensure_capacity(len);  // 分配空间
     Traits::copy(result._data, _data + pos, len);
     result._size = len;
     return result;
   }
 
+  // 不分配的子串：返回指向本对象内部的视图，本对象修改或析构后失效
+  view_type substr_view(size_t pos = 0, size_t count = npos) const {
+    if (pos > _size) {
+      throw std::out_of_range("basic_string::substr_view: pos out of range");
+    }
+    return view_type(_data + pos, std::min(count, _size - pos));
+  }
+
   /* 插入 */
+  // 所有重载都先用 make_gap 在 pos 处腾出空位，再往空位里写字符
+
   // 在 pos 位置插入单个字符
   void insert(size_t pos, CharT ch) {
-    if (pos > _size)
-      return;
-    if (_size + 1 > _cap)
-      ensure_capacity(_size + 1);
-
-    for (size_t i = _size - 1; i >= pos; i--) {
-      _data[i + 1] = _data[i];
-    }
-    _data[pos] = ch;
-    _size++;
+    insert(pos, 1, ch);
   }
 
   // 在 pos 位置插入 n 个相同字符
   void insert(size_t pos, size_t n, CharT ch) {
     if (pos > _size)
       return;  // 允许 pos == _size 插入到末尾
-    ensure_capacity(_size + n);
-
-    for (size_t i = _size; i > pos; --i) {
-      _data[i + n - 1] = _data[i - 1];  // 腾出位置
-    }
-
-    for (size_t i = pos; i < pos + n; ++i) {
-      _data[i] = ch;
-    }
-
-    _size += n;
+    Traits::assign(make_gap(pos, n), n, ch);
   }
 
   // 在 pos 位置插入 C 字符串
   void insert(size_t pos, const CharT* s) {
-    if (pos > _size)
-      return;
-    size_t len_s = Traits::length(s);
-    if (_size + len_s > _cap)
-      ensure_capacity(_size + len_s);
-
-    for (size_t i = _size; i > pos; --i) {
-      _data[i + len_s - 1] = _data[i - 1];  // 腾出位置
-    }
-
-    Traits::copy(_data + pos, s, len_s);
-    _size += len_s;
+    insert(pos, view_type(s));
   }
 
-  // 在 pos 位置插入 C 字符串前 n 个字符
+  // 在 pos 位置插入 s 的前 n 个字符（不扫描 '\0'，s 至少要有 n 个字符）
   void insert(size_t pos, const CharT* s, size_t n) {
-    if (pos > _size)
-      return;
-    size_t len_s = Traits::length(s);
-    size_t inst_len = std::min(len_s, n);
-
-    if (_size + inst_len > _cap)
-      ensure_capacity(_size + inst_len);
-
-    for (size_t i = _size; i > pos; --i) {
-      _data[i + inst_len - 1] = _data[i - 1];  // 腾出位置
-    }
-
-    Traits::copy(_data + pos, s, inst_len);
-    _size += inst_len;
+    insert(pos, view_type(s, n));
   }
 
   // 在 pos 位置插入另一个 basic_string
   void insert(size_t pos, const basic_string& str) {
+    insert(pos, str.view());
+  }
+
+  // 在 pos 位置插入视图，视图可以指向自身
+  void insert(size_t pos, view_type sv) {
     if (pos > _size)
       return;
 
-    if (_size + str._size > _cap)
-      ensure_capacity(_size + str._size);
-
-    for (size_t i = _size; i > pos; --i) {
-      _data[i + str._size - 1] = _data[i - 1];  // 腾出位置
+    const CharT* src = sv.data();
+    size_t len = sv.size();
+    if (!(std::less_equal<const CharT*>()(_data, src) && std::less<const CharT*>()(src, _data + _size))) {
+      Traits::copy(make_gap(pos, len), src, len);
+      return;
     }
 
-    Traits::copy(_data + pos, str._data, str._size);
-    _size += str._size;
+    // 源在自身内部：腾出空位后，原下标 i < pos 的字符不动，i >= pos 的字符后移了 len，
+    // 所以源被 pos 分成的两段分别从新位置拷贝（都不和空位重叠）
+    size_t first = src - _data, last = first + len;
+    CharT* gap = make_gap(pos, len);
+    size_t head = first < pos ? std::min(last, pos) - first : 0;
+    Traits::copy(gap, _data + first, head);
+    Traits::copy(gap + head, _data + std::max(first, pos) + len, len - head);
   }
 
   // 插入 str 的子串 [subpos, subpos + sublen)
   void insert(size_t pos, const basic_string& str, size_t subpos,
               size_t sublen) {
-    if (pos > _size)
-      return;
-
-    if (_size + sublen > _cap)
-      ensure_capacity(_size + sublen);
-
-    for (size_t i = _size; i > pos; --i) {
-      _data[i + sublen - 1] = _data[i - 1];  // 腾出位置
-    }
-
-    Traits::copy(_data + pos, str._data + subpos, sublen);
-    _size += sublen;
+    insert(pos, str.view().substr(subpos, sublen));
   }
 
   // 迭代器版本：在迭代器 pos 插入区间 [first, last)
-  template <typename InputIt>
+  template <typename InputIt, typename = std::enable_if_t<!std::is_integral_v<InputIt> > >
   void insert(iterator pos, InputIt first, InputIt last) {
-    size_t n = std::distance(first, last);
-    if (n == 0)
-      return;
-
-    size_t pos_index = pos - begin();
-    ensure_capacity(_size + n);
-
-    // 腾出位置
-    for (size_t i = _size; i > pos_index; --i) {
-      _data[i + n - 1] = _data[i - 1];
-    }
-
-    // 拷贝元素
-    size_t idx = pos_index;
-    for (auto it = first; it != last; ++it) {
-      _data[idx++] = *it;
+    size_t idx = pos - begin();
+    using category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_pointer_v<InputIt> || std::is_same_v<InputIt, iterator> ||
+                  std::is_same_v<InputIt, const_iterator>) {
+      // 连续内存，可能指向自身，交给视图版本
+      size_t n = last - first;
+      if (n)
+        insert(idx, view_type(&*first, n));
+    } else if constexpr (std::is_base_of_v<std::forward_iterator_tag, category>) {
+      CharT* gap = make_gap(idx, std::distance(first, last));
+      for (; first != last; ++first)
+        Traits::assign(*gap++, *first);
+    } else {
+      // 输入迭代器只能遍历一次，先收集再插入
+      basic_string tmp;
+      tmp.append(first, last);
+      insert(idx, tmp.view());
     }
-
-    _size += n;
   }
 
   // 迭代器版本：在 pos 迭代器插入 n 个相同字符
   void insert(iterator pos, size_t n, CharT ch) {
-    size_t idx = pos - begin();
-    if (idx > _size)
-      return;
+    insert(static_cast<size_t>(pos - begin()), n, ch);
+  }
 
-    if (_size + n > _cap)
-      ensure_capacity(_size + n);
+  private:
+  /* 私有方法 */
+  // *this + s[0, n)：先按总长度分配好，再拷贝两段
+  basic_string concat(const CharT* s, size_t n) const {
+    basic_string result(_alloc_traits::select_on_container_copy_construction(_alloc));
+    result.reserve(_size + n);
+    Traits::copy(result._data, _data, _size);
+    Traits::copy(result._data + _size, s, n);
+    result._size = _size + n;
+    result._data[result._size] = CharT();
+    return result;
+  }
 
-    for (size_t i = _size; i > idx; --i) {
-      _data[i + n - 1] = _data[i - 1];
-    }
+  // 保证能放下 need 个字符（另有一个位置留给 null terminator）
+  void ensure_capacity(size_t need) {
+    if (need <= capacity())
+      return;  // 已经够用，不做任何操作
 
-    for (size_t i = idx; i < idx + n; i++) {
-      _data[i] = ch;
-    }
+    reallocate(grow_recommend(need));
+  }
 
+  // 在 pos（<= _size）处腾出 n 个未赋值的字符，返回空位起点。
+  // 容量够时 Traits::move 整段后移；不够时只分配一次，头尾直接拷贝到新缓冲区的最终位置
+  CharT* make_gap(size_t pos, size_t n) {
+    size_t tail = _size - pos;
+    if (_size + n <= capacity()) {
+      Traits::move(_data + pos + n, _data + pos, tail);
+    } else {
+      size_t new_cap = grow_recommend(_size + n);
+      CharT* new_data = std::allocator_traits<Alloc>::allocate(_alloc, new_cap + 1);
+      Traits::copy(new_data, _data, pos);
+      Traits::copy(new_data + pos + n, _data + pos, tail);
+      dispose();
+      _data = new_data;
+      _cap = new_cap;
+    }
     _size += n;
+    _data[_size] = CharT();
+    return _data + pos;
   }
 
-  private:
-  /* 私有方法 */
-  void ensure_capacity(size_t need) {
-    if (need <= _cap)
-      return;  // 已经够用，不做任何操作
+  // 换到容量为 new_cap 的堆缓冲区（new_cap >= _size）
+  void reallocate(size_t new_cap) {
+    if constexpr (allocator_has_reallocate_v<Alloc>) {
+      if (!is_local()) {  // 分配器能原地扩展时不必拷贝
+        _data = _alloc.reallocate(_data, _cap + 1, new_cap + 1);
+        _cap = new_cap;
+        return;
+      }
+    }
 
-    size_t new_cap = grow_recommend(need);  // 计算新容量
     CharT* new_data = std::allocator_traits<Alloc>::allocate(
         _alloc, new_cap + 1);  // +1 给 null terminator
 
-    if (_data) {
-      Traits::move(new_data, _data, _size);  // 安全搬移原字符
-      std::allocator_traits<Alloc>::deallocate(_alloc, _data, _cap);
-    }
+    Traits::copy(new_data, _data, _size);  // 安全搬移原字符
+    dispose();
 
     _data = new_data;
     _cap = new_cap;
@@ -916,20 +1006,70 @@ private:
   }
 
   size_t grow_recommend(size_t need) const {
-    // 翻倍策略：如果当前有容量就 *2，否则从 8 开始
-    size_t new_cap = _cap ? _cap * 2 : 8;
+    // 翻倍策略：从内联容量开始翻倍
+    size_t new_cap = capacity() * 2;
     // 确保至少能满足 need
     if (new_cap < need)
       new_cap = need;
     return new_cap;
   }
 
+  bool is_local() const noexcept {
+    return _data == _local_buf;
+  }
+
+  // 释放堆缓冲区（短串什么都不做）
+  void dispose() noexcept {
+    if (!is_local())
+      std::allocator_traits<Alloc>::deallocate(_alloc, _data, _cap + 1);
+  }
+
+  // 前提：*this 没有堆缓冲区且 _size 已设为 other._size。接管 other 的内容后把 other 置为空的短串
+  void steal(basic_string& other) noexcept {
+    if (other.is_local()) {
+      _data = _local_buf;
+      Traits::copy(_local_buf, other._local_buf, _local_capacity + 1);
+    } else {
+      _data = other._data;
+      _cap = other._cap;
+    }
+    other._data = other._local_buf;
+    other._size = 0;
+    Traits::assign(other._local_buf[0], CharT());
+  }
+
+  // local 是短串、heap 是长串：local 接管堆缓冲区，heap 改用自己的内联缓冲区存放 local 的字符
+  static void swap_local_heap(basic_string& local, basic_string& heap) noexcept {
+    CharT tmp[_local_capacity + 1];
+    Traits::copy(tmp, local._local_buf, _local_capacity + 1);
+    local._data = heap._data;
+    local._cap = heap._cap;
+    heap._data = heap._local_buf;
+    Traits::copy(heap._local_buf, tmp, _local_capacity + 1);
+  }
+
   /* 成员变量 */
+  // 短字符串优化：不超过 _local_capacity 个字符时 _data 指向对象内部的 _local_buf，
+  // 它和堆模式下才有意义的 _cap 共用同一块空间，对象大小与原来的 (指针, 长度, 容量) 相同
+  static constexpr size_t _local_capacity = 15 / sizeof(CharT);
+
   CharT* _data;
   size_t _size;
-  size_t _cap;
-  Alloc _alloc;  // 分配器实例
+  union {
+    size_t _cap;  // 堆模式下的容量（不含 null terminator）
+    CharT _local_buf[_local_capacity + 1];
+  };
+  [[no_unique_address]] Alloc _alloc;  // 分配器实例
 };
 
 using string = basic_string<char>;
 }  // namespace leistd
+
+// 让 leistd::basic_string 可以直接作为 std::unordered_map 等容器的键
+template <typename CharT, typename Traits, typename Alloc>
+struct std::hash<leistd::basic_string<CharT, Traits, Alloc> > {
+  std::size_t operator()(const leistd::basic_string<CharT, Traits, Alloc>& s) const noexcept {
+    // 不走 c_str()：它会写终止符，多个线程同时对同一个 const 键求哈希就成了数据竞争
+    return static_cast<std::size_t>(leistd::hash_bytes(s.view().data(), s.size() * sizeof(CharT)));
+  }
+};
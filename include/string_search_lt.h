@@ -0,0 +1,125 @@
+#pragma once
+#include <cstddef>  // size_t
+#include <cstring>  // memchr, memcmp
+
+#if defined(__GNUC__) && defined(__x86_64__)  // x86-64 上 SSE2 是基线指令集
+#include <immintrin.h>
+#define LEISTD_X86_SIMD 1
+#endif
+
+namespace leistd {
+
+/*============ 窄字符子串查找引擎 ============*/
+// 在 s[0, n) 中查找 p[0, m)，返回首次出现的下标，找不到返回 size_t(-1)。
+// - m == 1：memchr
+// - x86-64：首尾字符过滤（SSE2/AVX2 一次比较 16/32 个候选起点），命中后再 memcmp 中间部分，
+//   第一次调用时按 CPU 特性选定 SSE2 还是 AVX2
+// - 没有 SIMD 时：短模式串用 memchr + memcmp，长模式串用 Boyer-Moore-Horspool（一次能跳过接近 m 个字节）
+
+inline constexpr std::size_t search_npos = static_cast<std::size_t>(-1);
+
+// 没有 SIMD 时超过这个长度改用 Horspool（由 bench_string_find 测得；有 SIMD 时首尾过滤在各长度上都更快）
+inline constexpr std::size_t search_horspool_threshold = 16;
+
+// 前提：2 <= m <= n
+inline std::size_t find_substring_scalar(const char* s, std::size_t n, const char* p, std::size_t m) {
+  const char* cur = s;
+  const char* last_start = s + (n - m);
+  while (cur <= last_start) {
+    cur = static_cast<const char*>(std::memchr(cur, p[0], last_start - cur + 1));
+    if (!cur) return search_npos;
+    if (std::memcmp(cur + 1, p + 1, m - 1) == 0) return cur - s;
+    ++cur;
+  }
+  return search_npos;
+}
+
+// 前提：2 <= m <= n
+inline std::size_t find_substring_horspool(const char* s, std::size_t n, const char* p, std::size_t m) {
+  std::size_t skip[256];
+  for (std::size_t& k : skip) k = m;
+  for (std::size_t i = 0; i + 1 < m; ++i) skip[static_cast<unsigned char>(p[i])] = m - 1 - i;
+
+  const unsigned char last = static_cast<unsigned char>(p[m - 1]);
+  std::size_t i = 0;
+  while (i + m <= n) {
+    unsigned char c = static_cast<unsigned char>(s[i + m - 1]);
+    if (c == last && std::memcmp(s + i, p, m - 1) == 0) return i;
+    i += skip[c];
+  }
+  return search_npos;
+}
+
+#ifdef LEISTD_X86_SIMD
+// 首字符和尾字符同时匹配的候选起点才做 memcmp；剩下不足一个块的尾部交给标量版本
+inline std::size_t find_substring_sse2(const char* s, std::size_t n, const char* p, std::size_t m) {
+  const __m128i first = _mm_set1_epi8(p[0]);
+  const __m128i last = _mm_set1_epi8(p[m - 1]);
+  std::size_t i = 0;
+  for (; i + m - 1 + 16 <= n; i += 16) {
+    __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+    __m128i block_last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i + m - 1));
+    __m128i eq = _mm_and_si128(_mm_cmpeq_epi8(first, block_first), _mm_cmpeq_epi8(last, block_last));
+    unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(eq));
+    while (mask) {
+      unsigned bit = __builtin_ctz(mask);
+      if (std::memcmp(s + i + bit + 1, p + 1, m - 2) == 0) return i + bit;
+      mask &= mask - 1;
+    }
+  }
+  std::size_t r = find_substring_scalar(s + i, n - i, p, m);
+  return r == search_npos ? r : i + r;
+}
+
+__attribute__((target("avx2"))) inline std::size_t find_substring_avx2(const char* s, std::size_t n, const char* p,
+                                                                       std::size_t m) {
+  const __m256i first = _mm256_set1_epi8(p[0]);
+  const __m256i last = _mm256_set1_epi8(p[m - 1]);
+  std::size_t i = 0;
+  for (; i + m - 1 + 32 <= n; i += 32) {
+    __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+    __m256i block_last = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i + m - 1));
+    __m256i eq = _mm256_and_si256(_mm256_cmpeq_epi8(first, block_first), _mm256_cmpeq_epi8(last, block_last));
+    unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(eq));
+    while (mask) {
+      unsigned bit = __builtin_ctz(mask);
+      if (std::memcmp(s + i + bit + 1, p + 1, m - 2) == 0) return i + bit;
+      mask &= mask - 1;
+    }
+  }
+  std::size_t r = find_substring_sse2(s + i, n - i, p, m);
+  return r == search_npos ? r : i + r;
+}
+#endif
+
+// 前提：2 <= m <= n
+inline std::size_t find_substring_portable(const char* s, std::size_t n, const char* p, std::size_t m) {
+  if (m > search_horspool_threshold) return find_substring_horspool(s, n, p, m);
+  return find_substring_scalar(s, n, p, m);
+}
+
+using find_substring_fn = std::size_t (*)(const char*, std::size_t, const char*, std::size_t);
+
+inline find_substring_fn select_find_substring() {
+#ifdef LEISTD_X86_SIMD
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) return find_substring_avx2;
+  return find_substring_sse2;
+#else
+  return find_substring_portable;
+#endif
+}
+
+inline std::size_t find_substring(const char* s, std::size_t n, const char* p, std::size_t m) {
+  if (m == 0) return 0;
+  if (m > n) return search_npos;
+  if (m == 1) {
+    const void* hit = std::memchr(s, p[0], n);
+    return hit ? static_cast<const char*>(hit) - s : search_npos;
+  }
+
+  static const find_substring_fn impl = select_find_substring();
+  return impl(s, n, p, m);
+}
+
+}  // namespace leistd
@@ -0,0 +1,219 @@
+#pragma once
+#include <algorithm>   // min
+#include <cstddef>     // size_t
+#include <functional>  // hash
+#include <ostream>
+#include <stdexcept>   // out_of_range
+#include <type_traits>
+
+#include "char_set_lt.h"
+#include "char_traits_lt.h"
+#include "hash_bytes_lt.h"
+#include "string_search_lt.h"
+
+namespace leistd {
+
+/*============ 只读字符串视图 ============*/
+// 不拥有内存，只记录 (指针, 长度)。basic_string 的查找函数都转发到这里，窄字符走向量化引擎。
+template <typename CharT, typename Traits = char_traits<CharT> >
+class basic_string_view {
+public:
+  using traits_type = Traits;
+  using value_type = CharT;
+  using size_type = std::size_t;
+  using const_pointer = const CharT*;
+  using const_reference = const CharT&;
+  using const_iterator = const CharT*;
+  using iterator = const_iterator;
+
+  static constexpr size_t npos = -1;
+
+  constexpr basic_string_view() noexcept : _data(nullptr), _size(0) {}
+  constexpr basic_string_view(const CharT* s, size_t n) noexcept : _data(s), _size(n) {}
+  basic_string_view(const CharT* s) : _data(s), _size(Traits::length(s)) {}
+
+  // 观察器
+  constexpr const CharT* data() const noexcept { return _data; }
+  constexpr size_t size() const noexcept { return _size; }
+  constexpr size_t length() const noexcept { return _size; }
+  constexpr bool empty() const noexcept { return _size == 0; }
+
+  constexpr const_iterator begin() const noexcept { return _data; }
+  constexpr const_iterator end() const noexcept { return _data + _size; }
+  constexpr const_iterator cbegin() const noexcept { return _data; }
+  constexpr const_iterator cend() const noexcept { return _data + _size; }
+
+  // 访问
+  /* 不做越界检查 */
+  constexpr const CharT& operator[](size_t pos) const noexcept { return _data[pos]; }
+
+  const CharT& at(size_t pos) const {
+    if (pos >= _size) throw std::out_of_range("basic_string_view::at: index out of range");
+    return _data[pos];
+  }
+
+  constexpr const CharT& front() const noexcept { return _data[0]; }
+  constexpr const CharT& back() const noexcept { return _data[_size - 1]; }
+
+  // 修改视图本身（不影响底层字符）
+  constexpr void remove_prefix(size_t n) noexcept {
+    _data += n;
+    _size -= n;
+  }
+  constexpr void remove_suffix(size_t n) noexcept { _size -= n; }
+
+  basic_string_view substr(size_t pos = 0, size_t count = npos) const {
+    if (pos > _size) throw std::out_of_range("basic_string_view::substr: pos out of range");
+    return basic_string_view(_data + pos, std::min(count, _size - pos));
+  }
+
+  // 比较
+  int compare(basic_string_view other) const noexcept {
+    size_t n = std::min(_size, other._size);
+    int r = Traits::compare(_data, other._data, n);
+    if (r != 0) return r;
+    return _size < other._size ? -1 : (_size > other._size ? 1 : 0);
+  }
+
+  int compare(size_t pos, size_t count, basic_string_view other) const { return substr(pos, count).compare(other); }
+
+  bool starts_with(basic_string_view prefix) const noexcept {
+    return _size >= prefix._size && Traits::compare(_data, prefix._data, prefix._size) == 0;
+  }
+
+  bool ends_with(basic_string_view suffix) const noexcept {
+    return _size >= suffix._size && Traits::compare(_data + _size - suffix._size, suffix._data, suffix._size) == 0;
+  }
+
+  /* 查找 */
+  // 查找 s 的前 n 个字符：char 交给向量化查找引擎，其余字符类型先找首字符再比较整段
+  size_t find(const CharT* s, size_t pos, size_t n) const noexcept {
+    if (pos > _size) return npos;
+    if (n == 0) return pos;  // 空子串，约定返回 pos
+
+    if constexpr (narrow_char) {
+      size_t r = find_substring(_data + pos, _size - pos, s, n);
+      return r == search_npos ? npos : pos + r;
+    } else {
+      if (n > _size - pos) return npos;
+
+      const CharT* cur = _data + pos;
+      const CharT* last = _data + (_size - n);
+      while (cur <= last) {
+        cur = Traits::find(cur, last - cur + 1, s[0]);
+        if (!cur) return npos;  // 没找到
+        if (Traits::compare(cur + 1, s + 1, n - 1) == 0) return cur - _data;  // 找到，返回起点
+        ++cur;
+      }
+      return npos;
+    }
+  }
+
+  size_t find(basic_string_view sv, size_t pos = 0) const noexcept { return find(sv._data, pos, sv._size); }
+  size_t find(CharT ch, size_t pos = 0) const noexcept { return find(&ch, pos, 1); }
+  size_t find(const CharT* s, size_t pos = 0) const { return find(s, pos, Traits::length(s)); }
+
+  // 从 pos（含）向前查找子串最后一次出现的位置
+  size_t rfind(const CharT* s, size_t pos, size_t n) const noexcept {
+    if (n > _size) return npos;
+    size_t i = std::min(pos, _size - n);
+    do {
+      if (Traits::compare(_data + i, s, n) == 0) return i;
+    } while (i-- > 0);
+    return npos;
+  }
+
+  size_t rfind(basic_string_view sv, size_t pos = npos) const noexcept { return rfind(sv._data, pos, sv._size); }
+  size_t rfind(CharT ch, size_t pos = npos) const noexcept { return rfind(&ch, pos, 1); }
+  size_t rfind(const CharT* s, size_t pos = npos) const { return rfind(s, pos, Traits::length(s)); }
+
+  // 从指定位置 pos 开始，查找 第一个在 chars 中出现的字符，注意不是把chars作为子串查找
+  size_t find_first_of(const CharT* chars, size_t pos, size_t n) const { return find_in_set(chars, n, pos, false); }
+  size_t find_first_of(basic_string_view chars, size_t pos = 0) const {
+    return find_first_of(chars._data, pos, chars._size);
+  }
+  size_t find_first_of(CharT ch, size_t pos = 0) const { return find(ch, pos); }
+
+  // 从 pos 开始，查找 第一个不在 chars 中的字符
+  size_t find_first_not_of(const CharT* chars, size_t pos, size_t n) const {
+    return find_in_set(chars, n, pos, true);
+  }
+  size_t find_first_not_of(basic_string_view chars, size_t pos = 0) const {
+    return find_first_not_of(chars._data, pos, chars._size);
+  }
+  size_t find_first_not_of(CharT ch, size_t pos = 0) const { return find_first_not_of(&ch, pos, 1); }
+
+  // 从指定位置 pos 向前（从右到左）查找 最后一个在 chars 中出现的字符
+  size_t find_last_of(const CharT* chars, size_t pos, size_t n) const { return rfind_in_set(chars, n, pos, false); }
+  size_t find_last_of(basic_string_view chars, size_t pos = npos) const {
+    return find_last_of(chars._data, pos, chars._size);
+  }
+  size_t find_last_of(CharT ch, size_t pos = npos) const { return find_last_of(&ch, pos, 1); }
+
+  // 从 pos 向前查找 最后一个不在 chars 中的字符
+  size_t find_last_not_of(const CharT* chars, size_t pos, size_t n) const {
+    return rfind_in_set(chars, n, pos, true);
+  }
+  size_t find_last_not_of(basic_string_view chars, size_t pos = npos) const {
+    return find_last_not_of(chars._data, pos, chars._size);
+  }
+  size_t find_last_not_of(CharT ch, size_t pos = npos) const { return find_last_not_of(&ch, pos, 1); }
+
+  /* ===操作符重载=== */
+  friend bool operator==(basic_string_view lhs, basic_string_view rhs) noexcept {
+    return lhs._size == rhs._size && Traits::compare(lhs._data, rhs._data, lhs._size) == 0;
+  }
+
+  friend bool operator<(basic_string_view lhs, basic_string_view rhs) noexcept { return lhs.compare(rhs) < 0; }
+
+  friend std::ostream& operator<<(std::ostream& os, basic_string_view sv) { return os.write(sv._data, sv._size); }
+
+private:
+  static constexpr bool narrow_char = std::is_same_v<CharT, char> && std::is_same_v<Traits, char_traits<char> >;
+
+  static bool in_set(CharT c, const CharT* chars, size_t n) { return Traits::find(chars, n, c) != nullptr; }
+
+  // find_first_of / find_first_not_of 的公共实现：从 pos 向后找第一个（不）属于 chars 的字符
+  size_t find_in_set(const CharT* chars, size_t n, size_t pos, bool negate) const {
+    if (pos >= _size) return npos;
+
+    if constexpr (narrow_char) {
+      size_t r = char_set(chars, n).find_first(_data + pos, _size - pos, negate);
+      return r == search_npos ? npos : pos + r;
+    } else {
+      for (size_t i = pos; i < _size; ++i)
+        if (in_set(_data[i], chars, n) != negate) return i;
+      return npos;  // 没找到
+    }
+  }
+
+  // find_last_of / find_last_not_of 的公共实现：从 pos（含）向前找
+  size_t rfind_in_set(const CharT* chars, size_t n, size_t pos, bool negate) const {
+    if (_size == 0) return npos;
+    size_t len = (pos >= _size ? _size : pos + 1);  // 参与查找的是 [0, len)
+
+    if constexpr (narrow_char) {
+      size_t r = char_set(chars, n).find_last(_data, len, negate);
+      return r == search_npos ? npos : r;
+    } else {
+      for (size_t i = len; i-- > 0;)
+        if (in_set(_data[i], chars, n) != negate) return i;
+      return npos;
+    }
+  }
+
+  const CharT* _data;
+  size_t _size;
+};
+
+using string_view = basic_string_view<char>;
+
+}  // namespace leistd
+
+// 按字符的字节表示哈希，与同内容的 basic_string 哈希值相同
+template <typename CharT, typename Traits>
+struct std::hash<leistd::basic_string_view<CharT, Traits> > {
+  std::size_t operator()(leistd::basic_string_view<CharT, Traits> s) const noexcept {
+    return static_cast<std::size_t>(leistd::hash_bytes(s.data(), s.size() * sizeof(CharT)));
+  }
+};
@@ -0,0 +1,542 @@
+#pragma once
+#include <algorithm>         // max, min
+#include <cstddef>           // size_t, ptrdiff_t
+#include <initializer_list>
+#include <iterator>
+#include <memory>            // allocator_traits
+#include <new>               // launder
+#include <type_traits>
+#include <utility>
+
+#include "relocate_lt.h"
+
+namespace leistd {
+
+// 默认每块约 256 字节的元素，至少 4 个
+template <typename T>
+inline constexpr std::size_t unrolled_default_chunk_size = std::max<std::size_t>(4, 256 / sizeof(T));
+
+/*============ 展开链表 ============*/
+// 每个节点（块）存放至多 ChunkSize 个元素，块内元素占据连续槽位 [lo, hi)：
+// - 遍历时大部分 ++ 只是块内下标加一，每 ChunkSize 个元素才跳一次指针，小 T 的指针开销也摊到了整块上
+// - 首块前面、尾块后面留有空槽时 push_front/push_back 直接构造，用完才新开一块，两端都是 O(1) 摊还
+// - 中间插入/删除只平移本块内较短的一侧；满块插入时对半拆开，删除后过于稀疏的块与后继合并
+// - splice 按块重新链接：最多在切口处拆开两三个块（O(ChunkSize)），被搬运的块本身不拷贝元素
+// 与 list 不同，迭代器指向（块，槽位）：插入、删除、拆块、并块会使同一块（及被并入的块）中的迭代器失效，
+// 其他块中的迭代器不受影响。块内平移要求 T 可以不抛异常地移动（或可平凡重定位）。
+template <typename T, std::size_t ChunkSize = unrolled_default_chunk_size<T>, typename Alloc = std::allocator<T>>
+class unrolled_list {
+  static_assert(ChunkSize >= 2 && ChunkSize <= 65535, "unrolled_list: ChunkSize out of range");
+  static_assert(std::is_nothrow_move_constructible_v<T> || is_trivially_relocatable_v<T>,
+                "unrolled_list: T must be nothrow move constructible");
+
+private:
+  /*============ 块结构 ============*/
+  // 哨兵只有块头，lo == hi == 0，end() 就是（哨兵，0）
+  struct chunk_base {
+    chunk_base* prev;
+    chunk_base* next;
+    unsigned lo;
+    unsigned hi;
+
+    unsigned count() const noexcept { return hi - lo; }
+  };
+
+  struct chunk : chunk_base {
+    alignas(T) unsigned char storage[ChunkSize * sizeof(T)];
+
+    T* slot(unsigned i) noexcept { return std::launder(reinterpret_cast<T*>(storage + i * sizeof(T))); }
+  };
+
+  static T* slot(chunk_base* c, unsigned i) noexcept { return static_cast<chunk*>(c)->slot(i); }
+
+  /*============ 迭代器定义 ============*/
+  template <typename Ref, typename Ptr>
+  struct unrolled_iterator {
+    using value_type = T;
+    using reference = Ref;
+    using pointer = Ptr;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::bidirectional_iterator_tag;
+
+    chunk_base* node;
+    unsigned idx;
+
+    unrolled_iterator(chunk_base* n = nullptr, unsigned i = 0) : node(n), idx(i) {}
+    unrolled_iterator(const unrolled_iterator<T&, T*>& it) : node(it.node), idx(it.idx) {}  // 非 const -> const
+    unrolled_iterator& operator=(const unrolled_iterator&) = default;
+
+    reference operator*() const { return *slot(node, idx); }
+    pointer operator->() const { return slot(node, idx); }
+
+    unrolled_iterator& operator++() {
+      if (++idx == node->hi) {
+        node = node->next;
+        idx = node->lo;
+      }
+      return *this;
+    }
+    unrolled_iterator operator++(int) {
+      unrolled_iterator tmp(*this);
+      ++(*this);
+      return tmp;
+    }
+
+    unrolled_iterator& operator--() {
+      if (idx == node->lo) {
+        node = node->prev;
+        idx = node->hi;
+      }
+      --idx;
+      return *this;
+    }
+    unrolled_iterator operator--(int) {
+      unrolled_iterator tmp(*this);
+      --(*this);
+      return tmp;
+    }
+
+    bool operator==(const unrolled_iterator& rhs) const { return node == rhs.node && idx == rhs.idx; }
+    bool operator!=(const unrolled_iterator& rhs) const { return !(*this == rhs); }
+  };
+
+public:
+  /*============ 类型定义 ============*/
+  using value_type = T;
+  using allocator_type = Alloc;
+  using size_type = std::size_t;
+  using iterator = unrolled_iterator<T&, T*>;
+  using const_iterator = unrolled_iterator<const T&, const T*>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  static constexpr std::size_t chunk_size = ChunkSize;
+
+  /*============ 构造/析构 ============*/
+  unrolled_list() : unrolled_list(Alloc()) {}
+
+  explicit unrolled_list(const Alloc& alloc) : _M_size(0), _M_alloc(alloc) { _M_reset_head(); }
+
+  unrolled_list(std::initializer_list<T> ilist, const Alloc& alloc = Alloc()) : unrolled_list(alloc) {
+    for (auto& x : ilist) push_back(x);
+  }
+
+  unrolled_list(const unrolled_list& other)
+      : unrolled_list(Alloc(ChunkTraits::select_on_container_copy_construction(other._M_alloc))) {
+    for (auto& x : other) push_back(x);
+  }
+
+  unrolled_list(unrolled_list&& other) noexcept : _M_size(0), _M_alloc(other._M_alloc) {
+    _M_reset_head();
+    _M_take_chunks(other);
+  }
+
+  unrolled_list& operator=(const unrolled_list& other) {
+    if (this == &other) return *this;
+    clear();
+    if constexpr (ChunkTraits::propagate_on_container_copy_assignment::value) _M_alloc = other._M_alloc;
+    for (auto& x : other) push_back(x);
+    return *this;
+  }
+
+  // 分配器会传播或两边相等时直接接管所有块，否则逐个移动元素
+  unrolled_list& operator=(unrolled_list&& other) {
+    if (this == &other) return *this;
+    clear();
+    if (_M_can_steal(other)) {
+      if constexpr (ChunkTraits::propagate_on_container_move_assignment::value) _M_alloc = other._M_alloc;
+      _M_take_chunks(other);
+    } else {
+      for (auto& x : other) push_back(std::move(x));
+      other.clear();
+    }
+    return *this;
+  }
+
+  ~unrolled_list() { clear(); }
+
+  // 哨兵嵌在对象内部，交换时要修正首尾块指回哨兵的指针
+  friend void swap(unrolled_list& lhs, unrolled_list& rhs) noexcept {
+    using std::swap;
+    swap(lhs._M_head, rhs._M_head);
+    swap(lhs._M_size, rhs._M_size);
+    lhs._M_fix_head();
+    rhs._M_fix_head();
+    if constexpr (ChunkTraits::propagate_on_container_swap::value) swap(lhs._M_alloc, rhs._M_alloc);
+  }
+
+  allocator_type get_allocator() const { return Alloc(_M_alloc); }
+
+  /*============ 容量接口 ============*/
+  bool empty() const { return _M_size == 0; }
+  size_type size() const { return _M_size; }
+
+  // 当前占用的块数；size() / (chunk_count() * ChunkSize) 即槽位利用率
+  size_type chunk_count() const {
+    size_type n = 0;
+    for (const chunk_base* c = _M_head.next; c != &_M_head; c = c->next) ++n;
+    return n;
+  }
+
+  /*============ 迭代器接口 ============*/
+  iterator begin() { return iterator(_M_head.next, _M_head.next->lo); }
+  iterator end() { return iterator(&_M_head, 0); }
+
+  const_iterator begin() const { return const_iterator(_M_head.next, _M_head.next->lo); }
+  const_iterator end() const { return const_iterator(_M_sentinel(), 0); }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
+
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+  const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+  /*============ 访问接口 ============*/
+  T& front() { return *slot(_M_head.next, _M_head.next->lo); }
+  const T& front() const { return *slot(_M_head.next, _M_head.next->lo); }
+
+  T& back() { return *slot(_M_head.prev, _M_head.prev->hi - 1); }
+  const T& back() const { return *slot(_M_head.prev, _M_head.prev->hi - 1); }
+
+  /*============ 两端插入/删除 ============*/
+  void push_back(const T& value) { emplace_back(value); }
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+
+  void push_front(const T& value) { emplace_front(value); }
+  void push_front(T&& value) { emplace_front(std::move(value)); }
+
+  // 尾块后面还有空槽就直接构造，否则新开一块，新块从槽位 0 开始向后填
+  template <typename... Args>
+  T& emplace_back(Args&&... args) {
+    chunk_base* c = _M_head.prev;
+    if (c == &_M_head || c->hi == ChunkSize) c = _M_insert_chunk(&_M_head, 0);
+    _M_construct_in(c, c->hi, std::forward<Args>(args)...);
+    ++c->hi;
+    ++_M_size;
+    return *slot(c, c->hi - 1);
+  }
+
+  // 首块前面还有空槽就直接构造，否则新开一块，新块从最后一个槽位开始向前填
+  template <typename... Args>
+  T& emplace_front(Args&&... args) {
+    chunk_base* c = _M_head.next;
+    if (c == &_M_head || c->lo == 0) c = _M_insert_chunk(c, ChunkSize);
+    _M_construct_in(c, c->lo - 1, std::forward<Args>(args)...);
+    --c->lo;
+    ++_M_size;
+    return *slot(c, c->lo);
+  }
+
+  void pop_back() {
+    if (empty()) return;
+    chunk_base* c = _M_head.prev;
+    ChunkTraits::destroy(_M_alloc, slot(c, --c->hi));
+    if (c->lo == c->hi) _M_free_chunk(c);
+    --_M_size;
+  }
+
+  void pop_front() {
+    if (empty()) return;
+    chunk_base* c = _M_head.next;
+    ChunkTraits::destroy(_M_alloc, slot(c, c->lo++));
+    if (c->lo == c->hi) _M_free_chunk(c);
+    --_M_size;
+  }
+
+  /*============ 中间插入/删除 ============*/
+  iterator insert(const_iterator pos, const T& value) { return emplace(pos, value); }
+  iterator insert(const_iterator pos, T&& value) { return emplace(pos, std::move(value)); }
+
+  // 插入多个相同元素 / 区间 [first, last)：先装进临时链表，再整串按块拼到 pos 前。
+  // 返回第一个插入元素的迭代器，没有插入时返回 pos
+  iterator insert(const_iterator pos, size_type count, const T& value) {
+    unrolled_list tmp(get_allocator());
+    while (count--) tmp.push_back(value);
+    return _M_splice_all(pos, tmp);
+  }
+
+  template <std::input_iterator InputIt>
+  iterator insert(const_iterator pos, InputIt first, InputIt last) {
+    unrolled_list tmp(get_allocator());
+    for (; first != last; ++first) tmp.push_back(*first);
+    return _M_splice_all(pos, tmp);
+  }
+
+  iterator insert(const_iterator pos, std::initializer_list<T> ilist) {
+    return insert(pos, ilist.begin(), ilist.end());
+  }
+
+  // 在 pos 前构造元素：块未满时平移较短一侧腾出槽位，满块先对半拆开
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args&&... args) {
+    if (pos.node == _M_head.next && pos.idx == pos.node->lo) {
+      emplace_front(std::forward<Args>(args)...);
+      return begin();
+    }
+    if (pos.node == &_M_head) {
+      emplace_back(std::forward<Args>(args)...);
+      return iterator(_M_head.prev, _M_head.prev->hi - 1);
+    }
+
+    // 先构造好再平移，构造抛异常时链表保持原样
+    T value(std::forward<Args>(args)...);
+    chunk_base* c = pos.node;
+    unsigned i = pos.idx;
+
+    // 插到块首且前一块尾部有空槽：直接追加到前一块
+    chunk_base* p = c->prev;
+    if (i == c->lo && p != &_M_head && p->hi < ChunkSize) {
+      ChunkTraits::construct(_M_alloc, slot(p, p->hi), std::move(value));
+      ++_M_size;
+      return iterator(p, p->hi++);
+    }
+
+    if (c->count() == ChunkSize) {
+      unsigned mid = c->lo + ChunkSize / 2;
+      chunk_base* tail = _M_split(c, mid);
+      if (i >= mid) c = tail;
+    }
+
+    // 选择搬动较少元素的一侧；只有一侧有空槽时只能搬那一侧
+    bool shift_left = c->lo > 0 && (c->hi == ChunkSize || i - c->lo < c->hi - i);
+    if (shift_left) {
+      relocate_overlapping(_M_alloc, slot(c, c->lo), slot(c, i), slot(c, c->lo - 1));
+      --c->lo;
+      --i;
+    } else {
+      relocate_overlapping(_M_alloc, slot(c, i), slot(c, c->hi), slot(c, i + 1));
+      ++c->hi;
+    }
+    ChunkTraits::construct(_M_alloc, slot(c, i), std::move(value));
+    ++_M_size;
+    return iterator(c, i);
+  }
+
+  // 删除 pos 处元素，返回其后继。块被删空则释放；块变得稀疏时尝试与后继块合并
+  iterator erase(const_iterator pos) {
+    chunk_base* c = pos.node;
+    unsigned i = pos.idx;
+    ChunkTraits::destroy(_M_alloc, slot(c, i));
+    --_M_size;
+
+    iterator next;
+    if (i - c->lo < c->hi - i - 1) {
+      relocate_overlapping(_M_alloc, slot(c, c->lo), slot(c, i), slot(c, c->lo + 1));
+      ++c->lo;
+      next = iterator(c, i + 1);
+    } else {
+      relocate_overlapping(_M_alloc, slot(c, i + 1), slot(c, c->hi), slot(c, i));
+      --c->hi;
+      next = iterator(c, i);
+    }
+
+    if (c->lo == c->hi) {
+      chunk_base* n = c->next;
+      _M_free_chunk(c);
+      return iterator(n, n->lo);
+    }
+    if (c->count() < ChunkSize / 4 && c->next != &_M_head && c->count() + c->next->count() <= ChunkSize / 2) {
+      // 上面构造的 next 总在 c 里；合并把 c 的元素挪到从 0 开始
+      unsigned old_lo = c->lo;
+      _M_merge_next(c);
+      next.idx -= old_lo;
+    }
+    _M_normalize(next);
+    return next;
+  }
+
+  // 删除 [first, last)：先数出个数，避免并块使 last 失效
+  iterator erase(const_iterator first, const_iterator last) {
+    size_type n = std::distance(first, last);
+    iterator cur = _M_mutable(first);
+    while (n--) cur = erase(cur);
+    return cur;
+  }
+
+  void clear() {
+    chunk_base* c = _M_head.next;
+    while (c != &_M_head) {
+      chunk_base* next = c->next;
+      destroy_range(_M_alloc, slot(c, c->lo), slot(c, c->hi));
+      ChunkTraits::deallocate(_M_alloc, static_cast<chunk*>(c), 1);
+      c = next;
+    }
+    _M_reset_head();
+    _M_size = 0;
+  }
+
+  /*============ 按块拼接 ============*/
+  // 把 other 的全部块挂到 pos 前；pos 在块中间时先把该块从 pos 处拆开。两边分配器必须相等
+  void splice(const_iterator pos, unrolled_list& other) {
+    if (this != &other) _M_splice_all(pos, other);
+  }
+
+  void splice(const_iterator pos, unrolled_list& other, const_iterator it) {
+    splice(pos, other, it, std::next(it));
+  }
+
+  // [first, last)：在 first、last、pos 三处切开（各至多拆一块），再整串搬运中间的块，
+  // 元素个数按块累加，是 O(块数) 而不是 O(元素数)。pos 不能落在 [first, last) 内
+  void splice(const_iterator pos, unrolled_list& other, const_iterator first, const_iterator last) {
+    if (first == last) return;
+    chunk_base* split;
+    chunk_base* f = other._M_split_before(first, &split);
+    _M_follow_split(last, split);
+    _M_follow_split(pos, split);
+    chunk_base* l = other._M_split_before(last, &split);
+    _M_follow_split(pos, split);
+    chunk_base* at = _M_split_before(pos);
+    if (at == f || at == l) return;  // pos 就是区间的起点或终点：顺序不变
+
+    chunk_base* tail = l->prev;
+    size_type n = 0;
+    for (chunk_base* c = f; c != l; c = c->next) n += c->count();
+
+    f->prev->next = l;
+    l->prev = f->prev;
+    _M_link_before(at, f, tail);
+    other._M_size -= n;
+    _M_size += n;
+  }
+
+  /*============ 操作符重载 ============*/
+  friend bool operator==(const unrolled_list& lhs, const unrolled_list& rhs) {
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+  }
+
+private:
+  /*============ 内存管理 ============*/
+  using ChunkAlloc = typename std::allocator_traits<Alloc>::template rebind_alloc<chunk>;
+  using ChunkTraits = std::allocator_traits<ChunkAlloc>;
+
+  chunk_base* _M_sentinel() const noexcept { return const_cast<chunk_base*>(&_M_head); }
+
+  iterator _M_mutable(const_iterator it) const noexcept { return iterator(it.node, it.idx); }
+
+  void _M_reset_head() noexcept { _M_head = chunk_base{&_M_head, &_M_head, 0, 0}; }
+
+  // _M_head 被整体拷贝/交换后，让首尾块重新指回本对象的哨兵
+  void _M_fix_head() noexcept {
+    if (_M_size == 0) {
+      _M_reset_head();
+      return;
+    }
+    _M_head.next->prev = &_M_head;
+    _M_head.prev->next = &_M_head;
+  }
+
+  // 把 other 的全部块挂到 pos 前，返回第一个挂进来的元素；other 为空时返回 pos
+  iterator _M_splice_all(const_iterator pos, unrolled_list& other) {
+    if (other.empty()) return _M_mutable(pos);
+    chunk_base* at = _M_split_before(pos);
+    chunk_base* first = other._M_head.next;
+    chunk_base* last = other._M_head.prev;
+    size_type n = other._M_size;
+    other._M_reset_head();
+    other._M_size = 0;
+    _M_link_before(at, first, last);
+    _M_size += n;
+    return iterator(first, first->lo);
+  }
+
+  void _M_take_chunks(unrolled_list& other) noexcept {
+    if (other.empty()) return;
+    _M_head = other._M_head;
+    _M_size = other._M_size;
+    _M_fix_head();
+    other._M_reset_head();
+    other._M_size = 0;
+  }
+
+  bool _M_can_steal(const unrolled_list& other) const noexcept {
+    if constexpr (ChunkTraits::propagate_on_container_move_assignment::value || ChunkTraits::is_always_equal::value)
+      return true;
+    else
+      return _M_alloc == other._M_alloc;
+  }
+
+  // 在 pos 前插入一个空块，槽位区间为 [start, start)
+  chunk_base* _M_insert_chunk(chunk_base* pos, unsigned start) {
+    chunk_base* c = ChunkTraits::allocate(_M_alloc, 1);
+    c->lo = c->hi = start;
+    _M_link_before(pos, c, c);
+    return c;
+  }
+
+  // 在 c 的槽位 i 构造元素；构造抛异常且 c 是刚开的空块时把它释放掉
+  template <typename... Args>
+  void _M_construct_in(chunk_base* c, unsigned i, Args&&... args) {
+    try {
+      ChunkTraits::construct(_M_alloc, slot(c, i), std::forward<Args>(args)...);
+    } catch (...) {
+      if (c->lo == c->hi) _M_free_chunk(c);
+      throw;
+    }
+  }
+
+  // 释放一个已经没有元素的块
+  void _M_free_chunk(chunk_base* c) noexcept {
+    c->prev->next = c->next;
+    c->next->prev = c->prev;
+    ChunkTraits::deallocate(_M_alloc, static_cast<chunk*>(c), 1);
+  }
+
+  static void _M_link_before(chunk_base* pos, chunk_base* first, chunk_base* last) noexcept {
+    chunk_base* prev = pos->prev;
+    prev->next = first;
+    first->prev = prev;
+    last->next = pos;
+    pos->prev = last;
+  }
+
+  // 把 c 的 [at, hi) 搬到紧随其后的新块，新块沿用相同的槽位下标 [at, hi)，返回新块
+  chunk_base* _M_split(chunk_base* c, unsigned at) {
+    chunk_base* tail = _M_insert_chunk(c->next, at);
+    uninitialized_relocate(_M_alloc, slot(c, at), slot(c, c->hi), slot(tail, at));
+    tail->hi = c->hi;
+    c->hi = at;
+    return tail;
+  }
+
+  // 返回以 pos 为第一个元素的块（pos == end() 时返回哨兵），必要时拆块；拆出的新块通过 split 传出
+  chunk_base* _M_split_before(const_iterator pos, chunk_base** split = nullptr) {
+    if (split) *split = nullptr;
+    if (pos.idx == pos.node->lo) return pos.node;
+    chunk_base* tail = _M_split(pos.node, pos.idx);
+    if (split) *split = pos.node;
+    return tail;
+  }
+
+  // c 在 split 处被拆过时，原先指向后半段的迭代器挪到新块；新块槽位下标不变
+  static void _M_follow_split(const_iterator& it, chunk_base* c) noexcept {
+    if (c && it.node == c && it.idx >= c->hi) it.node = c->next;
+  }
+
+  // 槽位越过块尾的迭代器挪到下一块开头
+  static void _M_normalize(iterator& it) noexcept {
+    if (it.idx == it.node->hi && it.node->lo != it.node->hi) {
+      it.node = it.node->next;
+      it.idx = it.node->lo;
+    }
+  }
+
+  // 把后继块的元素并入 c：c 的元素先挪到槽位 0 开头，后继块紧接其后，然后释放后继块
+  void _M_merge_next(chunk_base* c) {
+    chunk_base* n = c->next;
+    unsigned cnt = c->count();
+    relocate_overlapping(_M_alloc, slot(c, c->lo), slot(c, c->hi), slot(c, 0));
+    uninitialized_relocate(_M_alloc, slot(n, n->lo), slot(n, n->hi), slot(c, cnt));
+    c->lo = 0;
+    c->hi = cnt + n->count();
+    n->lo = n->hi;
+    _M_free_chunk(n);
+  }
+
+private:
+  chunk_base _M_head;  // 哨兵，嵌在对象里
+  size_type _M_size;
+  ChunkAlloc _M_alloc;
+};
+
+}  // namespace leistd
@@ -1,11 +1,24 @@
 #pragma once
+#include <algorithm>
+#include <functional>
 #include <initializer_list>
+#include <iterator>
 #include <memory>
 #include <stdexcept>
+#include <type_traits>
+
+#include "allocator_lt.h"
+#include "growth_policy_lt.h"
+#include "relocate_lt.h"
 
 namespace leistd {
-template <typename T, typename Alloc = std::allocator<T>>
+template <typename T, std::size_t N, typename Alloc, typename GrowthPolicy>
+class small_vector;
+
+template <typename T, typename Alloc = std::allocator<T>, typename GrowthPolicy = growth_factor_2x>
 class vector {
+  using _alloc_traits = std::allocator_traits<Alloc>;
+
   public:
   using value_type = T;
   using allocator_type = Alloc;
@@ -266,8 +279,12 @@ private:
   vector() : _start(nullptr), _end(nullptr), _cap(nullptr) {
   }
 
-  vector(std::initializer_list<T> init)
-      : _start(nullptr), _end(nullptr), _cap(nullptr) {
+  // 有状态的分配器（如 arena_allocator）没有默认构造，需要从这里传入
+  explicit vector(const Alloc& alloc) : _alloc(alloc), _start(nullptr), _end(nullptr), _cap(nullptr) {
+  }
+
+  vector(std::initializer_list<T> init, const Alloc& alloc = Alloc())
+      : _alloc(alloc), _start(nullptr), _end(nullptr), _cap(nullptr) {
     reserve(init.size());
     for (auto& val : init) {
       std::allocator_traits<Alloc>::construct(_alloc, _end, val);
@@ -279,6 +296,10 @@ private:
 
   vector(vector&& other) noexcept;
 
+  allocator_type get_allocator() const {
+    return _alloc;
+  }
+
   ~vector();
 
   void push_back(T&& value);
@@ -289,6 +310,8 @@ private:
 
   void reserve(size_type n);
 
+  void shrink_to_fit();
+
   void clear();
 
   bool empty() const;
@@ -305,7 +328,14 @@ private:
 
   vector& operator=(const vector& rhs);
 
-  vector& operator=(vector&& other) noexcept;
+  vector& operator=(vector&& other) noexcept(_alloc_traits::propagate_on_container_move_assignment::value ||
+                                              _alloc_traits::is_always_equal::value);
+
+  void swap(vector& other) noexcept;
+
+  friend void swap(vector& lhs, vector& rhs) noexcept {
+    lhs.swap(rhs);
+  }
 
   bool operator==(const vector& other) const;
 
@@ -355,68 +385,46 @@ private:
   /*支持insert*/
   // 插入单个元素
   iterator insert(const_iterator pos, const T& value) {
-    size_type idx = pos - cbegin();
-    if (_end == _cap) {
-      reserve(capacity() == 0 ? 1 : capacity() * 2);
-    }
-
-    // 移动元素（从 idx 到尾部，往后挪一位）
-    std::move_backward(_start + idx, _end, _end + 1);
-    // 插入元素
-    std::allocator_traits<Alloc>::construct(_alloc, _start + idx, value);
-    ++_end;
-    return iterator(_start + idx);
+    if (_M_aliases(value)) return insert(pos, T(value));  // value 在本容器内，先拷出来再插入
+    return _M_insert_n(pos - cbegin(), 1, [&](pointer dst) {
+      std::allocator_traits<Alloc>::construct(_alloc, dst, value);
+    });
   }
 
   iterator insert(const_iterator pos, T&& value) {
-    size_type idx = pos - cbegin();
-    if (_end == _cap) {
-      reserve(capacity() == 0 ? 1 : capacity() * 2);
-    }
-
-    // 移动元素（从 idx 到尾部，往后挪一位）
-    std::move_backward(_start + idx, _end, _end + 1);
-    // 插入元素
-    std::allocator_traits<Alloc>::construct(_alloc, _start + idx,
-                                            std::move(value));
-    ++_end;
-    return iterator(_start + idx);
+    if (_M_aliases(value)) return insert(pos, T(std::move(value)));
+    return _M_insert_n(pos - cbegin(), 1, [&](pointer dst) {
+      std::allocator_traits<Alloc>::construct(_alloc, dst, std::move(value));
+    });
   }
 
   // 插入 count 个 value
   iterator insert(const_iterator pos, size_type count, const T& value) {
-    size_type idx = pos - cbegin();
-
-    if (size() + count > capacity()) {
-      reserve(std::max(capacity() * 2, size() + count));
-    }
-    std::move_backward(_start + idx, _end, _end + count);
-
-    for (size_type i = 0; i < count; ++i) {
-      std::allocator_traits<Alloc>::construct(_alloc, _start + idx + i, value);
-    }
-    _end += count;
-    return iterator(_start + idx);
+    if (_M_aliases(value)) return insert(pos, count, T(value));
+    return _M_insert_n(pos - cbegin(), count, [&](pointer dst) {
+      size_type i = 0;
+      try {
+        for (; i < count; ++i) std::allocator_traits<Alloc>::construct(_alloc, dst + i, value);
+      } catch (...) {
+        destroy_range(_alloc, dst, dst + i);
+        throw;
+      }
+    });
   }
 
   // 插入迭代器区间 [first, last)
-  template <class InputIt>
+  template <class InputIt, typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
   iterator insert(const_iterator pos, InputIt first, InputIt last) {
     size_type n = std::distance(first, last);
-    if (n == 0)
-      return begin() + (pos - cbegin());
-
-    size_type idx = pos - cbegin();
-    if (size() + n > capacity()) {
-      reserve(std::max(capacity() * 2, size() + n));
-    }
-
-    pointer insert_ptr = _start + idx;               // 原始指针
-    std::move_backward(insert_ptr, _end, _end + n);  // 使用指针，不是 iterator
-    std::copy(first, last, insert_ptr);
-
-    _end += n;
-    return iterator(insert_ptr);
+    return _M_insert_n(pos - cbegin(), n, [&](pointer dst) {
+      pointer cur = dst;
+      try {
+        for (; first != last; ++first, ++cur) std::allocator_traits<Alloc>::construct(_alloc, cur, *first);
+      } catch (...) {
+        destroy_range(_alloc, dst, cur);
+        throw;
+      }
+    });
   }
 
   iterator insert(const_iterator pos, std::initializer_list<T> ilist) {
@@ -426,40 +434,74 @@ private:
   /* 删除功能 */
   // 删除单个元素
   iterator erase(const_iterator pos) {
-    difference_type n = pos - cbegin();
-
-    // 把 [pos+1, end) 搬到 [pos, end-1)
-    std::move(_start + n + 1, _end, _start + n);
-
-    // destroy 最后一个元素
-    --_end;
-    std::allocator_traits<Alloc>::destroy(_alloc, _end);
-
-    return begin() + n;
+    return erase(pos, pos + 1);
   }
 
   // 删除一个区间 [first, last)
   iterator erase(const_iterator first, const_iterator last) {
+    pointer p = _start + (first - cbegin());
     if (first == last)
-      return begin() + (first - cbegin());
-
-    difference_type start = first - cbegin();
-    difference_type count = last - first;
-
-    // 把 [last, end) 搬到 [first, end-(last-first))
-    std::move(_start + start + count, _end, _start + start);
+      return iterator(p);
 
-    // destroy 尾部 count 个元素
-    pointer new_end = _end - count;
-    for (pointer p = new_end; p != _end; ++p) {
-      std::allocator_traits<Alloc>::destroy(_alloc, p);
+    pointer q = p + (last - first);
+    if constexpr (use_bitwise_relocate_v<Alloc, T>) {
+      // 先析构被删元素，再把尾部整体 memmove 过来
+      destroy_range(_alloc, p, q);
+      relocate_overlapping(_alloc, q, _end, p);
+    } else {
+      // 把 [last, end) 搬到 [first, end-(last-first))，再 destroy 尾部
+      pointer new_end = std::move(q, _end, p);
+      destroy_range(_alloc, new_end, _end);
     }
-    _end = new_end;
+    _end -= q - p;
 
-    return begin() + start;
+    return iterator(p);
   }
 
   private:
+  template <typename U, std::size_t N, typename A, typename G>
+  friend class small_vector;
+
+  // 尾部能否在原缓冲区内直接平移（不会抛异常）
+  static constexpr bool _can_shift_in_place =
+      use_bitwise_relocate_v<Alloc, T> || std::is_nothrow_move_constructible_v<T>;
+
+  // 分配器支持 realloc 式扩容时，元素按位搬动即可，不必先分配新块再逐段复制
+  static constexpr bool _can_reallocate = use_bitwise_relocate_v<Alloc, T> && allocator_has_reallocate_v<Alloc>;
+
+  bool _M_aliases(const T& value) const {
+    const T* p = std::addressof(value);
+    return !std::less<const T*>()(p, _start) && std::less<const T*>()(p, _end);
+  }
+
+  size_type _M_recommend(size_type need) const {
+    return std::max(GrowthPolicy::grow(capacity(), need, sizeof(T)), need);
+  }
+
+  template <typename Fill>
+  iterator _M_insert_n(size_type idx, size_type n, Fill fill);
+
+  template <typename Fill>
+  void _M_realloc_insert(size_type new_cap, size_type idx, size_type n, Fill& fill);
+
+  void _M_reallocate_in_place(size_type new_cap);
+
+  // 移动赋值时能否直接接管 other 的缓冲区
+  bool _M_can_steal(const vector& other) const noexcept {
+    if constexpr (_alloc_traits::propagate_on_container_move_assignment::value ||
+                  _alloc_traits::is_always_equal::value)
+      return true;
+    else
+      return _alloc == other._alloc;
+  }
+
+  // 释放缓冲区并置空（元素须已析构）
+  void _M_deallocate() noexcept {
+    if (_start)
+      std::allocator_traits<Alloc>::deallocate(_alloc, _start, capacity());
+    _start = _end = _cap = nullptr;
+  }
+
   Alloc _alloc;
   pointer _start;
   pointer _end;
@@ -471,107 +513,227 @@ private:
  * Implement vector
  */
 namespace leistd {
-template <typename T, typename Alloc>
-void vector<T, Alloc>::push_back(T&& value) {
-  if (_end == _cap)
-    reserve(capacity() == 0 ? 1 : capacity() * 2);
-  std::allocator_traits<Alloc>::construct(_alloc, _end, std::move(value));
-  ++_end;
+template <typename T, typename Alloc, typename GrowthPolicy>
+void vector<T, Alloc, GrowthPolicy>::push_back(T&& value) {
+  if (_end != _cap) {
+    std::allocator_traits<Alloc>::construct(_alloc, _end, std::move(value));
+    ++_end;
+    return;
+  }
+  if (_M_aliases(value))
+    return push_back(T(std::move(value)));  // realloc 扩容会让指向自身元素的引用失效
+  _M_insert_n(size(), 1, [&](pointer dst) {
+    std::allocator_traits<Alloc>::construct(_alloc, dst, std::move(value));
+  });
 }
 
-template <typename T, typename Alloc>
-void vector<T, Alloc>::push_back(const T& value) {
-  if (_end == _cap)
-    reserve(capacity() == 0 ? 1 : capacity() * 2);
-  std::allocator_traits<Alloc>::construct(_alloc, _end, value);
+template <typename T, typename Alloc, typename GrowthPolicy>
+void vector<T, Alloc, GrowthPolicy>::push_back(const T& value) {
+  if (_end != _cap) {
+    std::allocator_traits<Alloc>::construct(_alloc, _end, value);
+    ++_end;
+    return;
+  }
+  if (_M_aliases(value))
+    return push_back(T(value));
+  _M_insert_n(size(), 1, [&](pointer dst) {
+    std::allocator_traits<Alloc>::construct(_alloc, dst, value);
+  });
 }
 
-template <typename T, typename Alloc>
-void vector<T, Alloc>::pop_back() {
+template <typename T, typename Alloc, typename GrowthPolicy>
+void vector<T, Alloc, GrowthPolicy>::pop_back() {
   if (!empty()) {
     --_end;
     std::allocator_traits<Alloc>::destroy(_alloc, _end);
   }
 }
 
-template <typename T, typename Alloc>
-vector<T, Alloc>::~vector() {
+template <typename T, typename Alloc, typename GrowthPolicy>
+vector<T, Alloc, GrowthPolicy>::~vector() {
   clear();
   if (_start)
     std::allocator_traits<Alloc>::deallocate(_alloc, _start, capacity());
 }
 
-template <typename T, typename Alloc>
-void vector<T, Alloc>::reserve(size_type new_cap) {
+template <typename T, typename Alloc, typename GrowthPolicy>
+void vector<T, Alloc, GrowthPolicy>::reserve(size_type new_cap) {
   if (new_cap <= capacity())
     return;
 
-  pointer new_start = _alloc.allocate(new_cap);
-  pointer new_end = new_start;
+  if constexpr (_can_reallocate) {
+    _M_reallocate_in_place(new_cap);
+  } else {
+    auto no_fill = [](pointer) {};
+    _M_realloc_insert(new_cap, size(), 0, no_fill);
+  }
+}
+
+// 在 idx 处腾出 n 个未构造的槽位，由 fill(dst) 构造新元素。
+// fill 抛异常前需自行析构已构造的部分，这里负责把尾部搬回原位或丢弃新缓冲区。
+// fill 不能引用本容器内的元素（调用者负责先拷出来）。
+template <typename T, typename Alloc, typename GrowthPolicy>
+template <typename Fill>
+typename vector<T, Alloc, GrowthPolicy>::iterator
+vector<T, Alloc, GrowthPolicy>::_M_insert_n(size_type idx, size_type n, Fill fill) {
+  if (n == 0)
+    return iterator(_start + idx);
 
-  for (pointer p = _start; p != _end; ++p, ++new_end) {
-    std::allocator_traits<Alloc>::construct(_alloc, new_end, std::move(*p));
-    std::allocator_traits<Alloc>::destroy(_alloc, p);
+  // realloc 式扩容后就和容量充足的情况一样，在原缓冲区内平移尾部
+  if constexpr (_can_reallocate) {
+    if (size() + n > capacity())
+      _M_reallocate_in_place(_M_recommend(size() + n));
+  }
+
+  if constexpr (_can_shift_in_place) {
+    if (size() + n <= capacity()) {
+      pointer pos = _start + idx;
+      relocate_overlapping(_alloc, pos, _end, pos + n);
+      try {
+        fill(pos);
+      } catch (...) {
+        relocate_overlapping(_alloc, pos + n, _end + n, pos);
+        throw;
+      }
+      _end += n;
+      return iterator(pos);
+    }
+  }
+
+  // 移动可能抛异常的类型即使容量够也走新缓冲区，以保证强异常安全
+  size_type new_cap = size() + n <= capacity() ? capacity() : _M_recommend(size() + n);
+  _M_realloc_insert(new_cap, idx, n, fill);
+  return iterator(_start + idx);
+}
+
+// 分配 new_cap 的新缓冲区：先构造插入的 n 个元素，再把 [0, idx) 和 [idx, size) 两段重定位过去。
+// 任何一步抛异常，旧缓冲区保持原样（强异常保证）。
+template <typename T, typename Alloc, typename GrowthPolicy>
+template <typename Fill>
+void vector<T, Alloc, GrowthPolicy>::_M_realloc_insert(size_type new_cap, size_type idx, size_type n, Fill& fill) {
+  pointer new_start = std::allocator_traits<Alloc>::allocate(_alloc, new_cap);
+  pointer new_pos = new_start + idx;
+  pointer old_pos = _start + idx;
+  size_type new_size = size() + n;
+
+  try {
+    fill(new_pos);
+    if constexpr (use_bitwise_relocate_v<Alloc, T>) {
+      uninitialized_relocate(_alloc, _start, old_pos, new_start);
+      uninitialized_relocate(_alloc, old_pos, _end, new_pos + n);
+    } else {
+      // 两段都构造成功后才析构旧元素，否则无法回滚
+      pointer head_end = new_start;
+      try {
+        head_end = uninitialized_move_if_noexcept(_alloc, _start, old_pos, new_start);
+        uninitialized_move_if_noexcept(_alloc, old_pos, _end, new_pos + n);
+      } catch (...) {
+        destroy_range(_alloc, new_start, head_end);
+        destroy_range(_alloc, new_pos, new_pos + n);
+        throw;
+      }
+      destroy_range(_alloc, _start, _end);
+    }
+  } catch (...) {
+    std::allocator_traits<Alloc>::deallocate(_alloc, new_start, new_cap);
+    throw;
   }
 
   if (_start)
     std::allocator_traits<Alloc>::deallocate(_alloc, _start, capacity());
 
   _start = new_start;
-  _end = new_end;
+  _end = new_start + new_size;
+  _cap = new_start + new_cap;
+}
+
+// 通过分配器的 reallocate 扩容/缩容，内容按位保留（仅用于可平凡重定位的元素）
+template <typename T, typename Alloc, typename GrowthPolicy>
+void vector<T, Alloc, GrowthPolicy>::_M_reallocate_in_place(size_type new_cap) {
+  size_type old_size = size();
+  _start = _alloc.reallocate(_start, capacity(), new_cap);
+  _end = _start + old_size;
   _cap = _start + new_cap;
 }
 
-template <typename T, typename Alloc>
-void vector<T, Alloc>::clear() {
+// 把容量收缩到 size()，空容器直接释放缓冲区
+template <typename T, typename Alloc, typename GrowthPolicy>
+void vector<T, Alloc, GrowthPolicy>::shrink_to_fit() {
+  if (capacity() == size())
+    return;
+
+  if (empty()) {
+    std::allocator_traits<Alloc>::deallocate(_alloc, _start, capacity());
+    _start = _end = _cap = nullptr;
+    return;
+  }
+
+  if constexpr (_can_reallocate) {
+    _M_reallocate_in_place(size());
+  } else {
+    auto no_fill = [](pointer) {};
+    _M_realloc_insert(size(), size(), 0, no_fill);
+  }
+}
+
+template <typename T, typename Alloc, typename GrowthPolicy>
+void vector<T, Alloc, GrowthPolicy>::clear() {
   while (_start != _end) {
     --_end;
     std::allocator_traits<Alloc>::destroy(_alloc, _end);
   }
 }
 
-template <typename T, typename Alloc>
-typename vector<T, Alloc>::size_type vector<T, Alloc>::capacity() const {
+template <typename T, typename Alloc, typename GrowthPolicy>
+typename vector<T, Alloc, GrowthPolicy>::size_type
+vector<T, Alloc, GrowthPolicy>::capacity() const {
   return _cap - _start;
 }
 
-template <typename T, typename Alloc>
-typename vector<T, Alloc>::size_type vector<T, Alloc>::size() const {
+template <typename T, typename Alloc, typename GrowthPolicy>
+typename vector<T, Alloc, GrowthPolicy>::size_type
+vector<T, Alloc, GrowthPolicy>::size() const {
   return _end - _start;
 }
 
-template <typename T, typename Alloc>
-bool vector<T, Alloc>::empty() const {
+template <typename T, typename Alloc, typename GrowthPolicy>
+bool vector<T, Alloc, GrowthPolicy>::empty() const {
   return _start == _end;
 }
 
 // 操作符重载
-template <typename T, typename Alloc>
-typename vector<T, Alloc>::reference
-vector<T, Alloc>::operator[](size_type index) {
+template <typename T, typename Alloc, typename GrowthPolicy>
+typename vector<T, Alloc, GrowthPolicy>::reference
+vector<T, Alloc, GrowthPolicy>::operator[](size_type index) {
   // 不做越界检查
   return _start[index];
 }
 
-template <typename T, typename Alloc>
-typename vector<T, Alloc>::const_reference
-vector<T, Alloc>::operator[](size_type index) const {
+template <typename T, typename Alloc, typename GrowthPolicy>
+typename vector<T, Alloc, GrowthPolicy>::const_reference
+vector<T, Alloc, GrowthPolicy>::operator[](size_type index) const {
   return _start[index];
 }
 
-template <typename T, typename Alloc>
-typename vector<T, Alloc>::const_reference
-vector<T, Alloc>::at(size_type index) const {
+template <typename T, typename Alloc, typename GrowthPolicy>
+typename vector<T, Alloc, GrowthPolicy>::const_reference
+vector<T, Alloc, GrowthPolicy>::at(size_type index) const {
   if (index >= size())
     throw std::out_of_range("vector");
   return _start[index];
 }
 
-// 拷贝赋值
-template <typename T, typename Alloc>
-vector<T, Alloc>& vector<T, Alloc>::operator=(const vector<T, Alloc>& other) {
+// 拷贝赋值：分配器声明 propagate_on_container_copy_assignment 时连同分配器一起复制
+template <typename T, typename Alloc, typename GrowthPolicy>
+vector<T, Alloc, GrowthPolicy>& vector<T, Alloc, GrowthPolicy>::operator=(const vector& other) {
   if (this != &other) {
     clear();
+    if constexpr (_alloc_traits::propagate_on_container_copy_assignment::value) {
+      if (_alloc != other._alloc) {  // 旧缓冲区只能由旧分配器释放
+        _M_deallocate();
+      }
+      _alloc = other._alloc;
+    }
     reserve(other.size());
     for (pointer p = other._start; p != other._end; ++p) {
       std::allocator_traits<Alloc>::construct(_alloc, _end, *p);
@@ -581,26 +743,49 @@ vector<T, Alloc>& vector<T, Alloc>::operator=(const vector<T, Alloc>& other) {
   return *this;
 }
 
-// 移动赋值
-template <typename T, typename Alloc>
-vector<T, Alloc>& vector<T, Alloc>::operator=(vector&& other) noexcept {
-  if (this != &other) {
+// 移动赋值：分配器会传播或两边相等时直接接管缓冲区；
+// 否则 other 的内存不归我们的分配器管，只能逐个移动元素
+template <typename T, typename Alloc, typename GrowthPolicy>
+vector<T, Alloc, GrowthPolicy>& vector<T, Alloc, GrowthPolicy>::operator=(vector&& other) noexcept(
+    _alloc_traits::propagate_on_container_move_assignment::value || _alloc_traits::is_always_equal::value) {
+  if (this == &other)
+    return *this;
+
+  if (_M_can_steal(other)) {
     clear();
-    if (_start)
-      std::allocator_traits<Alloc>::deallocate(_alloc, _start, capacity());
+    _M_deallocate();
+    if constexpr (_alloc_traits::propagate_on_container_move_assignment::value)
+      _alloc = std::move(other._alloc);
 
     _start = other._start;
     _end = other._end;
     _cap = other._cap;
-    _alloc = std::move(other._alloc);
-
     other._start = other._end = other._cap = nullptr;
+  } else {
+    clear();
+    reserve(other.size());
+    for (pointer p = other._start; p != other._end; ++p) {
+      std::allocator_traits<Alloc>::construct(_alloc, _end, std::move(*p));
+      ++_end;
+    }
+    other.clear();
   }
   return *this;
 }
 
-template <typename T, typename Alloc>
-bool vector<T, Alloc>::operator==(const vector& other) const {
+// 交换：只有 propagate_on_container_swap 时才交换分配器，否则两边的分配器必须相等
+template <typename T, typename Alloc, typename GrowthPolicy>
+void vector<T, Alloc, GrowthPolicy>::swap(vector& other) noexcept {
+  using std::swap;
+  if constexpr (_alloc_traits::propagate_on_container_swap::value)
+    swap(_alloc, other._alloc);
+  swap(_start, other._start);
+  swap(_end, other._end);
+  swap(_cap, other._cap);
+}
+
+template <typename T, typename Alloc, typename GrowthPolicy>
+bool vector<T, Alloc, GrowthPolicy>::operator==(const vector& other) const {
   if (size() != other.size())
     return false;
   for (size_type i = 0; i < size(); ++i)
@@ -609,15 +794,16 @@ bool vector<T, Alloc>::operator==(const vector& other) const {
   return true;
 }
 
-template <typename T, typename Alloc>
-bool vector<T, Alloc>::operator!=(const vector& other) const {
+template <typename T, typename Alloc, typename GrowthPolicy>
+bool vector<T, Alloc, GrowthPolicy>::operator!=(const vector& other) const {
   return !(*this == other);
 }
 
-// 拷贝构造
-template <typename T, typename Alloc>
-vector<T, Alloc>::vector(const vector& other)
-    : _start(nullptr), _end(nullptr), _cap(nullptr) {
+// 拷贝构造：分配器由 select_on_container_copy_construction 决定
+template <typename T, typename Alloc, typename GrowthPolicy>
+vector<T, Alloc, GrowthPolicy>::vector(const vector& other)
+    : _alloc(_alloc_traits::select_on_container_copy_construction(other._alloc)), _start(nullptr), _end(nullptr),
+      _cap(nullptr) {
   reserve(other.size());
   for (pointer p = other._start; p != other._end; ++p) {
     std::allocator_traits<Alloc>::construct(_alloc, _end, *p);
@@ -626,8 +812,8 @@ vector<T, Alloc>::vector(const vector& other)
 }
 
 // 移动构造
-template <typename T, typename Alloc>
-vector<T, Alloc>::vector(vector&& other) noexcept
+template <typename T, typename Alloc, typename GrowthPolicy>
+vector<T, Alloc, GrowthPolicy>::vector(vector&& other) noexcept
     : _alloc(std::move(other._alloc)), _start(other._start), _end(other._end),
       _cap(other._cap) {
   other._start = other._end = other._cap = nullptr;
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <string>
+#include "../include/arena_lt.h"
+#include "../include/list_lt.h"
+#include "../include/string_lt.h"
+#include "../include/vector.h"
+
+using namespace leistd;
+
+template <typename T>
+using arena_vector = vector<T, arena_allocator<T>>;
+template <typename T>
+using arena_list = list<T, arena_allocator<T>>;
+using arena_string = basic_string<char, char_traits<char>, arena_allocator<char>>;
+
+static bool owns(const inline_arena<4096>& arena, const void* p) {
+    auto a = reinterpret_cast<std::uintptr_t>(&arena);
+    auto q = reinterpret_cast<std::uintptr_t>(p);
+    return q >= a && q < a + sizeof(arena);
+}
+
+TEST(ArenaTest, BumpAllocationAndAlignment) {
+    monotonic_arena arena(1024);
+    void* a = arena.allocate(3, 1);
+    void* b = arena.allocate(8, 8);
+    void* c = arena.allocate(64, 64);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(b) % 8, 0);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(c) % 64, 0);
+    EXPECT_GT(b, a);
+    EXPECT_EQ(arena.block_count(), 1);
+
+    // 超过当前块：链上新块，旧块保留到 release()
+    arena.allocate(4000);
+    EXPECT_EQ(arena.block_count(), 2);
+    arena.release();
+    EXPECT_EQ(arena.block_count(), 0);
+}
+
+TEST(ArenaTest, LastAllocationRollsBackAndGrowsInPlace) {
+    monotonic_arena arena(1024);
+    char* p = static_cast<char*>(arena.allocate(100, 1));
+    size_t left = arena.remaining();
+    EXPECT_EQ(arena.reallocate(p, 100, 300, 1), p);  // 最近一次分配，原地扩展
+    EXPECT_EQ(arena.remaining(), left - 200);
+    arena.deallocate(p, 300);
+    EXPECT_EQ(arena.remaining(), left + 100);
+
+    char* q = static_cast<char*>(arena.allocate(10, 1));
+    q[0] = 'x';
+    arena.allocate(10, 1);
+    char* moved = static_cast<char*>(arena.reallocate(q, 10, 20, 1));  // 不是最后一次，搬走
+    EXPECT_NE(moved, q);
+    EXPECT_EQ(moved[0], 'x');
+}
+
+TEST(ArenaTest, StackBufferUsedFirst) {
+    inline_arena<4096> arena;
+    {
+        arena_vector<int> v(arena);
+        for (int i = 0; i < 500; ++i) v.push_back(i);
+        arena_list<int> l(arena);
+        for (int i = 0; i < 20; ++i) l.push_back(i);
+        arena_string s("a string that does not fit the local buffer", arena);
+        EXPECT_TRUE(owns(arena, &v[0]));
+        EXPECT_TRUE(owns(arena, &l.front()));
+        EXPECT_TRUE(owns(arena, s.c_str()));
+        EXPECT_EQ(arena.block_count(), 0);
+    }
+    arena.release();
+    EXPECT_EQ(arena.remaining(), 4096);
+}
+
+// 超大请求不能因为地址加法回绕而从当前块"分配"成功
+TEST(ArenaTest, HugeRequestThrows) {
+    inline_arena<4096> arena;
+    void* a = arena.allocate(16);
+    EXPECT_THROW(arena.allocate(std::size_t(-1) - 8), std::bad_alloc);
+    EXPECT_THROW(arena.allocate(std::size_t(-1) - 8, 64), std::bad_alloc);
+    void* b = arena.allocate(16);
+    EXPECT_TRUE(owns(arena, b));
+    EXPECT_NE(a, b);
+    EXPECT_EQ(arena.block_count(), 0);
+}
+
+TEST(ArenaTest, VectorGrowsInPlaceInArena) {
+    monotonic_arena arena(1 << 16);
+    arena_vector<int> v(arena);
+    v.push_back(0);
+    int* first = &v[0];
+    for (int i = 1; i < 1000; ++i) v.push_back(i);
+    EXPECT_EQ(&v[0], first);  // 每次扩容都是最近一次分配，原地扩展
+    for (int i = 0; i < 1000; ++i) ASSERT_EQ(v[i], i);
+}
+
+TEST(ArenaTest, AllocatorsDoNotPropagate) {
+    monotonic_arena a1, a2;
+    arena_vector<int> v1({1, 2, 3}, a1);
+    arena_vector<int> v2(a2);
+    v2 = v1;
+    EXPECT_EQ(v2.get_allocator().arena(), &a2);
+    EXPECT_TRUE(v2 == v1);
+
+    v2 = std::move(v1);  // 分配器不同：逐个移动，v2 仍在 a2 上
+    EXPECT_EQ(v2.get_allocator().arena(), &a2);
+    EXPECT_EQ(v2.size(), 3);
+
+    arena_vector<int> copy(v2);  // 拷贝构造沿用源的 arena
+    EXPECT_EQ(copy.get_allocator().arena(), &a2);
+
+    arena_list<std::string> l1({"x", "y"}, a1);
+    arena_list<std::string> l2(a2);
+    l2 = l1;
+    EXPECT_EQ(l2.get_allocator().arena(), &a2);
+    l2 = std::move(l1);
+    EXPECT_EQ(l2.get_allocator().arena(), &a2);
+    EXPECT_EQ(l2.size(), 2);
+    EXPECT_EQ(l2.back(), "y");
+
+    arena_string s1("long enough to live outside the object", a1);
+    arena_string s2(a2);
+    s2 = s1;
+    EXPECT_EQ(s2.get_allocator().arena(), &a2);
+    s2 = std::move(s1);
+    EXPECT_EQ(s2.get_allocator().arena(), &a2);
+    EXPECT_STREQ(s2.c_str(), "long enough to live outside the object");
+
+    arena_string s3("another long string on the same arena", a2);
+    swap(s2, s3);
+    EXPECT_STREQ(s2.c_str(), "another long string on the same arena");
+    EXPECT_EQ(s3.get_allocator().arena(), &a2);
+}
+
+TEST(ArenaTest, SameArenaMoveStealsBuffer) {
+    monotonic_arena arena;
+    arena_vector<int> v1({1, 2, 3}, arena);
+    const int* data = &v1[0];
+    arena_vector<int> v2(arena);
+    v2 = std::move(v1);
+    EXPECT_EQ(&v2[0], data);
+
+    arena_list<int> l1({1, 2}, arena);
+    const int* node = &l1.front();
+    arena_list<int> l2(arena);
+    l2 = std::move(l1);
+    EXPECT_EQ(&l2.front(), node);
+    EXPECT_TRUE(l1.empty());
+}
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include "../include/array_lt.h"
+
+using namespace leistd;
+
+// 与 std::equal / lexicographical_compare 对照：两个数组至多差一个元素，覆盖整块、尾部和不足一块的长度
+template <typename T, std::size_t N>
+static void check_compare(std::mt19937& rng) {
+    for (int round = 0; round < 200; ++round) {
+        array<T, N> a{}, b{};
+        for (std::size_t i = 0; i < N; ++i) a[i] = b[i] = static_cast<T>(static_cast<int>(rng() % 5) - 2);
+        if (N > 0 && rng() % 2) b[rng() % N] = static_cast<T>(static_cast<int>(rng() % 5) - 2);
+        bool eq = std::equal(a.begin(), a.end(), b.begin());
+        EXPECT_EQ(a == b, eq);
+        EXPECT_EQ(a != b, !eq);
+        EXPECT_EQ(a < b, std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end()));
+        EXPECT_EQ(b < a, std::lexicographical_compare(b.begin(), b.end(), a.begin(), a.end()));
+        EXPECT_EQ(a <= b, !(b < a));
+    }
+}
+
+TEST(ArrayTest, IntegerCompareMatchesStd) {
+    std::mt19937 rng(1);
+    check_compare<char, 0>(rng);
+    check_compare<signed char, 1>(rng);
+    check_compare<short, 7>(rng);
+    check_compare<int, 3>(rng);
+    check_compare<int, 17>(rng);
+    check_compare<unsigned char, 33>(rng);
+    check_compare<unsigned, 64>(rng);
+    check_compare<long long, 9>(rng);
+    check_compare<bool, 20>(rng);
+}
+
+TEST(ArrayTest, FloatCompareMatchesStd) {
+    std::mt19937 rng(2);
+    check_compare<float, 1>(rng);
+    check_compare<float, 7>(rng);
+    check_compare<float, 64>(rng);
+    check_compare<double, 5>(rng);
+    check_compare<double, 100>(rng);
+    check_compare<long double, 5>(rng);
+}
+
+// 有符号整数按值比较，不能按字节序比较
+TEST(ArrayTest, SignedLexicographic) {
+    array<int, 4> a{}, b{};
+    a[2] = -1;
+    b[2] = 1;
+    EXPECT_TRUE(a < b);
+    EXPECT_FALSE(b < a);
+    a[2] = 256;
+    b[2] = 1;
+    EXPECT_TRUE(b < a);
+}
+
+// 浮点按值比较：+0.0 与 -0.0 相等，NaN 与任何数都不相等，字典序中也不分先后
+TEST(ArrayTest, SignedZeroAndNaN) {
+    array<double, 3> x{}, y{};
+    x[1] = 0.0;
+    y[1] = -0.0;
+    EXPECT_TRUE(x == y);
+    EXPECT_FALSE(x < y);
+    x[2] = y[2] = std::numeric_limits<double>::quiet_NaN();
+    EXPECT_FALSE(x == y);
+    EXPECT_FALSE(x < y);
+    EXPECT_FALSE(y < x);
+
+    array<float, 8> f{}, g{};
+    f[6] = std::nanf("");
+    g[6] = 1.0f;
+    g[7] = 1.0f;
+    EXPECT_TRUE(f < g);
+}
+
+TEST(ArrayTest, FillAndSwap) {
+    array<std::uint8_t, 37> bytes{};
+    bytes.fill(0xab);
+    for (auto x : bytes) EXPECT_EQ(x, 0xab);
+
+    array<double, 9> d{};
+    d[4] = 2.5;
+    d.fill(d[4]);  // 参数就是本数组的元素
+    for (double x : d) EXPECT_EQ(x, 2.5);
+
+    array<int, 13> a{}, b{};
+    for (std::size_t i = 0; i < 13; ++i) a[i] = static_cast<int>(i), b[i] = static_cast<int>(100 + i);
+    swap(a, b);
+    for (std::size_t i = 0; i < 13; ++i) {
+        EXPECT_EQ(a[i], static_cast<int>(100 + i));
+        EXPECT_EQ(b[i], static_cast<int>(i));
+    }
+}
+
+template <typename T, std::size_t N>
+static void check_math() {
+    array<T, N> a{}, b{};
+    for (std::size_t i = 0; i < N; ++i) a[i] = static_cast<T>(i % 7), b[i] = static_cast<T>(i % 5 + 1);
+    array<T, N> sum = add(a, b);
+    array<T, N> scaled = scale(a, static_cast<T>(3));
+    T expected = T();
+    for (std::size_t i = 0; i < N; ++i) {
+        EXPECT_EQ(sum[i], a[i] + b[i]);
+        EXPECT_EQ(scaled[i], a[i] * static_cast<T>(3));
+        expected += a[i] * b[i];
+    }
+    EXPECT_EQ(dot(a, b), expected);  // 小整数值的乘积和在浮点下也是精确的
+}
+
+TEST(ArrayTest, ElementwiseMath) {
+    check_math<int, 0>();
+    check_math<int, 5>();
+    check_math<int, 1000>();
+    check_math<float, 3>();
+    check_math<float, 16>();
+    check_math<float, 37>();
+    check_math<double, 100>();
+    check_math<long double, 9>();
+}
+
+// 编译期求值走逐个元素的路径
+constexpr int constexpr_ops() {
+    array<int, 5> a{}, b{};
+    a.fill(4);
+    b.swap(a);
+    if (a == b || !(a < b)) return -1;
+    return dot(b, scale(b, 2)) + add(b, b)[0];
+}
+static_assert(constexpr_ops() == 4 * 4 * 2 * 5 + 8);
+
+constexpr bool constexpr_float_compare() {
+    array<double, 3> a{}, b{};
+    b[2] = 1.0;
+    return a < b && !(b < a) && !(a == b);
+}
+static_assert(constexpr_float_compare());
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
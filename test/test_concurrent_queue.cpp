@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../include/concurrent_queue_lt.h"
+
+using namespace leistd;
+
+// 元素编码为 producer * kPerProducer + seq，消费端据此检查每个生产者内部的先后顺序
+constexpr int kPerProducer = 20000;
+
+// 启动 producers 个生产者、consumers 个消费者，检查每个元素恰好出队一次，且同一生产者的元素按入队顺序出队
+template <typename Push, typename Pop>
+static void run_stress(int producers, int consumers, Push push, Pop pop) {
+    const int total = producers * kPerProducer;
+    std::atomic<int> popped{0};
+    std::vector<std::vector<int>> seen(consumers);
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p)
+        threads.emplace_back([&, p] {
+            for (int i = 0; i < kPerProducer; ++i) push(p * kPerProducer + i);
+        });
+    for (int c = 0; c < consumers; ++c)
+        threads.emplace_back([&, c] {
+            int v;
+            while (popped.load(std::memory_order_relaxed) < total) {
+                if (pop(v)) {
+                    seen[c].push_back(v);
+                    popped.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    for (auto& t : threads) t.join();
+
+    std::vector<char> hit(total, 0);
+    for (auto& s : seen) {
+        std::vector<int> last(producers, -1);
+        for (int v : s) {
+            ASSERT_EQ(hit[v], 0) << "duplicate " << v;
+            hit[v] = 1;
+            ASSERT_GT(v, last[v / kPerProducer]) << "out of order";
+            last[v / kPerProducer] = v;
+        }
+    }
+    EXPECT_EQ(popped.load(), total);
+}
+
+struct Job {
+    int id;
+    mpsc_hook hook;
+};
+
+TEST(IntrusiveMpscQueueTest, SingleThreadFifo) {
+    Job jobs[4] = {{1, {}}, {2, {}}, {3, {}}, {4, {}}};
+    intrusive_mpsc_queue<Job, &Job::hook> q;
+    EXPECT_TRUE(q.empty());
+    EXPECT_EQ(q.try_pop(), nullptr);
+    q.push(jobs[0]);
+    q.push(jobs[1]);
+    EXPECT_FALSE(q.empty());
+    EXPECT_EQ(q.try_pop(), &jobs[0]);
+    q.push(jobs[2]);
+    EXPECT_EQ(q.try_pop(), &jobs[1]);
+    EXPECT_EQ(q.try_pop(), &jobs[2]);  // 取最后一个元素要借助哑节点
+    EXPECT_EQ(q.try_pop(), nullptr);
+    EXPECT_TRUE(q.empty());
+
+    q.push(jobs[0]);  // 出队后的元素可以再次入队
+    q.push(jobs[3]);
+    EXPECT_EQ(q.try_pop()->id, 1);
+    EXPECT_EQ(q.try_pop()->id, 4);
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(MpscQueueTest, ValuesAndCleanup) {
+    mpsc_queue<std::string> q;
+    q.push("alpha");
+    q.emplace(3, 'x');
+    std::string s;
+    EXPECT_TRUE(q.try_pop(s));
+    EXPECT_EQ(s, "alpha");
+    EXPECT_TRUE(q.try_pop(s));
+    EXPECT_EQ(s, "xxx");
+    EXPECT_FALSE(q.try_pop(s));
+    q.push(std::string(100, 'y'));  // 析构时仍在队列里的元素也要释放
+}
+
+TEST(MpscQueueTest, ManyProducers) {
+    mpsc_queue<int> q;
+    run_stress(
+        4, 1, [&](int v) { q.push(v); }, [&](int& v) { return q.try_pop(v); });
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(MpmcRingQueueTest, BoundedFifo) {
+    mpmc_ring_queue<std::unique_ptr<int>> q(5);
+    EXPECT_EQ(q.capacity(), 8u);
+    for (int i = 0; i < 8; ++i) EXPECT_TRUE(q.try_push(std::make_unique<int>(i)));
+    EXPECT_FALSE(q.try_push(std::make_unique<int>(8)));  // 满
+    EXPECT_EQ(q.size_approx(), 8u);
+
+    std::unique_ptr<int> p;
+    for (int round = 0; round < 3; ++round) {  // 绕环几圈
+        for (int i = 0; i < 8; ++i) {
+            ASSERT_TRUE(q.try_pop(p));
+            EXPECT_EQ(*p, round * 8 + i);
+            EXPECT_TRUE(q.try_push(std::make_unique<int>((round + 1) * 8 + i)));
+        }
+    }
+    EXPECT_TRUE(q.try_pop(p));
+    // 析构时释放剩下的 7 个
+}
+
+TEST(MpmcRingQueueTest, ThrowingCopyIsBuiltOutsideTheSlot) {
+    mpmc_ring_queue<std::string> q(4);
+    const std::string s(50, 'z');
+    EXPECT_TRUE(q.try_push(s));
+    std::string out;
+    EXPECT_TRUE(q.try_pop(out));
+    EXPECT_EQ(out, s);
+    EXPECT_FALSE(q.try_pop(out));
+}
+
+TEST(MpmcRingQueueTest, ManyProducersManyConsumers) {
+    mpmc_ring_queue<int> q(64);  // 小容量，频繁遇到满/空
+    run_stress(
+        3, 3,
+        [&](int v) {
+            while (!q.try_push(v)) std::this_thread::yield();
+        },
+        [&](int& v) { return q.try_pop(v); });
+    EXPECT_EQ(q.size_approx(), 0u);
+}
+
+TEST(SegmentedMpmcQueueTest, GrowsAcrossSegments) {
+    segmented_mpmc_queue<std::string, 4> q;
+    EXPECT_TRUE(q.empty());
+    for (int i = 0; i < 30; ++i) q.push(std::to_string(i));
+    EXPECT_FALSE(q.empty());
+    std::string s;
+    for (int i = 0; i < 30; ++i) {
+        ASSERT_TRUE(q.try_pop(s));
+        EXPECT_EQ(s, std::to_string(i));
+    }
+    EXPECT_FALSE(q.try_pop(s));
+    EXPECT_TRUE(q.empty());
+
+    // 回收的段被复用，交替出入队也保持先进先出
+    for (int i = 0; i < 100; ++i) {
+        q.push(std::to_string(i));
+        q.push(std::to_string(i + 1000));
+        ASSERT_TRUE(q.try_pop(s));
+    }
+    EXPECT_EQ(s, std::to_string(1049));
+    for (int i = 0; i < 5; ++i) q.push(std::string(40, 'q'));  // 析构时仍有元素
+}
+
+TEST(SegmentedMpmcQueueTest, ManyProducersManyConsumers) {
+    segmented_mpmc_queue<int, 16> q;  // 小段，频繁换段、回收
+    run_stress(
+        3, 3, [&](int v) { q.push(v); }, [&](int& v) { return q.try_pop(v); });
+    int v;
+    EXPECT_FALSE(q.try_pop(v));
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
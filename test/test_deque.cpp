@@ -0,0 +1,242 @@
+#include <gtest/gtest.h>
+#include <deque>
+#include <list>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../include/deque_lt.h"
+
+using namespace leistd;
+
+// 小块，便于触发跨块和映射表扩容
+template <typename T>
+using small_block_deque = deque<T, std::allocator<T>, 4>;
+
+template <typename D>
+static std::vector<typename D::value_type> to_vec(const D& d) {
+    return std::vector<typename D::value_type>(d.begin(), d.end());
+}
+
+TEST(DequeTest, PushPopBothEnds) {
+    small_block_deque<int> d;
+    EXPECT_TRUE(d.empty());
+    EXPECT_EQ(d.begin(), d.end());
+    for (int i = 0; i < 50; ++i) d.push_back(i);
+    for (int i = 1; i <= 50; ++i) d.push_front(-i);
+    EXPECT_EQ(d.size(), 100u);
+    EXPECT_EQ(d.front(), -50);
+    EXPECT_EQ(d.back(), 49);
+    for (int i = 0; i < 100; ++i) EXPECT_EQ(d[i], i - 50);
+    EXPECT_EQ(d.at(99), 49);
+    EXPECT_THROW(d.at(100), std::out_of_range);
+
+    std::vector<int> backward(d.rbegin(), d.rend());
+    EXPECT_EQ(backward.front(), 49);
+    EXPECT_EQ(backward.back(), -50);
+
+    for (int i = 0; i < 40; ++i) {
+        d.pop_front();
+        d.pop_back();
+    }
+    EXPECT_EQ(d.size(), 20u);
+    EXPECT_EQ(d.front(), -10);
+    EXPECT_EQ(d.back(), 9);
+    while (!d.empty()) d.pop_front();
+    d.push_back(7);  // 删空后仍可使用
+    EXPECT_EQ(d.front(), 7);
+    EXPECT_EQ(d.back(), 7);
+}
+
+TEST(DequeTest, RandomAccessIterator) {
+    small_block_deque<int> d;
+    for (int i = 0; i < 30; ++i) d.push_back(i);
+    for (int i = 1; i <= 5; ++i) d.push_front(-i);
+    auto it = d.begin();
+    EXPECT_EQ(*(it + 17), 12);
+    EXPECT_EQ(it[34], 29);
+    auto e = d.end();
+    EXPECT_EQ(e - it, 35);
+    EXPECT_EQ(*(e - 35), -5);
+    it += 20;
+    it -= 13;
+    EXPECT_EQ(*it, 2);
+    EXPECT_TRUE(d.begin() < it);
+    EXPECT_TRUE(it <= e);
+    small_block_deque<int>::const_iterator cit = it;
+    EXPECT_EQ(cit, it);
+    EXPECT_EQ(*--cit, 1);
+    EXPECT_EQ(std::distance(d.cbegin(), d.cend()), 35);
+}
+
+TEST(DequeTest, IteratorsStableOnPushAtEitherEnd) {
+    small_block_deque<int> d;
+    for (int i = 0; i < 10; ++i) d.push_back(i);
+    auto first = d.begin();
+    auto mid = d.begin() + 5;
+    auto last = d.end() - 1;
+    int* addr = &*mid;
+    // 远超初始映射表容量，两端交替增长，映射表会多次居中和扩容
+    for (int i = 0; i < 2000; ++i) {
+        d.push_back(100 + i);
+        d.push_front(-100 - i);
+    }
+    EXPECT_EQ(*first, 0);
+    EXPECT_EQ(*mid, 5);
+    EXPECT_EQ(*last, 9);
+    EXPECT_EQ(&*mid, addr);
+    EXPECT_EQ(mid - first, 5);
+    EXPECT_EQ(first - d.begin(), 2000);
+    ++last;  // 旧迭代器仍能正常移动和跨块
+    EXPECT_EQ(*last, 100);
+    EXPECT_EQ(*(first - 1), -100);
+    EXPECT_EQ(*(mid + 1000), 100 + 995);
+}
+
+TEST(DequeTest, MatchesStdDeque) {
+    std::mt19937 rng(3);
+    small_block_deque<int> d;
+    std::deque<int> ref;
+    for (int step = 0; step < 6000; ++step) {
+        size_t n = ref.size();
+        size_t pos = n ? rng() % (n + 1) : 0;
+        switch (rng() % 8) {
+            case 0: d.push_back(step), ref.push_back(step); break;
+            case 1: d.push_front(step), ref.push_front(step); break;
+            case 2:
+                if (n) d.pop_back(), ref.pop_back();
+                break;
+            case 3:
+                if (n) d.pop_front(), ref.pop_front();
+                break;
+            case 4: {
+                auto it = d.insert(d.begin() + pos, step);
+                EXPECT_EQ(*it, step);
+                ref.insert(ref.begin() + pos, step);
+                break;
+            }
+            case 5: {
+                size_t cnt = rng() % 11;
+                auto it = d.insert(d.begin() + pos, cnt, step);
+                EXPECT_EQ(it - d.begin(), static_cast<long>(pos));
+                ref.insert(ref.begin() + pos, cnt, step);
+                break;
+            }
+            case 6:
+                if (pos < n) {
+                    auto it = d.erase(d.begin() + pos);
+                    ref.erase(ref.begin() + pos);
+                    EXPECT_EQ(it - d.begin(), static_cast<long>(pos));
+                }
+                break;
+            case 7: {
+                size_t len = rng() % (n - pos + 1);
+                d.erase(d.begin() + pos, d.begin() + pos + len);
+                ref.erase(ref.begin() + pos, ref.begin() + pos + len);
+                break;
+            }
+        }
+        ASSERT_EQ(d.size(), ref.size());
+    }
+    EXPECT_EQ(to_vec(d), std::vector<int>(ref.begin(), ref.end()));
+}
+
+TEST(DequeTest, BulkInsert) {
+    small_block_deque<std::string> d = {"a", "b", "c", "d", "e"};
+    std::vector<std::string> src;
+    for (int i = 0; i < 13; ++i) src.push_back(std::string(20, char('A' + i)));
+
+    auto it = d.insert(d.begin() + 1, src.begin(), src.end());  // 靠近前端
+    EXPECT_EQ(*it, src[0]);
+    EXPECT_EQ(d.size(), 18u);
+    EXPECT_EQ(d[0], "a");
+    EXPECT_EQ(d[13], src.back());
+    EXPECT_EQ(d[14], "b");
+
+    it = d.insert(d.end() - 1, {"x", "y"});  // 靠近后端
+    EXPECT_EQ(*it, "x");
+    EXPECT_EQ(d.back(), "e");
+    EXPECT_EQ(*(d.end() - 2), "y");
+
+    std::istringstream in("1 2 3");  // 单遍迭代器
+    small_block_deque<int> n = {0, 4};
+    n.insert(n.begin() + 1, std::istream_iterator<int>(in), std::istream_iterator<int>());
+    EXPECT_EQ(to_vec(n), (std::vector<int>{0, 1, 2, 3, 4}));
+
+    std::list<int> l = {9, 8, 7};
+    small_block_deque<int> from_list(l.begin(), l.end());
+    EXPECT_EQ(to_vec(from_list), (std::vector<int>{9, 8, 7}));
+}
+
+TEST(DequeTest, ResizeClearShrink) {
+    small_block_deque<int> d(10);
+    EXPECT_EQ(to_vec(d), std::vector<int>(10, 0));
+    d.resize(3);
+    d.resize(6, 5);
+    EXPECT_EQ(to_vec(d), (std::vector<int>{0, 0, 0, 5, 5, 5}));
+    d.clear();
+    EXPECT_TRUE(d.empty());
+    d.shrink_to_fit();
+    d.push_front(1);
+    d.push_back(2);
+    EXPECT_EQ(to_vec(d), (std::vector<int>{1, 2}));
+}
+
+TEST(DequeTest, CopyMoveSwap) {
+    small_block_deque<std::string> a;
+    for (int i = 0; i < 9; ++i) a.push_back(std::string(20, char('a' + i)));
+    small_block_deque<std::string> b = a;
+    EXPECT_TRUE(a == b);
+
+    auto it = a.begin() + 3;
+    small_block_deque<std::string> c = std::move(a);
+    EXPECT_TRUE(a.empty());
+    EXPECT_EQ(it - c.begin(), 3);  // 迭代器随元素转移
+    a.push_back("x");
+
+    swap(a, c);
+    EXPECT_EQ(a.size(), 9u);
+    EXPECT_EQ(c.front(), "x");
+    EXPECT_EQ(*it, std::string(20, 'd'));
+
+    c = b;
+    EXPECT_TRUE(c == b);
+    c = std::move(b);
+    EXPECT_EQ(c.size(), 9u);
+    c = {"p", "q"};
+    EXPECT_EQ(c.back(), "q");
+}
+
+// 第 n 次拷贝构造时抛异常
+struct Fragile {
+    static int budget;
+    int v;
+    Fragile(int x) : v(x) {}
+    Fragile(const Fragile& o) : v(o.v) {
+        if (budget-- == 0) throw std::runtime_error("copy");
+    }
+    Fragile& operator=(const Fragile&) = default;
+};
+int Fragile::budget = -1;
+
+TEST(DequeTest, BulkInsertIsAllOrNothing) {
+    small_block_deque<Fragile> d;
+    for (int i = 0; i < 6; ++i) d.emplace_back(i);
+    std::vector<Fragile> src;
+    for (int i = 0; i < 20; ++i) src.emplace_back(100 + i);
+
+    for (int at : {1, 5}) {  // 分别走前端、后端
+        Fragile::budget = 11;
+        EXPECT_THROW(d.insert(d.begin() + at, src.begin(), src.end()), std::runtime_error);
+        Fragile::budget = -1;
+        ASSERT_EQ(d.size(), 6u);
+        for (int i = 0; i < 6; ++i) EXPECT_EQ(d[i].v, i);
+    }
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
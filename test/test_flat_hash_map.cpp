@@ -0,0 +1,266 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../include/flat_hash_map_lt.h"
+
+using namespace leistd;
+
+// 所有键哈希到同一个值：簇一直延伸到溢出区，用来检验溢出区扩容和 backward shift
+struct ConstantHash {
+    size_t operator()(int) const noexcept { return 42; }
+};
+
+// 只用低几位区分：大量键共用起始槽，但不至于完全退化
+struct CoarseHash {
+    size_t operator()(int x) const noexcept { return static_cast<size_t>(x & 7); }
+};
+
+template <typename M>
+static std::vector<std::pair<int, int>> sorted_items(const M& m) {
+    std::vector<std::pair<int, int>> v(m.begin(), m.end());
+    std::sort(v.begin(), v.end());
+    return v;
+}
+
+TEST(FlatHashMapTest, InsertFindErase) {
+    flat_hash_map<int, std::string> m;
+    EXPECT_TRUE(m.empty());
+    EXPECT_EQ(m.begin(), m.end());
+    EXPECT_EQ(m.find(1), m.end());  // 空表不分配内存也能查找
+    EXPECT_EQ(m.bucket_count(), 0u);
+
+    for (int i = 0; i < 1000; ++i) {
+        auto [it, inserted] = m.insert({i, std::to_string(i)});
+        EXPECT_TRUE(inserted);
+        EXPECT_EQ(it->first, i);
+    }
+    EXPECT_EQ(m.size(), 1000u);
+    EXPECT_LE(m.load_factor(), m.max_load_factor());
+    EXPECT_FALSE(m.insert({5, "dup"}).second);
+    EXPECT_EQ(m[5], "5");
+    for (int i = 0; i < 1000; ++i) ASSERT_EQ(m.at(i), std::to_string(i));
+    EXPECT_FALSE(m.contains(1000));
+    EXPECT_THROW(m.at(-1), std::out_of_range);
+
+    for (int i = 0; i < 1000; i += 2) EXPECT_EQ(m.erase(i), 1u);
+    EXPECT_EQ(m.erase(0), 0u);
+    EXPECT_EQ(m.size(), 500u);
+    for (int i = 0; i < 1000; ++i) ASSERT_EQ(m.count(i), static_cast<size_t>(i % 2)) << i;
+
+    m[7] = "seven";
+    m[2000] = "new";
+    EXPECT_EQ(m.size(), 501u);
+    EXPECT_EQ(m.find(7)->second, "seven");
+}
+
+TEST(FlatHashMapTest, TryEmplaceAndInsertOrAssign) {
+    flat_hash_map<int, std::unique_ptr<int>> m;
+    auto p = std::make_unique<int>(1);
+    EXPECT_TRUE(m.try_emplace(1, std::move(p)).second);
+    EXPECT_EQ(p, nullptr);
+    auto q = std::make_unique<int>(2);
+    EXPECT_FALSE(m.try_emplace(1, std::move(q)).second);
+    EXPECT_NE(q, nullptr);  // 键已存在时不移动参数
+    EXPECT_FALSE(m.insert_or_assign(1, std::move(q)).second);
+    EXPECT_EQ(*m[1], 2);
+    EXPECT_TRUE(m.emplace(3, std::make_unique<int>(3)).second);
+    EXPECT_EQ(*m.at(3), 3);
+}
+
+TEST(FlatHashMapTest, MatchesStdUnorderedMap) {
+    std::mt19937 rng(5);
+    flat_hash_map<int, int> m;
+    std::unordered_map<int, int> ref;
+    for (int step = 0; step < 200000; ++step) {
+        int k = static_cast<int>(rng() % 5000);
+        switch (rng() % 4) {
+            case 0:
+            case 1: {
+                bool a = m.try_emplace(k, step).second;
+                bool b = ref.try_emplace(k, step).second;
+                ASSERT_EQ(a, b);
+                break;
+            }
+            case 2: ASSERT_EQ(m.erase(k), ref.erase(k)); break;
+            case 3: {
+                auto it = m.find(k);
+                auto rit = ref.find(k);
+                ASSERT_EQ(it == m.end(), rit == ref.end());
+                if (rit != ref.end()) {
+                    ASSERT_EQ(it->second, rit->second);
+                }
+                break;
+            }
+        }
+        ASSERT_EQ(m.size(), ref.size());
+    }
+    EXPECT_EQ(sorted_items(m), sorted_items(ref));
+}
+
+TEST(FlatHashMapTest, DegenerateHashUsesOverflowRegion) {
+    flat_hash_map<int, int, ConstantHash> m;
+    for (int i = 0; i < 300; ++i) m[i] = i;
+    EXPECT_LE(m.bucket_count(), 512u);  // 簇超出溢出区时加倍溢出区，不会把容量撑爆
+    for (int i = 0; i < 300; ++i) ASSERT_EQ(m.at(i), i);
+    for (int i = 0; i < 300; i += 3) m.erase(i);
+    for (int i = 0; i < 300; ++i) ASSERT_EQ(m.contains(i), i % 3 != 0) << i;
+}
+
+TEST(FlatHashMapTest, EraseWhileIteratingVisitsEachElementOnce) {
+    flat_hash_map<int, int, CoarseHash> m;
+    for (int i = 0; i < 500; ++i) m[i] = i;
+    std::vector<int> seen;
+    for (auto it = m.begin(); it != m.end();) {
+        seen.push_back(it->first);
+        it = it->first % 3 == 0 ? m.erase(it) : std::next(it);
+    }
+    std::sort(seen.begin(), seen.end());
+    EXPECT_EQ(seen.size(), 500u);
+    EXPECT_TRUE(std::adjacent_find(seen.begin(), seen.end()) == seen.end());
+    for (int i = 0; i < 500; ++i) ASSERT_EQ(m.contains(i), i % 3 != 0) << i;
+
+    EXPECT_EQ(erase_if(m, [](const auto& kv) { return kv.second % 2 == 0; }), 166u);
+    for (int i = 0; i < 500; ++i) ASSERT_EQ(m.contains(i), i % 3 != 0 && i % 2 != 0) << i;
+}
+
+TEST(FlatHashMapTest, RangeErase) {
+    flat_hash_map<int, int, CoarseHash> m;
+    for (int i = 0; i < 200; ++i) m[i] = i;
+    auto first = std::next(m.begin(), 50);
+    auto last = std::next(first, 80);
+    std::vector<int> gone;
+    for (auto it = first; it != last; ++it) gone.push_back(it->first);
+    m.erase(first, last);
+    EXPECT_EQ(m.size(), 120u);
+    for (int k : gone) EXPECT_FALSE(m.contains(k));
+    int found = 0;
+    for (int i = 0; i < 200; ++i) found += m.contains(i);
+    EXPECT_EQ(found, 120);
+    m.erase(m.begin(), m.end());
+    EXPECT_TRUE(m.empty());
+    EXPECT_EQ(m.begin(), m.end());
+}
+
+TEST(FlatHashMapTest, HeterogeneousStringLookup) {
+    flat_hash_map<leistd::string, int> m;
+    m[leistd::string("alpha")] = 1;
+    m[leistd::string("a much longer key that is not stored inline")] = 2;
+    // string_view 和字面量直接查找，不构造临时 string
+    EXPECT_EQ(m.find(leistd::string_view("alpha"))->second, 1);
+    EXPECT_TRUE(m.contains("a much longer key that is not stored inline"));
+    EXPECT_FALSE(m.contains(leistd::string_view("alph")));
+    EXPECT_EQ(m.at("alpha"), 1);
+    EXPECT_EQ(m.erase(leistd::string_view("alpha")), 1u);
+    EXPECT_EQ(m.size(), 1u);
+
+    flat_hash_set<leistd::string> s = {leistd::string("x"), leistd::string("yy")};
+    EXPECT_EQ(s.count("yy"), 1u);
+    EXPECT_EQ(s.count("z"), 0u);
+}
+
+TEST(FlatHashMapTest, ReserveAndRehash) {
+    flat_hash_map<int, int> m;
+    m.reserve(1000);
+    size_t buckets = m.bucket_count();
+    EXPECT_GE(buckets * 7 / 8, 1000u);
+    for (int i = 0; i < 1000; ++i) m[i] = i;
+    EXPECT_EQ(m.bucket_count(), buckets);  // 预留范围内不 rehash
+
+    m.rehash(8192);
+    EXPECT_EQ(m.bucket_count(), 8192u);
+    for (int i = 0; i < 1000; ++i) ASSERT_EQ(m.at(i), i);
+    for (int i = 0; i < 990; ++i) m.erase(i);
+    m.rehash(0);  // 收缩到刚好容纳剩下的元素
+    EXPECT_EQ(m.bucket_count(), 16u);
+    for (int i = 990; i < 1000; ++i) ASSERT_EQ(m.at(i), i);
+    m.clear();
+    m.rehash(0);
+    EXPECT_EQ(m.bucket_count(), 0u);
+}
+
+TEST(FlatHashMapTest, CopyMoveSwapEquality) {
+    flat_hash_map<std::string, std::string> a;
+    for (int i = 0; i < 100; ++i) a[std::to_string(i)] = std::string(30, char('a' + i % 26));
+    flat_hash_map<std::string, std::string> b = a;
+    EXPECT_TRUE(a == b);
+    b["0"] = "changed";
+    EXPECT_FALSE(a == b);
+
+    flat_hash_map<std::string, std::string> c = std::move(a);
+    EXPECT_TRUE(a.empty());
+    EXPECT_EQ(c.size(), 100u);
+    a["x"] = "y";  // 被移走后仍可使用
+    swap(a, c);
+    EXPECT_EQ(a.size(), 100u);
+    EXPECT_EQ(c.at("x"), "y");
+
+    c = b;
+    EXPECT_TRUE(c == b);
+    c = std::move(b);
+    EXPECT_EQ(c.size(), 100u);
+    c = {{"p", "q"}};
+    EXPECT_EQ(c.size(), 1u);
+    EXPECT_EQ(c.at("p"), "q");
+}
+
+TEST(FlatHashSetTest, Basics) {
+    flat_hash_set<int> s = {3, 1, 4, 1, 5, 9, 2, 6};
+    EXPECT_EQ(s.size(), 7u);
+    EXPECT_TRUE(s.contains(9));
+    EXPECT_FALSE(s.insert(4).second);
+    EXPECT_TRUE(s.emplace(7).second);
+    std::vector<int> v(s.begin(), s.end());
+    std::sort(v.begin(), v.end());
+    EXPECT_EQ(v, (std::vector<int>{1, 2, 3, 4, 5, 6, 7, 9}));
+    EXPECT_EQ(erase_if(s, [](int x) { return x > 4; }), 4u);
+    EXPECT_EQ(s.size(), 4u);
+
+    flat_hash_set<int> big;
+    for (int i = 0; i < 100000; ++i) big.insert(i * 7919);
+    for (int i = 0; i < 100000; ++i) ASSERT_TRUE(big.contains(i * 7919));
+    EXPECT_FALSE(big.contains(1));
+}
+
+// 第 n 次拷贝构造时抛异常
+struct Fragile {
+    static int budget;
+    int v;
+    Fragile(int x) : v(x) {}
+    Fragile(const Fragile& o) : v(o.v) {
+        if (budget-- == 0) throw std::runtime_error("copy");
+    }
+    Fragile(Fragile&&) noexcept = default;
+    bool operator==(const Fragile& o) const { return v == o.v; }
+};
+int Fragile::budget = -1;
+
+struct FragileHash {
+    size_t operator()(const Fragile& f) const noexcept { return static_cast<size_t>(f.v); }
+};
+
+TEST(FlatHashSetTest, ThrowingConstructionLeavesTableIntact) {
+    flat_hash_set<Fragile, FragileHash, std::equal_to<Fragile>> s;
+    for (int i = 0; i < 20; ++i) s.emplace(i);
+    Fragile extra(100);
+    Fragile::budget = 0;
+    EXPECT_THROW(s.insert(extra), std::runtime_error);
+    Fragile::budget = -1;
+    EXPECT_EQ(s.size(), 20u);
+    EXPECT_FALSE(s.contains(Fragile(100)));
+    for (int i = 0; i < 20; ++i) EXPECT_TRUE(s.contains(Fragile(i)));
+
+    Fragile::budget = 10;
+    using FragileSet = flat_hash_set<Fragile, FragileHash, std::equal_to<Fragile>>;
+    EXPECT_THROW(FragileSet copy(s), std::runtime_error);  // 拷贝到一半失败，已构造的部分要析构
+    Fragile::budget = -1;
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,279 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <map>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../include/flat_map_lt.h"
+
+using namespace leistd;
+
+template <typename M>
+static std::vector<std::pair<int, int>> items(const M& m) {
+    std::vector<std::pair<int, int>> v;
+    for (auto it = m.begin(); it != m.end(); ++it) v.emplace_back(it->first, it->second);
+    return v;
+}
+
+// 和 std::lower_bound / upper_bound 逐个对照，包括重复元素和空区间
+TEST(FlatTreeDetailTest, BranchlessBoundsMatchStd) {
+    std::mt19937 rng(1);
+    for (std::size_t n = 0; n <= 70; ++n) {
+        std::vector<int> v(n);
+        for (auto& x : v) x = static_cast<int>(rng() % 20);
+        std::sort(v.begin(), v.end());
+        for (int key = -1; key <= 21; ++key) {
+            std::size_t lo = std::lower_bound(v.begin(), v.end(), key) - v.begin();
+            std::size_t hi = std::upper_bound(v.begin(), v.end(), key) - v.begin();
+            EXPECT_EQ(flat_tree_detail::lower_bound_index(v.data(), n, key, std::less<>()), lo);
+            EXPECT_EQ(flat_tree_detail::upper_bound_index(v.data(), n, key, std::less<>()), hi);
+        }
+    }
+}
+
+TEST(FlatSetTest, ConstructSortsAndDedupes) {
+    flat_set<int> s{5, 1, 4, 1, 5, 9, 2, 6};
+    std::vector<int> got(s.begin(), s.end());
+    EXPECT_EQ(got, (std::vector<int>{1, 2, 4, 5, 6, 9}));
+
+    vector<int> raw{3, 3, 2, 1};
+    flat_set<int> t(std::move(raw));
+    EXPECT_EQ(std::vector<int>(t.begin(), t.end()), (std::vector<int>{1, 2, 3}));
+
+    flat_set<int, std::greater<int>> g{1, 3, 2};
+    EXPECT_EQ(std::vector<int>(g.begin(), g.end()), (std::vector<int>{3, 2, 1}));
+    EXPECT_EQ(*g.rbegin(), 1);
+}
+
+TEST(FlatSetTest, RandomOpsMatchStdSet) {
+    std::mt19937 rng(2);
+    flat_set<int> s;
+    std::set<int> ref;
+    for (int step = 0; step < 20000; ++step) {
+        int k = static_cast<int>(rng() % 1000);
+        switch (rng() % 4) {
+            case 0:
+                EXPECT_EQ(s.insert(k).second, ref.insert(k).second);
+                break;
+            case 1:
+                EXPECT_EQ(s.erase(k), ref.erase(k));
+                break;
+            case 2: {
+                // 批量插入：乱序、带重复、与已有元素部分重叠
+                std::vector<int> batch(rng() % 50);
+                for (auto& x : batch) x = static_cast<int>(rng() % 1000);
+                s.insert(batch.begin(), batch.end());
+                ref.insert(batch.begin(), batch.end());
+                break;
+            }
+            default:
+                EXPECT_EQ(s.contains(k), ref.count(k) == 1);
+                EXPECT_EQ(s.lower_bound(k) - s.begin(), std::distance(ref.begin(), ref.lower_bound(k)));
+                EXPECT_EQ(s.upper_bound(k) - s.begin(), std::distance(ref.begin(), ref.upper_bound(k)));
+        }
+    }
+    EXPECT_TRUE(std::equal(s.begin(), s.end(), ref.begin(), ref.end()));
+}
+
+// 键相等但内容不同：批量插入时已有元素必须保留，批内重复保留先出现的
+struct Tagged {
+    int key;
+    int tag;
+};
+struct ByKey {
+    bool operator()(const Tagged& a, const Tagged& b) const { return a.key < b.key; }
+};
+
+TEST(FlatSetTest, BatchInsertKeepsExisting) {
+    flat_set<Tagged, ByKey> s{{1, 0}, {3, 0}, {5, 0}};
+    std::vector<Tagged> batch{{4, 1}, {3, 1}, {0, 1}, {4, 2}, {6, 1}};
+    s.insert(batch.begin(), batch.end());
+    std::vector<std::pair<int, int>> got;
+    for (const Tagged& t : s) got.emplace_back(t.key, t.tag);
+    EXPECT_EQ(got, (std::vector<std::pair<int, int>>{{0, 1}, {1, 0}, {3, 0}, {4, 1}, {5, 0}, {6, 1}}));
+
+    // 全部大于现有最大值时直接追加
+    std::vector<Tagged> tail{{9, 1}, {8, 1}};
+    s.insert(tail.begin(), tail.end());
+    EXPECT_EQ(s.size(), 8u);
+    EXPECT_EQ(s.rbegin()->key, 9);
+}
+
+TEST(FlatSetTest, TransparentLookupAndErase) {
+    flat_set<std::string, std::less<>> s{"pear", "apple", "fig"};
+    EXPECT_TRUE(s.contains("fig"));
+    EXPECT_TRUE(s.contains(std::string_view("pear")));
+    EXPECT_EQ(s.count("kiwi"), 0u);
+    EXPECT_EQ(s.erase("apple"), 1u);
+    auto it = s.erase(s.begin());  // iterator 走 erase(pos)，不被 erase(key) 模板抢走
+    EXPECT_EQ(*it, "pear");
+    EXPECT_EQ(s.size(), 1u);
+
+    flat_set<int> n{1, 2, 3, 4, 5, 6};
+    EXPECT_EQ(leistd::erase_if(n, [](int x) { return x % 2 == 0; }), 3u);
+    EXPECT_EQ(std::vector<int>(n.begin(), n.end()), (std::vector<int>{1, 3, 5}));
+    n.erase(n.begin(), n.begin() + 2);
+    EXPECT_EQ(std::vector<int>(n.begin(), n.end()), (std::vector<int>{5}));
+
+    vector<int> keys = std::move(n).extract();
+    EXPECT_EQ(keys.size(), 1u);
+    EXPECT_TRUE(n.empty());
+}
+
+TEST(FlatMapTest, ConstructKeepsFirstDuplicate) {
+    flat_map<int, int> m{{3, 30}, {1, 10}, {3, 31}, {2, 20}, {1, 11}};
+    EXPECT_EQ(items(m), (std::vector<std::pair<int, int>>{{1, 10}, {2, 20}, {3, 30}}));
+    // 键和值分两个数组存放
+    EXPECT_EQ(m.keys().size(), 3u);
+    EXPECT_EQ(m.keys()[0], 1);
+    EXPECT_EQ(m.values()[2], 30);
+
+    flat_map<int, int> c(vector<int>{2, 1, 2}, vector<int>{20, 10, 21});
+    EXPECT_EQ(items(c), (std::vector<std::pair<int, int>>{{1, 10}, {2, 20}}));
+
+    flat_map<int, int> sorted(sorted_unique, {{1, 1}, {2, 2}});
+    EXPECT_EQ(sorted.size(), 2u);
+
+    using IntMap = flat_map<int, int>;
+    EXPECT_THROW(IntMap(vector<int>{1, 2}, vector<int>{1}), std::invalid_argument);
+}
+
+TEST(FlatMapTest, RandomOpsMatchStdMap) {
+    std::mt19937 rng(3);
+    flat_map<int, int> m;
+    std::map<int, int> ref;
+    for (int step = 0; step < 20000; ++step) {
+        int k = static_cast<int>(rng() % 800), v = static_cast<int>(rng());
+        switch (rng() % 7) {
+            case 0:
+                EXPECT_EQ(m.insert({k, v}).second, ref.insert({k, v}).second);
+                break;
+            case 1:
+                EXPECT_EQ(m.try_emplace(k, v).second, ref.try_emplace(k, v).second);
+                break;
+            case 2:
+                EXPECT_EQ(m.insert_or_assign(k, v).second, ref.insert_or_assign(k, v).second);
+                break;
+            case 3:
+                m[k] += 1;
+                ref[k] += 1;
+                break;
+            case 4:
+                EXPECT_EQ(m.erase(k), ref.erase(k));
+                break;
+            case 5: {
+                std::vector<std::pair<int, int>> batch(rng() % 40);
+                for (auto& p : batch) p = {static_cast<int>(rng() % 800), static_cast<int>(rng())};
+                m.insert(batch.begin(), batch.end());
+                ref.insert(batch.begin(), batch.end());
+                break;
+            }
+            default: {
+                auto it = m.find(k);
+                auto rt = ref.find(k);
+                ASSERT_EQ(it == m.end(), rt == ref.end());
+                if (rt != ref.end()) {
+                    EXPECT_EQ(it->second, rt->second);
+                }
+                EXPECT_EQ(m.lower_bound(k) - m.begin(), std::distance(ref.begin(), ref.lower_bound(k)));
+                EXPECT_EQ(m.upper_bound(k) - m.begin(), std::distance(ref.begin(), ref.upper_bound(k)));
+            }
+        }
+    }
+    std::vector<std::pair<int, int>> expected(ref.begin(), ref.end());
+    EXPECT_EQ(items(m), expected);
+}
+
+TEST(FlatMapTest, IteratorArithmeticAndWrites) {
+    flat_map<int, std::string> m{{1, "a"}, {2, "b"}, {3, "c"}, {4, "d"}};
+    auto it = m.begin();
+    it->second = "A";
+    (*(it + 2)).second += "!";
+    it[3].second = "D";
+    EXPECT_EQ(m.at(1), "A");
+    EXPECT_EQ(m.at(3), "c!");
+    EXPECT_EQ(m.at(4), "D");
+    EXPECT_EQ(m.end() - m.begin(), 4);
+    EXPECT_TRUE(m.begin() < m.end());
+
+    flat_map<int, std::string>::const_iterator cit = m.begin();
+    EXPECT_TRUE(cit == m.begin());
+    EXPECT_EQ(std::prev(m.cend())->first, 4);
+    EXPECT_EQ(m.rbegin()->second, "D");
+
+    for (auto&& [k, v] : m) v += std::to_string(k);
+    EXPECT_EQ(m.at(2), "b2");
+    EXPECT_THROW(m.at(9), std::out_of_range);
+
+    auto next = m.erase(m.find(2));
+    EXPECT_EQ(next->first, 3);
+    m.erase(m.begin(), m.begin() + 2);
+    EXPECT_EQ(m.size(), 1u);
+    EXPECT_EQ(m.begin()->first, 4);
+}
+
+TEST(FlatMapTest, TransparentStringKeys) {
+    flat_map<std::string, int, std::less<>> m;
+    m["beta"] = 2;
+    m.emplace("alpha", 1);
+    m.try_emplace(std::string("gamma"), 3);
+    EXPECT_EQ(m.at("alpha"), 1);
+    EXPECT_TRUE(m.contains(std::string_view("gamma")));
+    EXPECT_EQ(m.find("delta"), m.end());
+    auto [lo, hi] = m.equal_range("beta");
+    EXPECT_EQ(hi - lo, 1);
+    EXPECT_EQ(m.erase("beta"), 1u);
+    EXPECT_EQ(m.erase(m.begin())->first, "gamma");
+}
+
+TEST(FlatMapTest, ExtractReplaceEraseIfEquality) {
+    flat_map<int, int> m;
+    for (int i = 0; i < 100; ++i) m.emplace(i, i * i);
+    flat_map<int, int> copy = m;
+    EXPECT_TRUE(copy == m);
+    EXPECT_EQ(leistd::erase_if(m, [](const auto& kv) { return kv.first % 3 != 0; }), 66u);
+    EXPECT_EQ(m.size(), 34u);
+    EXPECT_EQ(m.at(99), 99 * 99);
+    EXPECT_FALSE(copy == m);
+
+    auto parts = std::move(m).extract();
+    EXPECT_TRUE(m.empty());
+    EXPECT_EQ(parts.keys.size(), 34u);
+    m.replace(std::move(parts.keys), std::move(parts.values));
+    EXPECT_EQ(m.at(3), 9);
+
+    m.swap(copy);
+    EXPECT_EQ(m.size(), 100u);
+    EXPECT_EQ(copy.size(), 34u);
+}
+
+// 值构造抛异常：键必须被撤掉，映射保持原样
+struct Throwing {
+    static inline int budget = -1;
+    int v = 0;
+    Throwing() = default;
+    explicit Throwing(int x) : v(x) {
+        if (budget == 0) throw std::runtime_error("boom");
+        if (budget > 0) --budget;
+    }
+};
+
+TEST(FlatMapTest, FailedInsertLeavesMapUnchanged) {
+    flat_map<int, Throwing> m;
+    m.try_emplace(1, 1);
+    m.try_emplace(3, 3);
+    Throwing::budget = 0;
+    EXPECT_THROW(m.try_emplace(2, 2), std::runtime_error);
+    Throwing::budget = -1;
+    EXPECT_EQ(m.size(), 2u);
+    EXPECT_EQ(m.keys().size(), m.values().size());
+    EXPECT_FALSE(m.contains(2));
+    EXPECT_EQ(m.at(3).v, 3);
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include <bit>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "../include/flat_hash_map_lt.h"
+#include "../include/hash_lt.h"
+
+using namespace leistd;
+
+static std::vector<unsigned char> random_bytes(std::size_t n, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<unsigned char> v(n);
+    for (auto& c : v) c = static_cast<unsigned char>(rng());
+    return v;
+}
+
+TEST(HashBytesTest, DeterministicAndSeeded) {
+    auto buf = random_bytes(9000, 1);
+    for (std::size_t n : {0u, 1u, 3u, 4u, 8u, 16u, 17u, 48u, 49u, 100u, 1024u, 4096u, 4097u, 5000u, 9000u}) {
+        EXPECT_EQ(hash_bytes(buf.data(), n), hash_bytes(buf.data(), n));
+        EXPECT_EQ(hash_bytes(buf.data(), n, 7), hash_bytes(buf.data(), n, 7));
+        EXPECT_NE(hash_bytes(buf.data(), n, 1), hash_bytes(buf.data(), n, 2)) << n;
+    }
+}
+
+// 长度覆盖短路径、wyhash 循环和条带累加三段；每个长度取多份随机内容，64 位结果不应碰撞
+TEST(HashBytesTest, NoCollisionsAcrossLengths) {
+    std::mt19937_64 rng(2);
+    std::unordered_set<std::uint64_t> seen;
+    std::size_t total = 0;
+    for (std::size_t n = 0; n <= 4200; n += (n < 600 || n >= 4000 ? 1 : 37)) {
+        for (int k = 0; k < (n == 0 ? 1 : 20); ++k) {
+            auto buf = random_bytes(n, rng());
+            seen.insert(hash_bytes(buf.data(), n));
+            ++total;
+        }
+    }
+    EXPECT_EQ(seen.size(), total);
+
+    // 同样的内容，前缀长度不同也要区分（包括全零）
+    std::vector<unsigned char> zeros(5000, 0);
+    seen.clear();
+    for (std::size_t n = 0; n <= 5000; ++n) seen.insert(hash_bytes(zeros.data(), n));
+    EXPECT_EQ(seen.size(), 5001u);
+}
+
+// 翻转任意一位，输出约一半的位跟着变
+TEST(HashBytesTest, Avalanche) {
+    for (std::size_t n : {8u, 24u, 100u, 300u, 2000u, 6000u}) {
+        auto buf = random_bytes(n, n);
+        std::uint64_t h = hash_bytes(buf.data(), n);
+        int flips = 0, trials = 0;
+        for (std::size_t bit = 0; bit < n * 8; bit += (n * 8) / 64 + 1) {
+            buf[bit / 8] ^= static_cast<unsigned char>(1u << (bit % 8));
+            flips += std::popcount(h ^ hash_bytes(buf.data(), n));
+            buf[bit / 8] ^= static_cast<unsigned char>(1u << (bit % 8));
+            ++trials;
+        }
+        double avg = static_cast<double>(flips) / trials;
+        EXPECT_GT(avg, 24.0) << n;
+        EXPECT_LT(avg, 40.0) << n;
+    }
+}
+
+#ifdef LEISTD_HASH_BYTES_X86
+// 三种实现必须逐位一致，否则同一份数据在不同机器上哈希不同
+TEST(HashBytesTest, KernelsAgree) {
+    auto buf = random_bytes(20000, 3);
+    bool avx2 = __builtin_cpu_supports("avx2");
+    for (std::size_t n = 65; n < 20000; n += (n < 2200 ? 1 : 997)) {
+        for (std::uint64_t seed : {0ull, 1ull, 0xdeadbeefull}) {
+            std::uint64_t s = hash_bytes_detail::hash_long_scalar(buf.data(), n, seed);
+            ASSERT_EQ(s, hash_bytes_detail::hash_long_sse2(buf.data(), n, seed)) << n;
+            if (avx2) {
+                ASSERT_EQ(s, hash_bytes_detail::hash_long_avx2(buf.data(), n, seed)) << n;
+            }
+        }
+    }
+    // 未对齐的起始地址
+    for (std::size_t off = 1; off < 8; ++off) {
+        std::uint64_t s = hash_bytes_detail::hash_long_scalar(buf.data() + off, 5000, 0);
+        EXPECT_EQ(s, hash_bytes(buf.data() + off, 5000));
+    }
+}
+#endif
+
+TEST(StringHashTest, ConsistentAcrossTypes) {
+    for (std::size_t n : {0u, 5u, 15u, 16u, 40u, 300u, 5000u}) {
+        std::string src(n, 'x');
+        for (std::size_t i = 0; i < n; ++i) src[i] = static_cast<char>('a' + i * 7 % 26);
+        string s(src.c_str());
+        string_view sv(src.data(), src.size());
+        hashed_string hs(sv);
+        std::size_t h = hash<string>()(s);
+        EXPECT_EQ(h, std::hash<string>()(s));
+        EXPECT_EQ(h, std::hash<string_view>()(sv));
+        EXPECT_EQ(h, hash<string_view>()(sv));
+        EXPECT_EQ(h, hash<string>()(sv));
+        EXPECT_EQ(h, hs.hash());
+        EXPECT_EQ(h, std::hash<hashed_string>()(hs));
+        EXPECT_EQ(h, hash<hashed_string>()(sv));
+        EXPECT_NE(h, hash<string>(12345)(s));
+    }
+}
+
+TEST(StringHashTest, StdUnorderedMapKey) {
+    std::unordered_map<string, int> m;
+    for (int i = 0; i < 1000; ++i) m[string(std::to_string(i).c_str())] = i;
+    EXPECT_EQ(m.size(), 1000u);
+    for (int i = 0; i < 1000; ++i) {
+        auto it = m.find(string(std::to_string(i).c_str()));
+        ASSERT_NE(it, m.end());
+        EXPECT_EQ(it->second, i);
+    }
+    EXPECT_EQ(m.count(string("1000")), 0u);
+}
+
+TEST(StringHashTest, StringEquality) {
+    string a("hello world, long enough to leave SSO");
+    string b("hello world, long enough to leave SSO");
+    string c("hello");
+    EXPECT_TRUE(a == b);
+    EXPECT_FALSE(a == c);
+    EXPECT_TRUE(c == "hello");
+    EXPECT_TRUE("hello" == c);
+    EXPECT_TRUE(c == string_view("hello"));
+    EXPECT_TRUE(a != c);
+}
+
+// 带种子的哈希交给容器：结果不变，只是元素分布不同
+TEST(StringHashTest, SeededFlatHashMap) {
+    flat_hash_map<string, int, hash<string>> m(0, hash<string>(0x9e3779b97f4a7c15ull));
+    for (int i = 0; i < 2000; ++i) m.emplace(string(std::to_string(i).c_str()), i);
+    EXPECT_EQ(m.size(), 2000u);
+    for (int i = 0; i < 2000; ++i) EXPECT_EQ(m.at(string(std::to_string(i).c_str())), i);
+    EXPECT_TRUE(m.contains(string_view("1999")));
+    EXPECT_TRUE(m.contains("42"));
+    EXPECT_FALSE(m.contains("2000"));
+}
+
+TEST(HashedStringTest, Basics) {
+    hashed_string a("alpha"), b(string("alpha")), c("beta"), e;
+    EXPECT_TRUE(a == b);
+    EXPECT_FALSE(a == c);
+    EXPECT_EQ(a.hash(), b.hash());
+    EXPECT_EQ(a.size(), 5u);
+    EXPECT_TRUE(e.empty());
+    EXPECT_EQ(e.hash(), hash<string_view>()(string_view("")));
+    EXPECT_EQ(a.view(), string_view("alpha"));
+    EXPECT_STREQ(a.data(), "alpha");
+
+    hashed_string moved(std::move(a));
+    EXPECT_TRUE(moved == b);
+    EXPECT_EQ(moved.hash(), b.hash());
+}
+
+TEST(HashedStringTest, FlatHashMapTransparentLookup) {
+    flat_hash_map<hashed_string, int> m;
+    std::vector<std::string> keys;
+    for (int i = 0; i < 5000; ++i) keys.push_back("key-" + std::to_string(i) + std::string(i % 40, 'p'));
+    for (int i = 0; i < 5000; ++i) m.emplace(hashed_string(keys[i].c_str()), i);
+    EXPECT_EQ(m.size(), 5000u);
+    for (int i = 0; i < 5000; i += 3) {
+        auto it = m.find(string_view(keys[i].data(), keys[i].size()));
+        ASSERT_NE(it, m.end());
+        EXPECT_EQ(it->second, i);
+    }
+    EXPECT_EQ(m.count(string_view("missing")), 0u);
+    for (int i = 0; i < 5000; i += 2) EXPECT_EQ(m.erase(hashed_string(keys[i].c_str())), 1u);
+    EXPECT_EQ(m.size(), 2500u);
+    for (int i = 1; i < 5000; i += 2) EXPECT_TRUE(m.contains(string_view(keys[i].data(), keys[i].size())));
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
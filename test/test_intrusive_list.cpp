@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include "../include/intrusive_list_lt.h"
+
+using namespace leistd;
+
+struct Task {
+    int id = 0;
+    list_hook run_hook;    // 就绪队列
+    list_hook owner_hook;  // 所属用户的任务表
+
+    explicit Task(int i = 0) : id(i) {}
+};
+
+using run_queue = intrusive_list<Task, &Task::run_hook>;
+using owner_list = intrusive_list<Task, &Task::owner_hook>;
+
+template <typename List>
+static std::vector<int> ids(const List& l) {
+    std::vector<int> r;
+    for (const auto& t : l) r.push_back(t.id);
+    return r;
+}
+
+TEST(IntrusiveListTest, PushPopAndIterate) {
+    Task a(1), b(2), c(3), d(4);
+    run_queue q;
+    q.push_back(b);
+    q.push_back(c);
+    q.push_front(a);
+    q.insert(q.end(), d);
+    EXPECT_EQ(q.size(), 4u);
+    EXPECT_EQ(ids(q), (std::vector<int>{1, 2, 3, 4}));
+    EXPECT_EQ(q.front().id, 1);
+    EXPECT_EQ(q.back().id, 4);
+    EXPECT_EQ(&*q.begin(), &a);  // 迭代器直接指向原对象
+
+    std::vector<int> backward;
+    for (auto it = q.rbegin(); it != q.rend(); ++it) backward.push_back(it->id);
+    EXPECT_EQ(backward, (std::vector<int>{4, 3, 2, 1}));
+
+    q.pop_front();
+    q.pop_back();
+    EXPECT_EQ(ids(q), (std::vector<int>{2, 3}));
+    EXPECT_FALSE(a.run_hook.is_linked());
+    EXPECT_TRUE(b.run_hook.is_linked());
+    q.clear();
+    EXPECT_TRUE(q.empty());
+    EXPECT_FALSE(b.run_hook.is_linked());
+}
+
+TEST(IntrusiveListTest, OnSeveralListsAtOnce) {
+    std::vector<std::unique_ptr<Task>> pool;
+    for (int i = 0; i < 6; ++i) pool.push_back(std::make_unique<Task>(i));
+    run_queue q;
+    owner_list even, odd;
+    for (auto& t : pool) {
+        q.push_back(*t);
+        (t->id % 2 ? odd : even).push_back(*t);
+    }
+    EXPECT_EQ(ids(q), (std::vector<int>{0, 1, 2, 3, 4, 5}));
+    EXPECT_EQ(ids(even), (std::vector<int>{0, 2, 4}));
+
+    // 从一条链表摘下不影响另一条
+    q.erase(*pool[2]);
+    EXPECT_EQ(ids(q), (std::vector<int>{0, 1, 3, 4, 5}));
+    EXPECT_EQ(ids(even), (std::vector<int>{0, 2, 4}));
+    EXPECT_TRUE(pool[2]->owner_hook.is_linked());
+    EXPECT_FALSE(pool[2]->run_hook.is_linked());
+
+    auto it = q.erase(q.iterator_to(*pool[3]));  // O(1)，不用查找
+    EXPECT_EQ(it->id, 4);
+    EXPECT_EQ(q.size(), 4u);
+    EXPECT_EQ(q.remove_if([](const Task& t) { return t.id >= 4; }), 2u);
+    EXPECT_EQ(ids(q), (std::vector<int>{0, 1}));
+
+    q.clear();
+    even.clear();
+    odd.clear();
+}
+
+TEST(IntrusiveListTest, Splice) {
+    Task t[8];
+    for (int i = 0; i < 8; ++i) t[i].id = i;
+    run_queue a, b;
+    for (int i = 0; i < 4; ++i) a.push_back(t[i]);
+    for (int i = 4; i < 8; ++i) b.push_back(t[i]);
+
+    a.splice(std::next(a.begin()), b, std::next(b.begin()), std::prev(b.end()));
+    EXPECT_EQ(ids(a), (std::vector<int>{0, 5, 6, 1, 2, 3}));
+    EXPECT_EQ(ids(b), (std::vector<int>{4, 7}));
+    EXPECT_EQ(a.size(), 6u);
+    EXPECT_EQ(b.size(), 2u);
+
+    b.splice(b.begin(), a, a.iterator_to(t[3]));
+    a.splice(a.begin(), a, a.begin());  // 原地，什么也不做
+    EXPECT_EQ(ids(b), (std::vector<int>{3, 4, 7}));
+    a.splice(a.end(), b, b.begin(), b.end(), 3);
+    EXPECT_EQ(ids(a), (std::vector<int>{0, 5, 6, 1, 2, 3, 4, 7}));
+    EXPECT_EQ(a.size(), 8u);
+    EXPECT_TRUE(b.empty());
+}
+
+TEST(IntrusiveListTest, MoveAndSwap) {
+    Task t[4];
+    for (int i = 0; i < 4; ++i) t[i].id = i;
+    run_queue a;
+    a.push_back(t[0]);
+    a.push_back(t[1]);
+    run_queue b = std::move(a);
+    EXPECT_TRUE(a.empty());
+    EXPECT_EQ(ids(b), (std::vector<int>{0, 1}));
+
+    a.push_back(t[2]);
+    swap(a, b);
+    EXPECT_EQ(ids(a), (std::vector<int>{0, 1}));
+    EXPECT_EQ(ids(b), (std::vector<int>{2}));
+    b.push_back(t[3]);
+    EXPECT_EQ(std::prev(b.end())->id, 3);  // 哨兵已修正
+
+    run_queue empty;
+    swap(b, empty);
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(empty.size(), 2u);
+    a.clear();
+    empty.clear();
+}
+
+struct Session {
+    int id;
+    auto_unlink_list_hook hook;
+};
+
+TEST(IntrusiveListTest, AutoUnlinkOnDestruction) {
+    intrusive_list<Session, &Session::hook> active;
+    Session s1{1, {}};
+    {
+        Session s2{2, {}};
+        Session s3{3, {}};
+        active.push_back(s1);
+        active.push_back(s2);
+        active.push_back(s3);
+        EXPECT_EQ(active.size(), 3u);
+        s2.hook.unlink();  // 不经过链表直接摘下
+        EXPECT_EQ(active.size(), 2u);
+    }  // s3 析构时自动离开链表
+    EXPECT_EQ(active.size(), 1u);
+    EXPECT_EQ(active.front().id, 1);
+
+    Session copy = s1;  // 钩子不随对象拷贝
+    EXPECT_FALSE(copy.hook.is_linked());
+    EXPECT_TRUE(s1.hook.is_linked());
+}
+
+struct Plain {
+    int value;
+    basic_list_hook<link_mode::normal> hook;
+};
+
+TEST(IntrusiveListTest, NormalModeHooks) {
+    Plain p[3] = {{1, {}}, {2, {}}, {3, {}}};
+    intrusive_list<Plain, &Plain::hook> l;
+    for (auto& x : p) l.push_back(x);
+    l.erase(p[1]);
+    int sum = 0;
+    for (auto& x : l) sum += x.value;
+    EXPECT_EQ(sum, 4);
+    EXPECT_EQ(l.size(), 2u);
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
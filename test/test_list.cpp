@@ -2,6 +2,12 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <utility>
+#include <vector>
+
 using namespace leistd;
 
 TEST(TestListForBaseDataType, PushAndPop) {
@@ -84,6 +90,149 @@ TEST(TestListForBaseDataType, Insert) {
   EXPECT_EQ(list.back(), 4);
 }
 
+TEST(TestListForBaseDataType, Erase) {
+  list<int> l = {1, 2, 3, 4, 5};
+  auto it = l.erase(std::next(l.begin()));
+  EXPECT_EQ(*it, 3);
+  it = l.erase(it, std::prev(l.end()));
+  EXPECT_EQ(*it, 5);
+  EXPECT_EQ(l.size(), 2);
+  EXPECT_EQ(l.front(), 1);
+  EXPECT_EQ(l.erase(std::prev(l.end())), l.end());
+  EXPECT_EQ(l.back(), 1);
+}
+
+template <typename List>
+static std::vector<typename List::value_type> to_vector(const List& l) {
+  return std::vector<typename List::value_type>(l.begin(), l.end());
+}
+
+TEST(TestListAlgorithms, SortIsStable) {
+  std::mt19937 rng(1);
+  for (int n : {0, 1, 2, 3, 17, 1000, 5000}) {
+    list<std::pair<int, int>> l;
+    std::vector<std::pair<int, int>> ref;
+    for (int i = 0; i < n; ++i) {
+      l.push_back({int(rng() % 50), i});  // 大量重复键，second 记录原始顺序
+      ref.push_back(l.back());
+    }
+    auto by_key = [](const auto& a, const auto& b) { return a.first < b.first; };
+    l.sort(by_key);
+    std::stable_sort(ref.begin(), ref.end(), by_key);
+    EXPECT_EQ(to_vector(l), ref);
+    EXPECT_EQ(l.size(), size_t(n));
+    // prev 指针也要正确
+    std::vector<std::pair<int, int>> backward;
+    for (auto it = l.end(); it != l.begin();) backward.push_back(*--it);
+    EXPECT_TRUE(std::equal(backward.begin(), backward.end(), ref.rbegin(), ref.rend()));
+  }
+}
+
+TEST(TestListAlgorithms, SortNaturalRuns) {
+  list<int> sorted, reversed, sawtooth;
+  std::vector<int> expect;
+  for (int i = 0; i < 1000; ++i) {
+    sorted.push_back(i);
+    reversed.push_front(i);
+    sawtooth.push_back(i % 37);
+    expect.push_back(i);
+  }
+  sorted.sort();
+  reversed.sort();
+  sawtooth.sort(std::greater<>());
+  EXPECT_EQ(to_vector(sorted), expect);
+  EXPECT_EQ(to_vector(reversed), expect);
+  std::vector<int> saw = to_vector(sawtooth);
+  EXPECT_TRUE(std::is_sorted(saw.begin(), saw.end(), std::greater<>()));
+  EXPECT_EQ(saw.size(), 1000u);
+}
+
+TEST(TestListAlgorithms, MergeWithComparator) {
+  list<int> a = {9, 7, 5, 1};
+  list<int> b = {8, 6, 2, 0};
+  a.merge(b, std::greater<>());
+  EXPECT_EQ(to_vector(a), (std::vector<int>{9, 8, 7, 6, 5, 2, 1, 0}));
+  EXPECT_TRUE(b.empty());
+  EXPECT_EQ(b.begin(), b.end());
+
+  list<int> c = {1, 3};
+  c.merge(list<int>{0, 2, 4});
+  EXPECT_EQ(to_vector(c), (std::vector<int>{0, 1, 2, 3, 4}));
+  EXPECT_EQ(c.back(), 4);
+}
+
+TEST(TestListAlgorithms, UniqueAndRemoveIf) {
+  list<int> l = {1, 1, 2, 2, 2, 3, 1, 1, 4};
+  EXPECT_EQ(l.unique(), 4u);
+  EXPECT_EQ(to_vector(l), (std::vector<int>{1, 2, 3, 1, 4}));
+  EXPECT_EQ(l.size(), 5u);
+
+  list<int> m = {1, 2, 4, 7, 8, 20};
+  EXPECT_EQ(m.unique([](int a, int b) { return b - a < 3; }), 2u);  // 与保留下来的前一个元素比较
+  EXPECT_EQ(to_vector(m), (std::vector<int>{1, 4, 7, 20}));
+
+  EXPECT_EQ(l.remove_if([](int x) { return x % 2 == 1; }), 3u);
+  EXPECT_EQ(to_vector(l), (std::vector<int>{2, 4}));
+  EXPECT_EQ(l.back(), 4);
+
+  list<int> r = {5, 1, 5, 5, 2};
+  EXPECT_EQ(r.remove(r.front()), 3u);  // 参数引用的正是被删除的元素
+  EXPECT_EQ(to_vector(r), (std::vector<int>{1, 2}));
+}
+
+TEST(TestListAlgorithms, Reverse) {
+  list<int> l = {1, 2, 3, 4};
+  l.reverse();
+  EXPECT_EQ(to_vector(l), (std::vector<int>{4, 3, 2, 1}));
+  std::vector<int> backward(std::make_reverse_iterator(l.end()), std::make_reverse_iterator(l.begin()));
+  EXPECT_EQ(backward, (std::vector<int>{1, 2, 3, 4}));
+  list<int> e;
+  e.reverse();
+  EXPECT_TRUE(e.empty());
+}
+
+TEST(TestListSplice, CountedRangeSplice) {
+  list<int> a = {1, 2, 3, 4, 5, 6};
+  list<int> b = {10, 20};
+  auto first = std::next(a.begin(), 1), last = std::next(a.begin(), 4);
+  b.splice(std::next(b.begin()), a, first, last, 3);
+  EXPECT_EQ(to_vector(a), (std::vector<int>{1, 5, 6}));
+  EXPECT_EQ(to_vector(b), (std::vector<int>{10, 2, 3, 4, 20}));
+  EXPECT_EQ(a.size(), 3u);
+  EXPECT_EQ(b.size(), 5u);
+
+  // 同一链表内移动：不计数，size 不变
+  b.splice(b.begin(), b, std::next(b.begin(), 3), b.end());
+  EXPECT_EQ(to_vector(b), (std::vector<int>{4, 20, 10, 2, 3}));
+  EXPECT_EQ(b.size(), 5u);
+}
+
+TEST(TestListSplice, LazySizeList) {
+  lazy_size_list<int> a, b;
+  for (int i = 0; i < 10; ++i) a.push_back(i);
+  b.push_back(100);
+  b.splice(b.end(), a, std::next(a.begin(), 2), std::next(a.begin(), 7));  // O(1)，两边长度变为未知
+  EXPECT_FALSE(a.empty());
+  a.push_back(10);  // 长度未知时的增删不影响之后的计数
+  b.pop_front();
+  EXPECT_EQ(a.size(), 6u);
+  EXPECT_EQ(b.size(), 5u);
+  EXPECT_EQ(to_vector(b), (std::vector<int>{2, 3, 4, 5, 6}));
+
+  a.splice(a.begin(), b, b.begin(), b.end(), 5);  // 已知长度时仍然精确维护
+  EXPECT_EQ(a.size(), 11u);
+  EXPECT_TRUE(b.empty());
+  EXPECT_EQ(b.size(), 0u);
+
+  a.splice(a.end(), b);
+  a.merge(b);
+  lazy_size_list<int> c = std::move(a);
+  EXPECT_EQ(c.size(), 11u);
+  c.sort();
+  EXPECT_EQ(c.front(), 0);
+  EXPECT_EQ(c.back(), 10);
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
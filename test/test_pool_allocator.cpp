@@ -0,0 +1,118 @@
+#define LEISTD_LIST_USE_NODE_POOL
+#include <gtest/gtest.h>
+#include <set>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "../include/list_lt.h"
+#include "../include/pool_allocator_lt.h"
+
+using namespace leistd;
+
+TEST(PoolAllocatorTest, SlabPoolRecyclesBySizeClass) {
+    slab_pool pool;
+    void* a = pool.allocate(24);
+    void* b = pool.allocate(32);  // 与 24 同属 32 字节级
+    EXPECT_EQ(static_cast<char*>(b) - static_cast<char*>(a), 32);
+    pool.deallocate(a, 24);
+    EXPECT_EQ(pool.allocate(30), a);  // 空闲链表后进先出
+
+    void* c = pool.allocate(16);  // 不同级，来自另一个 slab
+    EXPECT_NE(c, static_cast<char*>(b) + 32);
+
+    void* big = pool.allocate(1000);  // 超出分级范围，直接走 operator new
+    pool.deallocate(big, 1000);
+    void* arr = pool.allocate(8, 4);  // 一次多个对象同样不走池
+    pool.deallocate(arr, 8, 4);
+}
+
+// 0 字节的请求按最小的一级分配，每次得到不同的地址
+TEST(PoolAllocatorTest, ZeroByteRequests) {
+    slab_pool pool;
+    void* a = pool.allocate(0);
+    void* b = pool.allocate(0);
+    EXPECT_NE(a, nullptr);
+    EXPECT_NE(a, b);
+    pool.deallocate(a, 0);
+    EXPECT_EQ(pool.allocate(16), a);  // 与 16 字节同属第 0 级
+    pool.deallocate(b, 0);
+
+    void* arr = pool.allocate(0, 3);  // 多个 0 字节对象走 operator new
+    pool.deallocate(arr, 0, 3);
+}
+
+TEST(PoolAllocatorTest, ManyObjectsAreDistinct) {
+    slab_pool pool;
+    std::set<void*> seen;
+    std::vector<void*> ptrs;
+    for (int i = 0; i < 5000; ++i) {
+        void* p = pool.allocate(48);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % 16, 0);
+        EXPECT_TRUE(seen.insert(p).second);
+        ptrs.push_back(p);
+    }
+    for (void* p : ptrs) pool.deallocate(p, 48);
+    for (int i = 0; i < 5000; ++i) EXPECT_TRUE(seen.count(pool.allocate(48)));  // 全部复用
+}
+
+TEST(PoolAllocatorTest, ListWithPerListPool) {
+    slab_pool pool;
+    list<int, pool_allocator<int>> l(pool);
+    for (int i = 0; i < 1000; ++i) l.push_back(i);
+    for (int i = 0; i < 500; ++i) l.pop_front();
+    for (int i = 0; i < 500; ++i) l.push_front(i);
+    EXPECT_EQ(l.size(), 1000);
+    EXPECT_EQ(l.front(), 499);
+    EXPECT_EQ(l.back(), 999);
+
+    slab_pool other_pool;
+    list<int, pool_allocator<int>> other(other_pool);
+    other = l;  // 分配器不传播，节点仍从 other_pool 分配
+    EXPECT_EQ(other.get_allocator().pool(), &other_pool);
+    EXPECT_EQ(other.size(), 1000);
+}
+
+TEST(PoolAllocatorTest, ListDefaultsToSharedPool) {
+    static_assert(std::is_same_v<list<int>::allocator_type, shared_pool_allocator<int>>);
+    list<std::string> l;
+    for (int i = 0; i < 1000; ++i) l.push_back(std::to_string(i));
+    list<std::string> copy(l);
+    l.clear();
+    EXPECT_EQ(copy.size(), 1000);
+    EXPECT_EQ(copy.back(), "999");
+}
+
+TEST(PoolAllocatorTest, CrossThreadChurn) {
+    // 一个线程分配的节点交给另一个线程释放
+    constexpr int per_thread = 20000;
+    std::vector<list<int>> lists(4);
+    std::vector<std::thread> producers;
+    for (int t = 0; t < 4; ++t)
+        producers.emplace_back([&, t] {
+            for (int i = 0; i < per_thread; ++i) lists[t].push_back(i);
+        });
+    for (auto& th : producers) th.join();
+
+    std::vector<std::thread> consumers;
+    for (int t = 0; t < 4; ++t)
+        consumers.emplace_back([&, t] {
+            list<int>& l = lists[3 - t];
+            long sum = 0;
+            while (!l.empty()) {
+                sum += l.front();
+                l.pop_front();
+            }
+            EXPECT_EQ(sum, long(per_thread) * (per_thread - 1) / 2);
+        });
+    for (auto& th : consumers) th.join();
+
+    list<int, shared_pool_allocator<int, false>> uncached;  // 不经过线程缓存
+    for (int i = 0; i < 100; ++i) uncached.push_back(i);
+    EXPECT_EQ(uncached.back(), 99);
+}
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <iterator>
+#include <random>
+#include <string>
+#include "../include/rope_lt.h"
+
+using namespace leistd;
+
+static std::string to_std(const crope& r) {
+    std::string out;
+    for (string_view chunk : r.chunks()) out.append(chunk.data(), chunk.size());
+    return out;
+}
+
+TEST(RopeTest, BasicConcat) {
+    crope r;
+    EXPECT_TRUE(r.empty());
+    EXPECT_EQ(r.depth(), -1);
+    r += "hello";
+    r += crope(", ");
+    r.append(string_view("world"));
+    EXPECT_EQ(r.size(), 12);
+    EXPECT_EQ(r[7], 'w');
+    EXPECT_STREQ(r.flatten().c_str(), "hello, world");
+    EXPECT_THROW(r.at(12), std::out_of_range);
+
+    crope joined = r + "!" + r;
+    EXPECT_EQ(to_std(joined), "hello, world!hello, world");
+    EXPECT_EQ(to_std(r), "hello, world");  // 原 rope 不受影响
+}
+
+TEST(RopeTest, AdoptsStringBuffer) {
+    string big;
+    big.append(1000, 'q');
+    const char* data = big.c_str();
+    crope r(std::move(big));
+    auto it = r.chunk_begin();
+    EXPECT_EQ((*it).data(), data);  // 直接引用原缓冲区
+    EXPECT_EQ((*it).size(), 1000);
+    EXPECT_TRUE(++it == r.chunk_end());
+
+    crope mid = r.substr(100, 10);
+    EXPECT_EQ((*mid.chunk_begin()).data(), data + 100);  // 子串不拷贝
+}
+
+TEST(RopeTest, SmallFragmentsAreMerged) {
+    crope r;
+    for (int i = 0; i < 10000; ++i) r += "frag;";
+    EXPECT_EQ(r.size(), 50000);
+    size_t chunks = 0;
+    for (string_view c : r.chunks()) {
+        ++chunks;
+        EXPECT_LE(c.size(), 256);
+    }
+    EXPECT_LT(chunks, 50000 / 128);
+    EXPECT_LE(r.depth(), 1.45 * std::log2(chunks) + 2);
+}
+
+TEST(RopeTest, RandomEditsMatchStdString) {
+    std::mt19937 rng(23);
+    crope r;
+    std::string ref;
+    for (int step = 0; step < 3000; ++step) {
+        size_t pos = rng() % (ref.size() + 1);
+        switch (rng() % 5) {
+            case 0:
+            case 1: {
+                std::string piece(1 + rng() % 300, static_cast<char>('a' + step % 26));
+                r.insert(pos, string_view(piece.data(), piece.size()));
+                ref.insert(pos, piece);
+                break;
+            }
+            case 2: {
+                size_t n = rng() % 200;
+                r.erase(pos, n);
+                ref.erase(pos, n);
+                break;
+            }
+            case 3: {  // 插入自身的一段
+                size_t n = rng() % (ref.size() - pos + 1);
+                crope part = r.substr(pos, n);
+                size_t at = rng() % (ref.size() + 1);
+                r.insert(at, part);
+                ref.insert(at, ref.substr(pos, n));
+                break;
+            }
+            default:
+                if (!ref.empty()) {
+                    size_t i = rng() % ref.size();
+                    ASSERT_EQ(r[i], ref[i]);
+                }
+                break;
+        }
+        if (ref.size() > 20000) {
+            r = r.substr(10000);
+            ref = ref.substr(10000);
+        }
+        ASSERT_EQ(r.size(), ref.size());
+    }
+    EXPECT_EQ(to_std(r), ref);
+    EXPECT_EQ(r.flatten().view(), string_view(ref.data(), ref.size()));
+
+    size_t chunks = 0;
+    for (auto it = r.chunk_begin(); it != r.chunk_end(); ++it) ++chunks;
+    EXPECT_LE(r.depth(), 1.45 * std::log2(chunks + 1) + 2);
+}
+
+TEST(RopeTest, Equality) {
+    crope a = crope("abc") + "def" + "ghi";
+    crope b("abcdefghi");
+    EXPECT_TRUE(a == b);
+    EXPECT_FALSE(a == crope("abcdefghj"));
+    EXPECT_FALSE(a == crope("abc"));
+    EXPECT_TRUE(crope() == crope(""));
+}
+
+// 自我拼接：左右孩子是同一棵共享子树，迭代器要按路径区分两次访问
+TEST(RopeTest, SelfAppendSharesSubtree) {
+    std::string s;
+    for (int i = 0; i < 600; ++i) s.push_back(static_cast<char>('a' + i % 26));
+    crope r{string_view(s.data(), s.size())};
+    crope doubled = r + r;
+    r += r;
+    std::string expected = s + s;
+    EXPECT_EQ(r.size(), expected.size());
+    EXPECT_EQ(std::string(r.flatten().c_str()), expected);
+    EXPECT_EQ(to_std(r), expected);
+    EXPECT_EQ(to_std(doubled), expected);
+    size_t total = 0;
+    for (string_view c : r.chunks()) total += c.size();
+    EXPECT_EQ(total, expected.size());
+    EXPECT_TRUE(r == doubled);
+    EXPECT_TRUE(r == crope(string_view(expected.data(), expected.size())));
+    std::string last_differs = expected;
+    last_differs.back() = '#';
+    EXPECT_FALSE(r == crope(string_view(last_differs.data(), last_differs.size())));
+
+    // 两个位置上是同一个叶子，迭代器也不能相等
+    auto first = r.chunk_begin();
+    auto second = std::next(first);
+    EXPECT_FALSE(first == second);
+    EXPECT_EQ((*first).data(), (*second).data());
+
+    for (int i = 0; i < 3; ++i) {
+        r += r;
+        expected += expected;
+    }
+    EXPECT_EQ(to_std(r), expected);
+    EXPECT_TRUE(r == crope(string_view(expected.data(), expected.size())));
+}
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <random>
+#include <string>
+#include <vector>
+#include "../include/search_lt.h"
+
+using namespace leistd;
+
+// leistd::array 不是聚合类型，不能花括号初始化
+template <typename T, std::size_t N>
+constexpr array<T, N> make_array(std::initializer_list<T> init) {
+    array<T, N> a{};
+    std::size_t i = 0;
+    for (const T& x : init) a[i++] = x;
+    return a;
+}
+
+// 和 std::lower_bound / upper_bound 逐个对照，包括重复元素和空区间
+TEST(SearchTest, BoundsMatchStd) {
+    std::mt19937 rng(1);
+    for (std::size_t n = 0; n <= 70; ++n) {
+        std::vector<int> v(n);
+        for (auto& x : v) x = static_cast<int>(rng() % 20);
+        std::sort(v.begin(), v.end());
+        for (int key = -1; key <= 21; ++key) {
+            EXPECT_EQ(leistd::lower_bound(v.begin(), v.end(), key), std::lower_bound(v.begin(), v.end(), key));
+            EXPECT_EQ(leistd::upper_bound(v.begin(), v.end(), key), std::upper_bound(v.begin(), v.end(), key));
+            EXPECT_EQ(leistd::binary_search(v.begin(), v.end(), key), std::binary_search(v.begin(), v.end(), key));
+        }
+    }
+}
+
+// 超出 prefetch_min_bytes 的区间走带预取的版本
+TEST(SearchTest, LargeRangeWithPrefetch) {
+    std::mt19937 rng(2);
+    std::vector<int> v(100000);
+    for (auto& x : v) x = static_cast<int>(rng() % 50000);
+    std::sort(v.begin(), v.end());
+    const int* first = v.data();
+    const int* last = first + v.size();
+    for (int i = 0; i < 2000; ++i) {
+        int key = static_cast<int>(rng() % 50002) - 1;
+        EXPECT_EQ(leistd::lower_bound(first, last, key), std::lower_bound(first, last, key));
+        EXPECT_EQ(leistd::upper_bound(first, last, key), std::upper_bound(first, last, key));
+    }
+}
+
+TEST(SearchTest, LeistdVectorAndComparator) {
+    leistd::vector<int> v;
+    for (int i = 20; i > 0; --i) v.push_back(i * 2);  // 按 greater 有序
+    auto it = leistd::lower_bound(v.begin(), v.end(), 15, std::greater<>());
+    EXPECT_EQ(it - v.begin(), 13);
+    EXPECT_EQ(*it, 14);
+    EXPECT_TRUE(leistd::binary_search(v.begin(), v.end(), 40, std::greater<>()));
+    EXPECT_FALSE(leistd::binary_search(v.begin(), v.end(), 41, std::greater<>()));
+    EXPECT_EQ(leistd::upper_bound(v.begin(), v.end(), 2, std::greater<>()), v.end());
+}
+
+// 小数组：算术类型不超过 linear_search_bytes 走计数，其余走展开的二分
+TEST(SearchTest, ArrayPaths) {
+    auto small = make_array<int, 7>({1, 3, 3, 5, 7, 9, 11});
+    array<long, 32> counted;
+    array<long, 100> unrolled;
+    for (std::size_t i = 0; i < 32; ++i) counted[i] = static_cast<long>(i / 2);
+    for (std::size_t i = 0; i < 100; ++i) unrolled[i] = static_cast<long>(i / 3);
+    for (int key = 0; key <= 40; ++key) {
+        EXPECT_EQ(leistd::lower_bound(small, key), std::lower_bound(small.begin(), small.end(), key));
+        EXPECT_EQ(leistd::lower_bound(counted, key), std::lower_bound(counted.begin(), counted.end(), key));
+        EXPECT_EQ(leistd::lower_bound(unrolled, key), std::lower_bound(unrolled.begin(), unrolled.end(), key));
+        EXPECT_EQ(leistd::binary_search(small, key), std::binary_search(small.begin(), small.end(), key));
+    }
+
+    auto words = make_array<std::string, 4>({"apple", "kiwi", "mango", "pear"});
+    EXPECT_EQ(leistd::lower_bound(words, std::string("lemon")) - words.data(), 2);
+    EXPECT_TRUE(leistd::binary_search(words, std::string("kiwi")));
+
+    *leistd::lower_bound(small, 4) = 4;  // 非 const 重载返回可写指针
+    EXPECT_EQ(small[3], 4);
+}
+
+constexpr auto primes = make_array<int, 5>({2, 3, 5, 7, 11});
+static_assert(*leistd::lower_bound(primes, 6) == 7);
+static_assert(leistd::binary_search(primes, 11));
+static_assert(!leistd::binary_search(primes, 4));
+
+TEST(EytzingerIndexTest, MatchesStdLowerBound) {
+    std::mt19937 rng(3);
+    for (std::size_t n : {0u, 1u, 2u, 3u, 7u, 8u, 15u, 16u, 17u, 100u, 1000u, 4097u}) {
+        std::vector<int> v(n);
+        for (auto& x : v) x = static_cast<int>(rng() % (n + 1) * 2);
+        std::sort(v.begin(), v.end());
+        eytzinger_index<int> index(v);
+        EXPECT_EQ(index.size(), n);
+        for (int key = -1; key <= static_cast<int>(2 * n + 3); ++key) {
+            std::size_t expected = std::lower_bound(v.begin(), v.end(), key) - v.begin();
+            EXPECT_EQ(index.lower_bound(key), expected);
+            EXPECT_EQ(index.contains(key), std::binary_search(v.begin(), v.end(), key));
+        }
+    }
+}
+
+TEST(EytzingerIndexTest, CopyMoveAndEmpty) {
+    eytzinger_index<int> empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.lower_bound(5), 0u);
+    EXPECT_FALSE(empty.contains(5));
+
+    std::vector<int> v{1, 4, 9, 16, 25, 36, 49};
+    eytzinger_index<int> a(v.begin(), v.end());
+    eytzinger_index<int> b(a);
+    eytzinger_index<int> c(std::move(a));
+    eytzinger_index<int> d;
+    d = b;
+    for (int key = 0; key <= 50; ++key) {
+        std::size_t expected = std::lower_bound(v.begin(), v.end(), key) - v.begin();
+        EXPECT_EQ(b.lower_bound(key), expected);
+        EXPECT_EQ(c.lower_bound(key), expected);
+        EXPECT_EQ(d.lower_bound(key), expected);
+    }
+}
+
+TEST(EytzingerIndexTest, CustomComparatorAndWideElements) {
+    std::vector<int> desc{50, 40, 30, 20, 10};
+    eytzinger_index<int, std::greater<>> g(desc, std::greater<>());
+    EXPECT_EQ(g.lower_bound(35), 2u);
+    EXPECT_EQ(g.lower_bound(5), 5u);
+    EXPECT_TRUE(g.contains(20));
+    EXPECT_FALSE(g.contains(25));
+
+    // 非平凡类型的元素
+    std::vector<std::string> words{"ant", "bee", "cat", "dog", "eel", "fox"};
+    eytzinger_index<std::string> w(words);
+    EXPECT_EQ(w.lower_bound(std::string("cow")), 3u);
+    EXPECT_TRUE(w.contains(std::string("fox")));
+    EXPECT_EQ(w.lower_bound(std::string("zebra")), 6u);
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include "../include/small_vector.h"
+
+using namespace leistd;
+
+static int g_heap_allocs = 0;
+
+template <typename T>
+struct CountingAlloc {
+    using value_type = T;
+    CountingAlloc() = default;
+    template <typename U>
+    CountingAlloc(const CountingAlloc<U>&) {}
+    T* allocate(size_t n) {
+        ++g_heap_allocs;
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T* p, size_t n) { std::allocator<T>().deallocate(p, n); }
+};
+
+TEST(SmallVectorTest, StaysInlineUpToN) {
+    g_heap_allocs = 0;
+    small_vector<int, 8, CountingAlloc<int>> v;
+    EXPECT_EQ(v.capacity(), 8);
+    for (int i = 0; i < 8; ++i) v.push_back(i);
+    EXPECT_TRUE(v.is_inline());
+    EXPECT_EQ(g_heap_allocs, 0);
+
+    v.push_back(8);
+    EXPECT_FALSE(v.is_inline());
+    EXPECT_EQ(g_heap_allocs, 1);
+    EXPECT_EQ(v.capacity(), 16);
+    for (int i = 0; i < 9; ++i) EXPECT_EQ(v[i], i);
+}
+
+TEST(SmallVectorTest, InsertErase) {
+    small_vector<std::string, 4> v = {"a", "b", "c"};
+    v.insert(v.cbegin() + 1, "x");
+    EXPECT_TRUE(v.is_inline());
+    v.insert(v.cbegin(), 2, "y");
+    EXPECT_FALSE(v.is_inline());
+    v.erase(v.cbegin(), v.cbegin() + 3);
+    ASSERT_EQ(v.size(), 3);
+    EXPECT_EQ(v[0], "x");
+    EXPECT_EQ(v[2], "c");
+
+    v.shrink_to_fit();
+    EXPECT_TRUE(v.is_inline());
+    EXPECT_EQ(v[1], "b");
+}
+
+TEST(SmallVectorTest, CopyAndMove) {
+    small_vector<std::string, 2> inl = {"a", "b"};
+    small_vector<std::string, 2> heap = {"a", "b", "c"};
+
+    small_vector<std::string, 2> c1(inl);
+    small_vector<std::string, 2> c2(heap);
+    EXPECT_EQ(c1, inl);
+    EXPECT_EQ(c2, heap);
+
+    small_vector<std::string, 2> m1(std::move(inl));
+    EXPECT_TRUE(m1.is_inline());
+    EXPECT_EQ(m1.size(), 2);
+    EXPECT_TRUE(inl.empty());
+
+    const std::string* data = &heap[0];
+    small_vector<std::string, 2> m2(std::move(heap));
+    EXPECT_EQ(&m2[0], data);  // 堆缓冲区被直接接管
+    EXPECT_TRUE(heap.empty());
+    EXPECT_TRUE(heap.is_inline());
+    heap.push_back("reuse");
+    EXPECT_EQ(heap[0], "reuse");
+
+    m1 = std::move(m2);
+    EXPECT_EQ(m1.size(), 3);
+    EXPECT_EQ(m1[2], "c");
+    m2 = c1;
+    EXPECT_EQ(m2.size(), 2);
+    EXPECT_TRUE(m2.is_inline());
+}
+
+// 内联/内联、内联/堆、堆/堆两两交换，然后先销毁其中一方，另一方的元素和缓冲区都要仍然有效
+TEST(SmallVectorTest, SwapInlineAndHeap) {
+    using sv = small_vector<std::string, 3>;
+    const std::vector<std::vector<std::string>> contents = {
+        {"a"}, {"b", "c", "d"}, {"e", "f", "g", "h"}, {"i", "j", "k", "l", "m", "n"}};
+    for (const auto& x : contents) {
+        for (const auto& y : contents) {
+            sv a;
+            for (const auto& s : x) a.push_back(s);
+            {
+                sv b;
+                for (const auto& s : y) b.push_back(s);
+                bool heap_swap = !a.is_inline() && !b.is_inline();
+                const std::string* b_data = &b[0];
+                a.swap(b);
+                if (heap_swap) {
+                    EXPECT_EQ(&a[0], b_data);  // 两边都在堆上时只交换指针
+                }
+                EXPECT_EQ(a.is_inline(), y.size() <= 3);
+                EXPECT_EQ(b.is_inline(), x.size() <= 3);
+                ASSERT_EQ(b.size(), x.size());
+                for (std::size_t i = 0; i < x.size(); ++i) EXPECT_EQ(b[i], x[i]);
+                swap(b, a);  // 换回来再换过去，走友元 swap
+                swap(a, b);
+                b.push_back("tail");
+            }
+            ASSERT_EQ(a.size(), y.size());
+            for (std::size_t i = 0; i < y.size(); ++i) EXPECT_EQ(a[i], y[i]);
+            a.push_back("more");
+            EXPECT_EQ(a[a.size() - 1], "more");
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,420 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "../include/string_lt.h"
+
+using namespace leistd;
+
+static int g_allocs = 0;
+
+template <typename T>
+struct CountingAlloc {
+    using value_type = T;
+    CountingAlloc() = default;
+    template <typename U>
+    CountingAlloc(const CountingAlloc<U>&) {}
+    T* allocate(size_t n) {
+        ++g_allocs;
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T* p, size_t n) { std::allocator<T>().deallocate(p, n); }
+};
+
+using counted_string = basic_string<char, char_traits<char>, CountingAlloc<char>>;
+
+TEST(StringTest, ShortStringNoAllocation) {
+    static_assert(sizeof(string) == 4 * sizeof(void*));
+    g_allocs = 0;
+    {
+        counted_string empty;
+        EXPECT_EQ(empty.size(), 0);
+        EXPECT_EQ(empty.capacity(), 15);
+        EXPECT_STREQ(empty.c_str(), "");
+
+        counted_string s("fifteen chars!!");
+        counted_string copy(s);
+        counted_string moved(std::move(copy));
+        EXPECT_STREQ(moved.c_str(), "fifteen chars!!");
+        EXPECT_TRUE(copy.empty());
+
+        empty = std::move(moved);
+        EXPECT_STREQ(empty.c_str(), "fifteen chars!!");
+        s += "";
+        s.push_back('x');  // 16 个字符，溢出到堆
+        EXPECT_EQ(g_allocs, 1);
+    }
+    EXPECT_EQ(g_allocs, 1);
+}
+
+TEST(StringTest, LongStringMoveStealsBuffer) {
+    string s("a string that is definitely longer than fifteen");
+    const char* p = s.c_str();
+    string m(std::move(s));
+    EXPECT_EQ(m.c_str(), p);
+    EXPECT_TRUE(s.empty());
+    EXPECT_STREQ(s.c_str(), "");
+
+    string t("short");
+    t = std::move(m);
+    EXPECT_EQ(t.c_str(), p);
+    m = t;
+    EXPECT_STREQ(m.c_str(), p);
+    m = string("tiny");
+    EXPECT_STREQ(m.c_str(), "tiny");
+}
+
+TEST(StringTest, GrowFromLocalBuffer) {
+    string s;
+    std::string expect;
+    for (int i = 0; i < 100; ++i) {
+        s.push_back('a' + i % 26);
+        expect.push_back('a' + i % 26);
+    }
+    EXPECT_EQ(s.size(), 100);
+    EXPECT_STREQ(s.c_str(), expect.c_str());
+    EXPECT_EQ(s.substr(90).size(), 10);
+}
+
+TEST(StringTest, FindMatchesStdString) {
+    std::mt19937 rng(7);
+    std::string hay;
+    for (int i = 0; i < 3000; ++i) hay.push_back("abcab"[rng() % 5]);
+    string s(hay.c_str());
+
+    for (size_t m = 0; m <= 130; ++m) {
+        for (int trial = 0; trial < 4; ++trial) {
+            std::string needle = trial == 0 && m <= hay.size() ? hay.substr(hay.size() - m) : std::string();
+            if (trial) for (size_t k = 0; k < m; ++k) needle.push_back("abcab"[rng() % 5]);
+            size_t pos = rng() % 200;
+            EXPECT_EQ(s.find(needle.c_str(), pos), hay.find(needle, pos)) << "m=" << m << " pos=" << pos;
+            EXPECT_EQ(s.find(string(needle.c_str())), hay.find(needle)) << "m=" << m;
+        }
+    }
+    EXPECT_EQ(s.find('c', 10), hay.find('c', 10));
+    EXPECT_EQ(s.find("", s.size()), s.size());
+    EXPECT_EQ(s.find("", s.size() + 1), string::npos);
+    EXPECT_EQ(string().find(""), 0);
+
+    basic_string<char16_t> w(u"hello world");
+    EXPECT_EQ(w.find(u"world"), 6);
+    EXPECT_EQ(w.find(u"worlds"), basic_string<char16_t>::npos);
+}
+
+TEST(StringTest, FindOfFamilyMatchesStdString) {
+    std::mt19937 rng(11);
+    std::string hay;
+    for (int i = 0; i < 500; ++i) hay.push_back(static_cast<char>(rng() % 256));
+    hay += std::string(100, 'a');  // 长段重复字符，覆盖 not_of
+    string s(hay.c_str());
+    hay = hay.c_str();  // 与 leistd::string 一样在第一个 '\0' 处截断
+
+    const std::string sets[] = {"", "a", ",;", "\t \r\n", "abcdefghijklmnopqrstuvwxyz0123456789",
+                                std::string("\x80\xff\x7f\x01", 4)};
+    for (const std::string& set : sets) {
+        string chars(set.c_str());
+        for (size_t pos : {size_t(0), size_t(1), size_t(17), size_t(300), hay.size() - 1, hay.size(), string::npos}) {
+            EXPECT_EQ(s.find_first_of(chars, pos), hay.find_first_of(set, pos)) << set << " " << pos;
+            EXPECT_EQ(s.find_first_not_of(chars, pos), hay.find_first_not_of(set, pos)) << set << " " << pos;
+            EXPECT_EQ(s.find_last_of(chars, pos), hay.find_last_of(set, pos)) << set << " " << pos;
+            EXPECT_EQ(s.find_last_not_of(chars, pos), hay.find_last_not_of(set, pos)) << set << " " << pos;
+        }
+    }
+
+    // 各内核结果一致
+    char_set set("\t,;\x80", 4);
+    for (size_t n = 0; n < 100; ++n) {
+        size_t first = char_set::find_first_scalar(set, hay.data(), n, false);
+        size_t last = char_set::find_last_scalar(set, hay.data(), n, true);
+#ifdef LEISTD_X86_SIMD
+        EXPECT_EQ(char_set::find_first_ssse3(set, hay.data(), n, false), first);
+        EXPECT_EQ(char_set::find_last_ssse3(set, hay.data(), n, true), last);
+        if (__builtin_cpu_supports("avx2")) {
+            EXPECT_EQ(char_set::find_first_avx2(set, hay.data(), n, false), first);
+            EXPECT_EQ(char_set::find_last_avx2(set, hay.data(), n, true), last);
+        }
+#endif
+        EXPECT_EQ(set.find_first(hay.data(), n, false), first);
+    }
+
+    basic_string<char32_t> w(U"key=value;");
+    EXPECT_EQ(w.find_first_of(basic_string<char32_t>(U";=")), 3);
+    EXPECT_EQ(w.find_last_not_of(basic_string<char32_t>(U";")), 8);
+}
+
+template <typename CharT>
+void check_char_traits() {
+    using T = char_traits<CharT>;
+    using S = std::char_traits<CharT>;
+    std::mt19937 rng(5);
+    std::vector<CharT> buf(200);
+    for (auto& c : buf) c = static_cast<CharT>(1 + rng() % 3);
+    for (size_t off = 0; off < 20; ++off) {
+        for (size_t len : {0, 1, 7, 8, 15, 16, 17, 33, 100}) {
+            std::vector<CharT> a(buf.begin() + off, buf.begin() + off + len);
+            a.push_back(CharT());
+            EXPECT_EQ(T::length(a.data()), len);
+
+            std::vector<CharT> b(a);
+            if (len) b[rng() % len] = static_cast<CharT>(~CharT());
+            int r = T::compare(a.data(), b.data(), len);
+            int expect = S::compare(a.data(), b.data(), len);
+            EXPECT_EQ(r < 0, expect < 0);
+            EXPECT_EQ(r > 0, expect > 0);
+
+            const CharT* f = T::find(a.data(), len, CharT(3));
+            EXPECT_EQ(f, S::find(a.data(), len, CharT(3)));
+
+            T::assign(b.data(), len, CharT(9));
+            EXPECT_EQ(std::count(b.begin(), b.begin() + len, CharT(9)), static_cast<long>(len));
+        }
+    }
+}
+
+TEST(StringTest, CharTraits) {
+    check_char_traits<char>();
+    check_char_traits<char8_t>();
+    check_char_traits<char16_t>();
+    check_char_traits<char32_t>();
+    check_char_traits<wchar_t>();
+}
+
+TEST(StringTest, FillOperations) {
+    basic_string<char16_t> w(u"ab");
+    w.resize(20, u'x');
+    w.insert(1, 3, u'y');
+    EXPECT_EQ(w.size(), 23);
+    EXPECT_EQ(w[0], u'a');
+    EXPECT_EQ(w[3], u'y');
+    EXPECT_EQ(w[4], u'b');
+    EXPECT_EQ(w[22], u'x');
+    EXPECT_EQ(w.find(u"bxx"), 4);
+
+    string s("abc");
+    s.resize(5);
+    EXPECT_EQ(s.size(), 5);
+    EXPECT_EQ(s[4], '\0');
+}
+
+TEST(StringTest, StringViewMatchesStdStringView) {
+    std::mt19937 rng(13);
+    std::string hay;
+    for (int i = 0; i < 400; ++i) hay.push_back("abcab,; "[rng() % 8]);
+    std::string_view ref(hay);
+    string_view sv(hay.data(), hay.size());
+
+    const char* needles[] = {"", "a", "ab", "cab", "b,;", "abcabc", "zz"};
+    for (const char* p : needles) {
+        for (size_t pos : {size_t(0), size_t(3), size_t(200), hay.size(), string_view::npos}) {
+            EXPECT_EQ(sv.find(p, pos), ref.find(p, pos)) << p << " " << pos;
+            EXPECT_EQ(sv.rfind(p, pos), ref.rfind(p, pos)) << p << " " << pos;
+            EXPECT_EQ(sv.find_first_of(p, pos), ref.find_first_of(p, pos)) << p << " " << pos;
+            EXPECT_EQ(sv.find_last_not_of(p, pos), ref.find_last_not_of(p, pos)) << p << " " << pos;
+        }
+    }
+
+    EXPECT_EQ(sv.substr(5, 10).compare(string_view(hay.data() + 5, 10)), 0);
+    EXPECT_LT(string_view("abc").compare("abd"), 0);
+    EXPECT_GT(string_view("abcd").compare("abc"), 0);
+    EXPECT_TRUE(string_view("prefix.txt").starts_with("prefix"));
+    EXPECT_TRUE(string_view("prefix.txt").ends_with(".txt"));
+    EXPECT_THROW(sv.substr(hay.size() + 1), std::out_of_range);
+
+    basic_string_view<char16_t> w(u"hello world");
+    EXPECT_EQ(w.rfind(u'o'), 7);
+    EXPECT_EQ(w.find_first_not_of(u"hel"), 4);
+}
+
+TEST(StringTest, ViewAcceptingApis) {
+    g_allocs = 0;
+    counted_string s("the quick brown fox jumps");  // 长串，分配一次
+    EXPECT_EQ(g_allocs, 1);
+
+    string_view word = s.substr_view(4, 5);
+    EXPECT_EQ(word, string_view("quick"));
+    EXPECT_EQ(s.find(string_view("brown")), 10);
+    EXPECT_EQ(s.find_first_of(string_view("xyz")), 18);
+    EXPECT_EQ(s.compare(0, 3, string_view("the")), 0);
+    EXPECT_LT(s.compare(string_view("the slow")), 0);
+    EXPECT_EQ(g_allocs, 1);  // 以上都不分配
+
+    // 嵌入的 '\0' 也会被追加
+    string t("ab");
+    t += string_view("c\0d", 3);
+    EXPECT_EQ(t.size(), 5);
+    EXPECT_EQ(t.view(), string_view("abc\0d", 5));
+
+    // 视图指向自身
+    string u("0123456789");
+    u.append(u.substr_view(2, 3));
+    EXPECT_STREQ(u.c_str(), "0123456789234");
+    u.append(u.view());  // 需要扩容
+    EXPECT_STREQ(u.c_str(), "01234567892340123456789234");
+    u.insert(1, u.substr_view(0, 4));
+    EXPECT_EQ(u.view().substr(0, 8), string_view("00123123"));
+
+    string v(string_view("from view"));
+    v.insert(4, string_view(" a"));
+    EXPECT_STREQ(v.c_str(), "from a view");
+}
+
+TEST(StringTest, SizedAppendAndConcat) {
+    string s("ab");
+    s.append("c\0d", 3).append(2, 'x');
+    EXPECT_EQ(s.view(), string_view("abc\0dxx", 7));
+
+    string t("12");
+    t += s;  // 按长度追加，不在 '\0' 处截断
+    EXPECT_EQ(t.size(), 9);
+    t += '!';
+    EXPECT_EQ(t.back(), '!');
+
+    std::vector<char> v{'v', 'e', 'c'};
+    std::list<char> l{'l', 's', 't'};
+    std::istringstream in("in");
+    string r;
+    r.append(v.begin(), v.end()).append(l.begin(), l.end());
+    r.append(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    r.append(r.begin(), r.begin() + 3);  // 区间来自自身
+    EXPECT_STREQ(r.c_str(), "veclstinvec");
+
+    string ins("0123456789");
+    ins.insert(2, "abc", 2);  // 只取前 2 个字符
+    EXPECT_STREQ(ins.c_str(), "01ab23456789");
+}
+
+TEST(StringTest, RvalueConcatReusesBuffer) {
+    counted_string a("a reasonably long left operand");
+    counted_string b(" and a right one");
+    g_allocs = 0;
+    counted_string c = a + b;  // 按总长度分配一次
+    EXPECT_EQ(g_allocs, 1);
+    EXPECT_EQ(c.capacity(), a.size() + b.size());
+    EXPECT_STREQ(c.c_str(), "a reasonably long left operand and a right one");
+
+    g_allocs = 0;
+    counted_string big;
+    big.reserve(256);
+    EXPECT_EQ(g_allocs, 1);
+    counted_string chain = std::move(big) + a + "," + b + string_view("!");
+    EXPECT_EQ(g_allocs, 1);  // 链上每一步都复用左侧缓冲区
+    EXPECT_STREQ(chain.c_str(), "a reasonably long left operand, and a right one!");
+}
+
+TEST(StringTest, InsertMatchesStdString) {
+    std::mt19937 rng(17);
+    string s;
+    std::string ref;
+    for (int step = 0; step < 400; ++step) {
+        size_t pos = rng() % (ref.size() + 1);
+        std::string piece(rng() % 40, static_cast<char>('a' + step % 26));
+        switch (rng() % 6) {
+            case 0:
+                s.insert(pos, piece[0]);
+                ref.insert(ref.begin() + pos, piece[0]);
+                break;
+            case 1:
+                s.insert(pos, piece.size(), 'z');
+                ref.insert(pos, piece.size(), 'z');
+                break;
+            case 2:
+                s.insert(pos, piece.c_str());
+                ref.insert(pos, piece);
+                break;
+            case 3: {  // 插入自身的一段，可能跨过插入点
+                size_t first = rng() % (ref.size() + 1);
+                size_t len = rng() % (ref.size() - first + 1);
+                s.insert(pos, s.substr_view(first, len));
+                ref.insert(pos, ref.substr(first, len));
+                break;
+            }
+            case 4:
+                s.insert(s.begin() + pos, piece.begin(), piece.end());
+                ref.insert(ref.begin() + pos, piece.begin(), piece.end());
+                break;
+            default:
+                s.insert(pos, s);
+                ref.insert(pos, std::string(ref));
+                break;
+        }
+        if (ref.size() > 5000) {
+            s.erase(0, 4000);
+            ref.erase(0, 4000);
+        }
+        ASSERT_EQ(s.view(), string_view(ref.data(), ref.size())) << step;
+        ASSERT_EQ(s.c_str()[s.size()], '\0');
+    }
+
+    std::istringstream in("xyz");
+    string t("ab");
+    t.insert(t.begin() + 1, std::istream_iterator<char>(in), std::istream_iterator<char>());
+    EXPECT_STREQ(t.c_str(), "axyzb");
+}
+
+// 带编号、全部传播的分配器：记录每块缓冲区由哪个实例分配，释放时核对是不是同一个实例
+static std::map<void*, int> g_owner;
+static int g_foreign_frees = 0;
+
+template <typename T>
+struct TrackingAlloc {
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    int id = 0;
+    explicit TrackingAlloc(int i) : id(i) {}
+    template <typename U>
+    TrackingAlloc(const TrackingAlloc<U>& other) : id(other.id) {}
+    T* allocate(size_t n) {
+        T* p = std::allocator<T>().allocate(n);
+        g_owner[p] = id;
+        return p;
+    }
+    void deallocate(T* p, size_t n) {
+        if (g_owner[p] != id) ++g_foreign_frees;
+        g_owner.erase(p);
+        std::allocator<T>().deallocate(p, n);
+    }
+    bool operator==(const TrackingAlloc& other) const { return id == other.id; }
+};
+
+using tracked_string = basic_string<char, char_traits<char>, TrackingAlloc<char>>;
+
+// 短串 / 长串两两组合交换：内容、分配器都跟着交换，每块缓冲区仍由分配它的实例释放
+TEST(StringTest, SwapWithPropagatingAllocator) {
+    const char* texts[] = {"short", "a heap allocated string that exceeds the local buffer"};
+    g_foreign_frees = 0;
+    for (const char* x : texts) {
+        for (const char* y : texts) {
+            {
+                tracked_string a(TrackingAlloc<char>(1));
+                tracked_string b(TrackingAlloc<char>(2));
+                a.append(x, std::strlen(x));
+                b.append(y, std::strlen(y));
+                a.swap(b);
+                EXPECT_STREQ(a.c_str(), y);
+                EXPECT_STREQ(b.c_str(), x);
+                EXPECT_EQ(a.get_allocator().id, 2);
+                EXPECT_EQ(b.get_allocator().id, 1);
+                swap(a, b);
+                EXPECT_STREQ(a.c_str(), x);
+                EXPECT_EQ(a.get_allocator().id, 1);
+                a.append("!", 1);  // 交换回来后还能继续增长
+                b.append("?", 1);
+            }
+            EXPECT_EQ(g_foreign_frees, 0);
+        }
+    }
+    EXPECT_TRUE(g_owner.empty());
+}
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
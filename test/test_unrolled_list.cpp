@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "../include/unrolled_list_lt.h"
+
+using namespace leistd;
+
+// 小块，便于触发拆块/并块
+template <typename T>
+using small_chunk_list = unrolled_list<T, 4>;
+
+template <typename L>
+static std::vector<typename L::value_type> to_vec(const L& l) {
+    return std::vector<typename L::value_type>(l.begin(), l.end());
+}
+
+TEST(UnrolledListTest, PushPopBothEnds) {
+    small_chunk_list<int> l;
+    for (int i = 0; i < 10; ++i) l.push_back(i);
+    for (int i = 1; i <= 10; ++i) l.push_front(-i);
+    EXPECT_EQ(l.size(), 20u);
+    EXPECT_EQ(l.front(), -10);
+    EXPECT_EQ(l.back(), 9);
+    EXPECT_EQ(l.chunk_count(), 6u);  // 两端各自按整块增长
+
+    std::vector<int> expect;
+    for (int i = -10; i < 10; ++i) expect.push_back(i);
+    EXPECT_EQ(to_vec(l), expect);
+    EXPECT_EQ(std::vector<int>(l.rbegin(), l.rend()), std::vector<int>(expect.rbegin(), expect.rend()));
+
+    for (int i = 0; i < 5; ++i) {
+        l.pop_front();
+        l.pop_back();
+    }
+    EXPECT_EQ(l.size(), 10u);
+    EXPECT_EQ(l.front(), -5);
+    EXPECT_EQ(l.back(), 4);
+    while (!l.empty()) l.pop_back();
+    EXPECT_EQ(l.chunk_count(), 0u);
+    EXPECT_EQ(l.begin(), l.end());
+}
+
+TEST(UnrolledListTest, IteratorIsBidirectional) {
+    unrolled_list<int, 3> l = {1, 2, 3, 4, 5, 6, 7};
+    auto it = l.end();
+    --it;
+    EXPECT_EQ(*it, 7);
+    std::advance(it, -6);
+    EXPECT_EQ(it, l.begin());
+    unrolled_list<int, 3>::const_iterator cit = it;
+    EXPECT_EQ(*++cit, 2);
+    EXPECT_EQ(std::distance(l.cbegin(), l.cend()), 7);
+}
+
+TEST(UnrolledListTest, InsertAndEraseMatchStdList) {
+    std::mt19937 rng(42);
+    small_chunk_list<int> l;
+    std::list<int> ref;
+    for (int step = 0; step < 4000; ++step) {
+        size_t n = ref.size();
+        size_t pos = n ? rng() % (n + 1) : 0;
+        auto it = std::next(l.begin(), pos);
+        auto rit = std::next(ref.begin(), pos);
+        int op = rng() % 6;
+        if (op < 3 || n == 0) {
+            auto r = l.insert(it, step);
+            EXPECT_EQ(*r, step);
+            ref.insert(rit, step);
+        } else if (pos < n) {
+            auto r = l.erase(it);
+            auto rr = ref.erase(rit);
+            if (rr == ref.end()) {
+                EXPECT_EQ(r, l.end());
+            } else {
+                EXPECT_EQ(*r, *rr);
+            }
+        }
+        ASSERT_EQ(l.size(), ref.size());
+    }
+    EXPECT_EQ(to_vec(l), std::vector<int>(ref.begin(), ref.end()));
+    // 删除后并块，块数不会远超元素数 / ChunkSize
+    EXPECT_LE(l.chunk_count(), l.size() / 2 + 2);
+}
+
+TEST(UnrolledListTest, RangeInsertAndErase) {
+    small_chunk_list<int> l = {1, 2, 3, 4, 5, 6};
+    auto it = l.insert(std::next(l.begin(), 3), {10, 11, 12, 13, 14});
+    EXPECT_EQ(*it, 10);
+    EXPECT_EQ(to_vec(l), (std::vector<int>{1, 2, 3, 10, 11, 12, 13, 14, 4, 5, 6}));
+
+    it = l.insert(l.end(), 2, 7);
+    EXPECT_EQ(*it, 7);
+    it = l.erase(std::next(l.begin(), 2), std::next(l.begin(), 9));
+    EXPECT_EQ(*it, 5);
+    EXPECT_EQ(to_vec(l), (std::vector<int>{1, 2, 5, 6, 7, 7}));
+    EXPECT_EQ(l.erase(l.begin(), l.end()), l.end());
+    EXPECT_TRUE(l.empty());
+}
+
+TEST(UnrolledListTest, SpliceWholeList) {
+    small_chunk_list<int> a = {1, 2, 3, 4, 5, 6};
+    small_chunk_list<int> b = {7, 8, 9, 10, 11};
+    size_t chunks = a.chunk_count() + b.chunk_count();
+    a.splice(std::next(a.begin(), 2), b);
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(a.size(), 11u);
+    EXPECT_EQ(to_vec(a), (std::vector<int>{1, 2, 7, 8, 9, 10, 11, 3, 4, 5, 6}));
+    EXPECT_LE(a.chunk_count(), chunks + 1);  // 只在插入点拆了一块
+
+    b.push_back(100);  // 被搬空的链表仍可使用
+    a.splice(a.end(), b);
+    EXPECT_EQ(a.back(), 100);
+}
+
+TEST(UnrolledListTest, SpliceRangeMatchesStdList) {
+    std::mt19937 rng(7);
+    for (int round = 0; round < 300; ++round) {
+        small_chunk_list<int> a, b;
+        std::list<int> ra, rb;
+        int na = rng() % 20, nb = rng() % 20 + 1;
+        for (int i = 0; i < na; ++i) a.push_back(i), ra.push_back(i);
+        for (int i = 0; i < nb; ++i) b.push_back(100 + i), rb.push_back(100 + i);
+
+        size_t f = rng() % (nb + 1), len = rng() % (nb - f + 1), p = rng() % (na + 1);
+        a.splice(std::next(a.begin(), p), b, std::next(b.begin(), f), std::next(b.begin(), f + len));
+        ra.splice(std::next(ra.begin(), p), rb, std::next(rb.begin(), f), std::next(rb.begin(), f + len));
+        ASSERT_EQ(to_vec(a), std::vector<int>(ra.begin(), ra.end()));
+        ASSERT_EQ(to_vec(b), std::vector<int>(rb.begin(), rb.end()));
+        ASSERT_EQ(a.size(), ra.size());
+        ASSERT_EQ(b.size(), rb.size());
+    }
+}
+
+TEST(UnrolledListTest, SpliceWithinSameList) {
+    std::mt19937 rng(9);
+    for (int round = 0; round < 300; ++round) {
+        small_chunk_list<int> l;
+        std::list<int> ref;
+        int n = rng() % 20 + 1;
+        for (int i = 0; i < n; ++i) l.push_back(i), ref.push_back(i);
+
+        size_t f = rng() % n, last = f + rng() % (n - f + 1);
+        size_t p = rng() % (n + 1);
+        if (p >= f && p < last) continue;  // pos 不能落在 [first, last) 内
+        l.splice(std::next(l.begin(), p), l, std::next(l.begin(), f), std::next(l.begin(), last));
+        ref.splice(std::next(ref.begin(), p), ref, std::next(ref.begin(), f), std::next(ref.begin(), last));
+        ASSERT_EQ(to_vec(l), std::vector<int>(ref.begin(), ref.end()));
+        ASSERT_EQ(l.size(), ref.size());
+    }
+
+    small_chunk_list<int> l = {1, 2, 3, 4, 5};
+    l.splice(l.begin(), l, std::prev(l.end()));
+    EXPECT_EQ(to_vec(l), (std::vector<int>{5, 1, 2, 3, 4}));
+}
+
+TEST(UnrolledListTest, CopyMoveSwap) {
+    small_chunk_list<std::string> a;
+    for (int i = 0; i < 9; ++i) a.push_back(std::string(20, char('a' + i)));
+    small_chunk_list<std::string> b = a;
+    EXPECT_TRUE(a == b);
+
+    small_chunk_list<std::string> c = std::move(a);
+    EXPECT_TRUE(a.empty());
+    EXPECT_TRUE(c == b);
+    a.push_back("x");  // 移动后的对象仍可使用
+
+    swap(a, c);
+    EXPECT_EQ(a.size(), 9u);
+    EXPECT_EQ(c.size(), 1u);
+    EXPECT_EQ(c.front(), "x");
+    EXPECT_EQ(std::distance(a.begin(), a.end()), 9);
+
+    small_chunk_list<std::string> empty;
+    swap(c, empty);  // 与空链表交换
+    EXPECT_TRUE(c.empty());
+    EXPECT_EQ(c.begin(), c.end());
+    EXPECT_EQ(empty.front(), "x");
+
+    c = b;
+    EXPECT_TRUE(c == b);
+    c = std::move(b);
+    EXPECT_EQ(c.size(), 9u);
+    EXPECT_TRUE(b.empty());
+}
+
+TEST(UnrolledListTest, MoveOnlyElements) {
+    small_chunk_list<std::unique_ptr<int>> l;
+    for (int i = 0; i < 10; ++i) l.push_back(std::make_unique<int>(i));
+    l.emplace(std::next(l.begin(), 5), std::make_unique<int>(42));
+    l.erase(std::next(l.begin(), 2));
+    std::vector<int> got;
+    for (auto& p : l) got.push_back(*p);
+    EXPECT_EQ(got, (std::vector<int>{0, 1, 3, 4, 42, 5, 6, 7, 8, 9}));
+}
+
+TEST(UnrolledListTest, DefaultChunkPacksSmallElements) {
+    unrolled_list<int> l;
+    for (int i = 0; i < 1000; ++i) l.push_back(i);
+    EXPECT_EQ(decltype(l)::chunk_size, 64u);
+    EXPECT_EQ(l.chunk_count(), 16u);
+}
+
+int main(int argc, char** argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
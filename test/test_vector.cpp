@@ -1,4 +1,6 @@
 #include <gtest/gtest.h>
+#include <memory>
+#include <string>
 #include "../include/vector.h"
 
 using namespace leistd;
@@ -146,6 +148,133 @@ TEST(VectorTest, InsertRange) {
     EXPECT_EQ(v3.size(), 4);
 }
 
+// 拷贝计数到阈值后抛异常；移动构造不是 noexcept，扩容时只能走拷贝
+struct ThrowingCopy {
+    static inline int copies_left = 1000;
+    int v;
+    ThrowingCopy(int x) : v(x) {}
+    ThrowingCopy(const ThrowingCopy& o) : v(o.v) {
+        if (--copies_left < 0) throw std::runtime_error("copy");
+    }
+    ThrowingCopy(ThrowingCopy&& o) : v(o.v) {}
+    ThrowingCopy& operator=(const ThrowingCopy&) = default;
+    ThrowingCopy& operator=(ThrowingCopy&&) = default;
+};
+
+TEST(VectorTest, RelocateTriviallyRelocatable) {
+    static_assert(is_trivially_relocatable_v<int>);
+    static_assert(is_trivially_relocatable_v<std::unique_ptr<int>>);
+    static_assert(!is_trivially_relocatable_v<std::string>);
+
+    vector<std::unique_ptr<int>> v;
+    for (int i = 0; i < 100; ++i) v.push_back(std::make_unique<int>(i));
+    v.insert(v.cbegin() + 10, std::make_unique<int>(-1));
+    v.erase(v.cbegin(), v.cbegin() + 5);
+    EXPECT_EQ(v.size(), 96);
+    EXPECT_EQ(*v[0], 5);
+    EXPECT_EQ(*v[5], -1);
+    EXPECT_EQ(*v[6], 10);
+    EXPECT_EQ(*v[95], 99);
+}
+
+TEST(VectorTest, RelocateNonTrivial) {
+    vector<std::string> v;
+    for (int i = 0; i < 20; ++i) v.push_back(std::string(30, 'a' + i));
+    v.insert(v.cbegin() + 3, 2, std::string("xx"));
+    v.erase(v.cbegin() + 1);
+    EXPECT_EQ(v.size(), 21);
+    EXPECT_EQ(v[0], std::string(30, 'a'));
+    EXPECT_EQ(v[1], std::string(30, 'c'));
+    EXPECT_EQ(v[2], "xx");
+    EXPECT_EQ(v[3], "xx");
+    EXPECT_EQ(v[4], std::string(30, 'd'));
+}
+
+TEST(VectorTest, InsertSelfReference) {
+    vector<std::string> v;
+    v.push_back("first");
+    v.push_back(v[0]);   // 扩容时引用自身元素
+    v.insert(v.cbegin(), v[1]);
+    EXPECT_EQ(v.size(), 3);
+    EXPECT_EQ(v[0], "first");
+    EXPECT_EQ(v[2], "first");
+}
+
+TEST(VectorTest, ReserveStrongGuarantee) {
+    vector<ThrowingCopy> v;
+    for (int i = 0; i < 8; ++i) v.push_back(ThrowingCopy(i));
+    ThrowingCopy::copies_left = 3;
+    EXPECT_THROW(v.reserve(100), std::runtime_error);
+    ThrowingCopy::copies_left = 1000;
+    EXPECT_EQ(v.size(), 8);
+    EXPECT_EQ(v.capacity(), 8);
+    for (int i = 0; i < 8; ++i) EXPECT_EQ(v[i].v, i);
+}
+
+TEST(VectorTest, GrowthPolicy) {
+    vector<int, std::allocator<int>, growth_factor_1_5x> v;
+    size_t caps[] = {1, 2, 3, 4, 6, 9, 13};
+    for (size_t expect : caps) {
+        while (v.size() < v.capacity()) v.push_back(0);
+        v.push_back(0);
+        EXPECT_EQ(v.capacity(), expect);
+    }
+
+    EXPECT_EQ(malloc_size_class(24), 24u);
+    EXPECT_EQ(malloc_size_class(100), 112u);
+    EXPECT_EQ(malloc_size_class(4097), 5120u);
+    EXPECT_EQ((size_class_growth<>::grow(6, 7, sizeof(int))), 10u);  // 36 字节 → 40
+    EXPECT_EQ((page_rounded_growth<>::grow(1000, 1001, sizeof(int))), 2048u);
+    EXPECT_EQ((page_rounded_growth<>::grow(1500, 1501, sizeof(int))), 3072u);
+
+    // 所有插入路径都遵循策略
+    vector<int, std::allocator<int>, growth_factor_1_5x> w(v);
+    EXPECT_EQ(w.capacity(), 10);
+    w.insert(w.cbegin(), 1);
+    EXPECT_EQ(w.capacity(), 15);
+    w.insert(w.cbegin(), 10, 1);
+    EXPECT_EQ(w.capacity(), 22);
+}
+
+TEST(VectorTest, ShrinkToFit) {
+    vector<int> v;
+    for (int i = 0; i < 100; ++i) v.push_back(i);
+    v.erase(v.cbegin() + 10, v.cend());
+    EXPECT_EQ(v.capacity(), 128);
+    v.shrink_to_fit();
+    EXPECT_EQ(v.capacity(), 10);
+    EXPECT_EQ(v[9], 9);
+    v.clear();
+    v.shrink_to_fit();
+    EXPECT_EQ(v.capacity(), 0);
+    v.push_back(1);
+    EXPECT_EQ(v[0], 1);
+}
+
+TEST(VectorTest, ReallocateInPlace) {
+    static_assert(allocator_has_reallocate_v<malloc_allocator<int>>);
+    static_assert(!allocator_has_reallocate_v<std::allocator<int>>);
+
+    vector<int, malloc_allocator<int>> v;
+    for (int i = 0; i < 1024; ++i) v.push_back(i);
+    EXPECT_EQ(v.capacity(), 1024);
+    v.push_back(v[0]);   // 恰好扩容时引用自身元素
+    v.insert(v.cbegin() + 1, 500, -1);
+    EXPECT_EQ(v.size(), 1525);
+    EXPECT_EQ(v[0], 0);
+    EXPECT_EQ(v[500], -1);
+    EXPECT_EQ(v[501], 1);
+    EXPECT_EQ(v[1523], 1023);
+    EXPECT_EQ(v[1524], 0);
+
+    v.reserve(100000);
+    EXPECT_EQ(v.capacity(), 100000);
+    EXPECT_EQ(v[1523], 1023);
+    v.shrink_to_fit();
+    EXPECT_EQ(v.capacity(), 1525);
+    EXPECT_EQ(v[1524], 0);
+}
+
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();